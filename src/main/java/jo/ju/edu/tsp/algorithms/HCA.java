@@ -1,7 +1,8 @@
 package jo.ju.edu.tsp.algorithms;
 
-import jo.ju.edu.tsp.core.Graph;
-import jo.ju.edu.tsp.core.Vertex;
+import jo.ju.edu.tsp.core.EdgeAttribute;
+import jo.ju.edu.tsp.core.PackedGraph;
+import jo.ju.edu.tsp.core.WeightedGraph;
 import jo.ju.edu.tsp.set.SetDetails;
 import jo.ju.edu.tsp.set.SetInstance;
 import org.jetbrains.annotations.NotNull;
@@ -15,49 +16,58 @@ public class HCA extends TSP {
     private static int maxIterations;
     private final double initSoil = 10000, epsilon = 0.01, alpha = 2, PN = 0.99, beta = 10; // 10k
     private double temperature = 50, maxTemperature = 1000;
+    // the soil of the edges, indexed by the edge id; their depth follows from it (see depth).
+    private double[] soil;
 
-    public @NotNull Graph solve(@NotNull Graph graph) {
+    public @NotNull WeightedGraph solve(@NotNull WeightedGraph graph) {
+        checkWaterDropMemory(graph, "HCA");
         System.out.println( "started: " + (new Date()));
         // print the graph
        // Transformer.print(graph);
         // Maximum number of iterations is a triple the number of vertices
         maxIterations = 3 * graph.getNumberOfVertices();
+        soil = graph.getColumn(EdgeAttribute.SOIL);
 
-        // A graph of water drops solutions, each index represent a water drop.
-        Graph solutions;
+        // The solutions of the water drops, each index represent a water drop: the visited vertices in order.
+        int[][] solutions = new int[graph.getNumberOfVertices()][graph.getNumberOfVertices()];
+        int[] solutionSizes = new int[graph.getNumberOfVertices()];
         // Number of water drops equals to number of vertices
         List<WaterDrop> waterDrops;
         WaterDrop waterDrop;
         double gDepth, fSoil, probability, sum, theChosenOneValue;
-        Vertex theChosenOne;
-        HashMap<Integer, List<Vertex>> bestGlobalSolution = null;
+        int theChosenOne, current, vertex;
+        int[] bestGlobalSolution = null;
+        int bestGlobalWaterDropId = -1;
         int cycle = 0;
         temperature = 50;
         //maxTemperature = maxTemperature * graph.getNumberOfVertices();
         while (temperature < maxTemperature) {
-            // distribute the initial amount of soil and depth on the vertices.
-            initParams(graph, bestGlobalSolution);
+            // distribute the initial amount of soil on the vertices.
+            initParams(graph, bestGlobalWaterDropId, bestGlobalSolution);
             waterDrops = getWDs(graph);
-            solutions = new Graph(graph.getNumberOfVertices(), "Solutions");
+            Arrays.fill(solutionSizes, 0);
             for(int iteration = 0; iteration < maxIterations; iteration++) {
                 for(int i = 0; i < waterDrops.size(); i++) {
                     waterDrop = waterDrops.get(i);
-                    theChosenOne = null;
+                    current = waterDrop.getCurrentVertexId();
+                    theChosenOne = -1;
                     theChosenOneValue = 0;
                     // summation for each water drop
                     sum = 0;
-                    for(Vertex vc : graph.adjacentOf(waterDrop.getCurrentVertexId())) {
-                        if(!waterDrop.isVisited(vc.getId()))
-                            sum += (Math.pow(fSoil(vc), 2) * gDepth(vc));
+                    for(int k = 0; k < graph.getDegree(current); k++) {
+                        vertex = graph.getNeighbour(current, k);
+                        if(!waterDrop.isVisited(vertex))
+                            sum += (Math.pow(fSoil(graph, current, vertex), 2) * gDepth(graph, current, vertex));
                     }
 
                     if(Double.isNaN(sum))
                         sum = 1;
 
-                    for(Vertex vertex : graph.adjacentOf(waterDrop.getCurrentVertexId())) {
-                        if(!waterDrop.isVisited(vertex.getId())) {
-                            gDepth = gDepth(vertex);
-                            fSoil = fSoil(vertex);
+                    for(int k = 0; k < graph.getDegree(current); k++) {
+                        vertex = graph.getNeighbour(current, k);
+                        if(!waterDrop.isVisited(vertex)) {
+                            gDepth = gDepth(graph, current, vertex);
+                            fSoil = fSoil(graph, current, vertex);
                             probability = (Math.pow(fSoil, 2) * gDepth) / sum;
                             if(theChosenOneValue < probability) {
                                 theChosenOneValue = probability;
@@ -66,21 +76,23 @@ public class HCA extends TSP {
                         }
                     }
 
-                    if(theChosenOne == null) break;
+                    // all candidates are visited (see CandidateGraph).
+                    if(theChosenOne == -1) theChosenOne = graph.getFallbackNeighbour(current, waterDrop::isVisited);
+                    if(theChosenOne == -1) break;
                     // Mark the current vertex as visited
-                    waterDrop.markAsVisited(theChosenOne.getId());
+                    waterDrop.markAsVisited(theChosenOne);
                     // 3.3.1. Velocity Update
-                    updateVelocity(waterDrop, theChosenOne);
+                    updateVelocity(waterDrop, graph, theChosenOne);
                     // 3.3.2. Soil Update
-                    updateSoil(waterDrop, theChosenOne, waterDrops, graph);
+                    updateSoil(waterDrop, graph, theChosenOne, waterDrops);
                     //3.3.3. Soil Transportation Update
-                    updateCarrySoil(waterDrop, theChosenOne);
+                    updateCarrySoil(waterDrop, graph, theChosenOne);
                     // update the pointer
-                    waterDrop.setCurrentVertexId(theChosenOne.getId());
+                    waterDrop.setCurrentVertexId(theChosenOne);
                     // save the solution
-                    solutions.put(i, theChosenOne);
+                    solutions[i][solutionSizes[i]++] = theChosenOne;
 
-                    //System.out.println("depth: " + theChosenOne.getCharacteristic("depth") + ", water drop: " + (waterDrop.getWaterDropId() + 1) + ", vertex id : " + (theChosenOne.getId() + 1) + ", soil: " + theChosenOne.getCharacteristic("soil") + ", Velocity: " + waterDrop.getVelocity() + " carry soil: " + waterDrop.getCarriedSoil());
+                    //System.out.println("depth: " + depth(graph, current, theChosenOne) + ", water drop: " + (waterDrop.getWaterDropId() + 1) + ", vertex id : " + (theChosenOne + 1) + ", soil: " + soil[graph.getEdgeId(current, theChosenOne)] + ", Velocity: " + waterDrop.getVelocity() + " carry soil: " + waterDrop.getCarriedSoil());
                 }
                 // 3.3.4. Temperature Update
                 updateTemperature(waterDrops);
@@ -93,11 +105,11 @@ public class HCA extends TSP {
             // 3.4. Evaporation Stage
             List<WaterDrop> evaporatedWaterDrops = evaporation(waterDrops);
             // 3.5. Condensation Stage
-            WaterDrop theCollector = condensation(evaporatedWaterDrops, solutions);
+            WaterDrop theCollector = condensation(evaporatedWaterDrops, solutions, solutionSizes);
             // 3.6. Precipitation Stage
             if(theCollector != null) {
-                bestGlobalSolution = new HashMap<Integer, List<Vertex>>();
-                bestGlobalSolution.put(theCollector.getWaterDropId(), solutions.adjacentOf(theCollector.getWaterDropId()));
+                bestGlobalWaterDropId = theCollector.getWaterDropId();
+                bestGlobalSolution = Arrays.copyOf(solutions[bestGlobalWaterDropId], solutionSizes[bestGlobalWaterDropId]);
             }
 
             cycle ++;
@@ -106,30 +118,26 @@ public class HCA extends TSP {
         }
         // Print the best global solution details
         if(bestGlobalSolution != null) {
-            double cost = 0;
-            for(int i : bestGlobalSolution.keySet()) {
-               // System.out.print("---\nHamiltonian path: ");
-                System.out.print( "Size: " + bestGlobalSolution.get(i).size() );
-                for(Vertex v : bestGlobalSolution.get(i)) {
-                    cost += v.getCost();
-                    //System.out.print("  ->  " + (v.getId()+1));
-                }
-                //System.out.print("  ->  " +  (i + 1) );
-            }
-            System.out.println("   | cost (" + cost + ") cycles: " + cycle);
+           // System.out.print("---\nHamiltonian path: ");
+            System.out.print( "Size: " + bestGlobalSolution.length );
+            // the water drop starts at the vertex with its own id and returns to it.
+            int[] tour = new int[bestGlobalSolution.length + 1];
+            tour[0] = bestGlobalWaterDropId;
+            System.arraycopy(bestGlobalSolution, 0, tour, 1, bestGlobalSolution.length);
+            System.out.println("   | cost (" + getTourLength(graph, tour) + ") cycles: " + cycle);
         }
 
         System.out.println( "ended: " + (new Date()));
-        return new Graph(0, "");
+        return new PackedGraph("", 0, true);
     }
 
-    private WaterDrop condensation(List<WaterDrop> wds, Graph solutions) {
+    private WaterDrop condensation(List<WaterDrop> wds, int[][] solutions, int[] solutionSizes) {
         double similarity;
         for(int i = 0; i < wds.size(); i++) {
             if(wds.get(i) != null) {
                 for(int j = 0; j < wds.size(); j++) {
-                    if(wds.get(j) != null && isCollideWaterDrops(solutions.adjacentOf(i), solutions.adjacentOf(j))) {
-                        similarity = similarity(solutions.adjacentOf(i), solutions.adjacentOf(j));
+                    if(wds.get(j) != null && isCollideWaterDrops(solutionSizes[i], solutionSizes[j])) {
+                        similarity = similarity(solutions[i], solutions[j], solutionSizes[i], solutionSizes[j]);
                         if(similarity >= 50) {// Merge
                             // When two water drops collide and merge, one water drop (i.e., the collector) will
                             // become more powerful by eliminating the other one in the process also acquiring the
@@ -166,16 +174,16 @@ public class HCA extends TSP {
         return collector;
     }
 
-    private boolean isCollideWaterDrops(List<Vertex> solution1, List<Vertex> solution2) {
-        return solution1.size() == solution2.size();
+    private boolean isCollideWaterDrops(int size1, int size2) {
+        return size1 == size2;
     }
 
     /* NOT USED FOR NOW */
-    private HashMap<Integer, Double> calcOccurrences(List<Vertex> solution1, List<Vertex> solution2) {
-        HashMap<Integer, Double> occurrences = new HashMap<Integer, Double>(solution1.size());
-        for(int i = 0; i < solution1.size(); i++) {
-            occurrences.put(solution1.get(i).getId(), occurrences.get(solution1.get(i).getId()) + 1);
-            occurrences.put(solution2.get(i).getId(), occurrences.get(solution2.get(i).getId()) + 1);
+    private HashMap<Integer, Double> calcOccurrences(int[] solution1, int[] solution2, int size) {
+        HashMap<Integer, Double> occurrences = new HashMap<Integer, Double>(size);
+        for(int i = 0; i < size; i++) {
+            occurrences.put(solution1[i], occurrences.get(solution1[i]) + 1);
+            occurrences.put(solution2[i], occurrences.get(solution2[i]) + 1);
         }
         return occurrences;
     }
@@ -212,30 +220,28 @@ public class HCA extends TSP {
         return new Pair<Double, Double>(min, max);
     }
 
-    private void updateCarrySoil(WaterDrop wd, Vertex v) {
-        double timeWD = v.getCost() / wd.getVelocity();
+    private void updateCarrySoil(WaterDrop wd, WeightedGraph graph, int v) {
+        double timeWD = graph.getCost(wd.getCurrentVertexId(), v) / wd.getVelocity();
         double dSoil = 1 / timeWD;
         double carriedSoil = wd.getCarriedSoil() + (dSoil / wd.getSolutionQuality());
         wd.setCarriedSoil(carriedSoil);
         wd.setSolutionQuality(carriedSoil);
     }
 
-    private void updateSoil(WaterDrop wd, Vertex v, List<WaterDrop> wds, Graph graph) {
-        double timeWD = v.getCost() / wd.getVelocity();
+    private void updateSoil(WaterDrop wd, WeightedGraph graph, int v, List<WaterDrop> wds) {
+        int from = wd.getCurrentVertexId();
+        double timeWD = graph.getCost(from, v) / wd.getVelocity();
         double dSoil = 1 / timeWD;
         double avgWDs = getAverageVelocityForAllWaterDrops(wds);
         // A water drop can remove (or add) soil from (or to) a path while moving based on its velocity.
-        double soil = (PN * v.getCharacteristic("soil"));
+        double newSoil = (PN * soil[graph.getEdgeId(from, v)]);
         if(wd.getVelocity() >= avgWDs) { // Erosion
-            soil = soil - dSoil - Math.sqrt(1 / depth(v));
+            newSoil = newSoil - dSoil - Math.sqrt(1 / depth(graph, from, v));
         } else { // decomposition
-            soil = soil + dSoil + Math.sqrt(1 / depth(v));
+            newSoil = newSoil + dSoil + Math.sqrt(1 / depth(graph, from, v));
         }
 
-        v.addCharacteristic("soil", soil);
-        // because it's symmetric
-        Vertex sv = graph.getVertex(v.getId(), wd.getCurrentVertexId());
-        sv.addCharacteristic("soil", soil);
+        graph.set(soil, from, v, newSoil);
     }
 
     private double getAverageVelocityForAllWaterDrops(List<WaterDrop> wds) {
@@ -246,33 +252,35 @@ public class HCA extends TSP {
         return sum / wds.size();
     }
 
-    private void updateVelocity(WaterDrop wd, Vertex v) {
+    private void updateVelocity(WaterDrop wd, WeightedGraph graph, int v) {
+        int from = wd.getCurrentVertexId();
         double K = Math.random(); // refers to the roughness coefficient [0,1]
         // current velocity
         double vt = wd.getVelocity();
         // next one t + 1
-        double vt1 = (K * vt) + (alpha * (vt / v.getCharacteristic("soil")) + Math.sqrt(vt / wd.getCarriedSoil())) + (100 / wd.getSolutionQuality()) + Math.sqrt(vt / depth(v));
+        double vt1 = (K * vt) + (alpha * (vt / soil[graph.getEdgeId(from, v)]) + Math.sqrt(vt / wd.getCarriedSoil())) + (100 / wd.getSolutionQuality()) + Math.sqrt(vt / depth(graph, from, v));
 
         wd.setVelocity(vt1);
     }
 
-    private double fSoil(Vertex v) {
-        return 1 / (epsilon + v.getCharacteristic("soil"));
+    private double fSoil(WeightedGraph graph, int from, int to) {
+        return 1 / (epsilon + soil[graph.getEdgeId(from, to)]);
     }
 
-    private double gDepth(Vertex v) {
-        return 1 / normalize(depth(v));
+    private double gDepth(WeightedGraph graph, int from, int to) {
+        return 1 / normalize(depth(graph, from, to));
     }
 
     private double normalize(double value) {
         return value * 10000;
     }
 
-    private double depth(Vertex v){
-        return v.getCost() / v.getCharacteristic("soil");
+    // the depth of an edge: its cost over its soil.
+    private double depth(WeightedGraph graph, int from, int to){
+        return graph.getCost(from, to) / soil[graph.getEdgeId(from, to)];
     }
 
-    private List<WaterDrop> getWDs(Graph graph) {
+    private List<WaterDrop> getWDs(WeightedGraph graph) {
         List<WaterDrop> waterDrops = new ArrayList<WaterDrop>(graph.getNumberOfVertices());
         for(int i = 0; i < graph.getNumberOfVertices(); i++) {
             // Starting point is the same water drop ID.
@@ -282,32 +290,19 @@ public class HCA extends TSP {
     }
     // reinitializing all the dynamic variables, such as the amount of the soil on each edge, depth of paths,
     // the velocity of each water drop, and the amount of soil it holds.
-    private void initParams(@NotNull Graph graph, HashMap<Integer, List<Vertex>> bestGlobalSolution) {
-        List<Vertex> vertices;
-        double soil;
-        for(int i = 0; i < graph.getNumberOfVertices(); i++) {
-            vertices = graph.adjacentOf(i);
-            for(Vertex vertex : vertices) {
-                soil = initSoil;
-                if(bestGlobalSolution != null && bestGlobalSolution.get(i) != null) {
-                    if(isBelong(vertex, bestGlobalSolution.get(i))) {
-                        soil = 0.9 * initSoil;
-                    }
-                }
-                vertex.addCharacteristic("soil", soil);
-                vertex.addCharacteristic("depth", (vertex.getCost() / soil) );
+    private void initParams(@NotNull WeightedGraph graph, int bestGlobalWaterDropId, int[] bestGlobalSolution) {
+        // every edge id, also the ones of edges outside the adjacency lists.
+        Arrays.fill(soil, initSoil);
+        // the edges of the best solution leaving the start of its water drop get less soil.
+        if(bestGlobalSolution != null) {
+            int i = bestGlobalWaterDropId;
+            for(int v : bestGlobalSolution) {
+                if(v == i) continue;
+                graph.setDirected(soil, i, v, 0.9 * initSoil);
             }
         }
     }
 
-    private boolean isBelong(Vertex v, List<Vertex> vs) {
-        for(Vertex vertex : vs) {
-            if(vertex.getId() == v.getId())
-                return true;
-        }
-        return false;
-    }
-
     /*
     *  According to the evaporation rate, a specific number of water drops is selected to evaporate. The selection
     *  is done using the roulette-wheel selection method, taking into consideration the solution quality of each water
@@ -343,13 +338,13 @@ public class HCA extends TSP {
     }
 
 
-    private int similarity(List<Vertex> wd1, List<Vertex> wd2) {
-        if(wd1.size() != wd2.size() || wd1.size() == 0) return -1;
+    private int similarity(int[] wd1, int[] wd2, int size1, int size2) {
+        if(size1 != size2 || size1 == 0) return -1;
         int counter = 0;
-        for(int i = 0; i < wd1.size(); i++) {
-            if(wd1.get(i).getId() != wd2.get(i).getId()) counter++;
+        for(int i = 0; i < size1; i++) {
+            if(wd1[i] != wd2[i]) counter++;
         }
-        return (counter / wd1.size()) * 100; // output in percentage. 50%
+        return (counter / size1) * 100; // output in percentage. 50%
     }
 
     public static void main(String[] args) {
@@ -1,7 +1,8 @@
 package jo.ju.edu.tsp.algorithms;
 
-import jo.ju.edu.tsp.core.Graph;
-import jo.ju.edu.tsp.core.Vertex;
+import jo.ju.edu.tsp.core.EdgeAttribute;
+import jo.ju.edu.tsp.core.PackedGraph;
+import jo.ju.edu.tsp.core.WeightedGraph;
 import jo.ju.edu.tsp.set.SetInstance;
 import org.xml.sax.SAXException;
 
@@ -11,64 +12,78 @@ import java.util.*;
 
 public class IWD extends TSP {
     private final double EPSILON = 0.01;
+    // the soil of the edges, indexed by the edge id.
+    private double[] soil;
 
-    public Graph solve(Graph graph) {
+    public WeightedGraph solve(WeightedGraph graph) {
+        checkWaterDropMemory(graph, "IWD");
 
-        // A graph of water drops solutions, each index represent a water drop.
-        Graph solutions;
+        // The solutions of the water drops, each index represent a water drop: the visited vertices in order.
+        int[][] solutions = new int[graph.getNumberOfVertices()][graph.getNumberOfVertices()];
+        int[] solutionSizes = new int[graph.getNumberOfVertices()];
         // Number of water drops equals to number of vertices
         List<WaterDrop> waterDrops = getWDs(graph);
         WaterDrop waterDrop;
+        soil = graph.getColumn(EdgeAttribute.SOIL);
         double bestTourCost = 0;
+        int[] bestTour = null;
         initParams(graph);
 
         for (int iteration = 0; iteration < 1000; iteration++) {
-            solutions = new Graph(graph.getNumberOfVertices(), "Solutions");
+            Arrays.fill(solutionSizes, 0);
 
             for (int k = 0; k < waterDrops.size() * waterDrops.size(); k++) {
                 double cost;
-                Vertex nextNode = null;
+                int nextNode = -1;
                 waterDrop = waterDrops.get(k % waterDrops.size());
 
                 int waterDropCurrentVertexId = waterDrop.getCurrentVertexId();
-                List<Vertex> adjVertices = graph.adjacentOf(waterDropCurrentVertexId);
-                double fSoilSummation = getFSoilSummation(adjVertices, waterDrop);
+                double minSoil = getMinSoil(graph, waterDrop);
+                double fSoilSummation = getFSoilSummation(graph, waterDrop, minSoil);
                 double prob = 0;
-                for (Vertex vertex : adjVertices) {
-                    if (!waterDrop.isVisited(vertex.getId())) {
-                        double maxProb = fSoil(vertex, adjVertices, waterDrop) / fSoilSummation;
+                for (int l = 0; l < graph.getDegree(waterDropCurrentVertexId); l++) {
+                    int vertex = graph.getNeighbour(waterDropCurrentVertexId, l);
+                    if (!waterDrop.isVisited(vertex)) {
+                        double maxProb = fSoil(graph, waterDropCurrentVertexId, vertex, minSoil) / fSoilSummation;
                         if (maxProb >= prob) {
                             prob = maxProb;
                             nextNode = vertex;
                         }
                     }
                 }
-                if (nextNode == null) break;
+                // all candidates are visited (see CandidateGraph).
+                if (nextNode == -1) nextNode = graph.getFallbackNeighbour(waterDropCurrentVertexId, waterDrop::isVisited);
+                if (nextNode == -1) break;
 
-                waterDrop.markAsVisited(nextNode.getId());
+                waterDrop.markAsVisited(nextNode);
 
-                cost = nextNode.getCost() + waterDrop.getSolutionQuality();
+                cost = graph.getCost(waterDropCurrentVertexId, nextNode) + waterDrop.getSolutionQuality();
 
-                updateVelocity(waterDrop, nextNode.getCharacteristic("soil"));
+                updateVelocity(waterDrop, soil[graph.getEdgeId(waterDropCurrentVertexId, nextNode)]);
 
                 updateSoil(waterDrop, nextNode, graph);
 
-                waterDrop.setCurrentVertexId(nextNode.getId());
+                waterDrop.setCurrentVertexId(nextNode);
 
                 waterDrop.setSolutionQuality(cost);
 
-                solutions.put(k % waterDrops.size(), nextNode);
+                solutions[k % waterDrops.size()][solutionSizes[k % waterDrops.size()]++] = nextNode;
             }
             for (WaterDrop waterDrop1 :
                     waterDrops) {
-                double cost = graph.getVertex(waterDrop1.getFirstVertexId(), waterDrop1.getCurrentVertexId()).getCost();
+                double cost = graph.getCost(waterDrop1.getFirstVertexId(), waterDrop1.getCurrentVertexId());
                 waterDrop1.setSolutionQuality(waterDrop1.getSolutionQuality() + cost);
 
             }
             WaterDrop bestWaterDrop = getBestWaterDrop(waterDrops);
+            int[] vertices = Arrays.copyOf(solutions[bestWaterDrop.getWaterDropId()], solutionSizes[bestWaterDrop.getWaterDropId()]);
             if (bestTourCost == 0 || bestTourCost >= bestWaterDrop.getSolutionQuality()) {
                 bestTourCost = bestWaterDrop.getSolutionQuality();
-            }            List<Vertex> vertices = solutions.adjacentOf(bestWaterDrop.getWaterDropId());
+                // the water drop starts at its first vertex and returns to it.
+                bestTour = new int[vertices.length + 1];
+                bestTour[0] = bestWaterDrop.getFirstVertexId();
+                System.arraycopy(vertices, 0, bestTour, 1, vertices.length);
+            }
 
             if (bestTourCost != 0 && bestTourCost <= bestWaterDrop.getSolutionQuality()) {
                 waterDrops = getWDs(graph);
@@ -81,9 +96,10 @@ public class IWD extends TSP {
             waterDrops = getWDs(graph);
 
         }
-        System.out.println("cost" + bestTourCost);
+        // the length of the best tour, evaluated by the tour kernels.
+        System.out.println("cost" + (bestTour != null ? getTourLength(graph, bestTour) : bestTourCost));
 
-        return new Graph(0, "");
+        return new PackedGraph("", 0, true);
     }
 
     private WaterDrop getBestWaterDrop(List<WaterDrop> waterDrops) {
@@ -107,51 +123,57 @@ public class IWD extends TSP {
     }
 
     // update IWD soil + pathSoil
-    private void updateSoil(WaterDrop wd, Vertex v, Graph graph) {
+    private void updateSoil(WaterDrop wd, int v, WeightedGraph graph) {
+        int from = wd.getCurrentVertexId();
         // current velocity
-        double soil = wd.getCarriedSoil();
-        double time = v.getCost() / Math.max(0.0001, wd.getVelocity());
+        double carriedSoil = wd.getCarriedSoil();
+        double time = graph.getCost(from, v) / Math.max(0.0001, wd.getVelocity());
         double deltaSoil = ((1000) / (0.01 + time));
         // next one t + 1
-        double soil1 = soil + deltaSoil;
+        double soil1 = carriedSoil + deltaSoil;
         wd.setCarriedSoil(soil1);
-        v.addCharacteristic("soil", 0.1 * v.getCharacteristic("soil") - 0.9 * deltaSoil);
-        // because it's symmetric
-        Vertex sv = graph.getVertex(v.getId(), wd.getCurrentVertexId());
-        sv.addCharacteristic("soil", 0.1 * v.getCharacteristic("soil") - 0.9 * deltaSoil);
+        double pathSoil = 0.1 * soil[graph.getEdgeId(from, v)] - 0.9 * deltaSoil;
+        graph.set(soil, from, v, pathSoil);
     }
 
-    private double getFSoilSummation(List<Vertex> uniqueAdjVertices, WaterDrop waterdrop) {
+    private double getFSoilSummation(WeightedGraph graph, WaterDrop waterdrop, double minSoil) {
+        int from = waterdrop.getCurrentVertexId();
         double soil_i_K_sum = 0;
-        for (Vertex vertex : uniqueAdjVertices) {
-            if (!waterdrop.isVisited(vertex.getId())) {
-                double v = fSoil(vertex, uniqueAdjVertices, waterdrop);
+        for (int l = 0; l < graph.getDegree(from); l++) {
+            int vertex = graph.getNeighbour(from, l);
+            if (!waterdrop.isVisited(vertex)) {
+                double v = fSoil(graph, from, vertex, minSoil);
                 soil_i_K_sum += v;
             }
         }
         return soil_i_K_sum;
     }
 
-    private double fSoil(Vertex j, List<Vertex> adjVertices, WaterDrop waterDrop) {
-        return 1 / (EPSILON + gSoil(j, adjVertices, waterDrop));
+    private double fSoil(WeightedGraph graph, int from, int j, double minSoil) {
+        return 1 / (EPSILON + gSoil(graph, from, j, minSoil));
     }
 
-    private double gSoil(Vertex j, List<Vertex> adjVertices, WaterDrop waterDrop) {
-        double soil_i_j = j.getCharacteristic("soil");
-        double minSoil = soil_i_j;
-        for (Vertex vertex : adjVertices) {
-            if (!waterDrop.isVisited(vertex.getId())) {
-                if (vertex.getCharacteristic("soil") < minSoil) {
-                    minSoil = vertex.getCharacteristic("soil");
-                }
-            }
-        }
+    private double gSoil(WeightedGraph graph, int from, int j, double minSoil) {
+        double soil_i_j = soil[graph.getEdgeId(from, j)];
         if (minSoil >= 0) {
             return soil_i_j;
         } else return soil_i_j - minSoil;
     }
 
-    private List<WaterDrop> getWDs(Graph graph) {
+    // the smallest soil of the edges to the unvisited vertices (the same for every candidate j of a step).
+    private double getMinSoil(WeightedGraph graph, WaterDrop waterDrop) {
+        int from = waterDrop.getCurrentVertexId();
+        double minSoil = Double.POSITIVE_INFINITY;
+        for (int l = 0; l < graph.getDegree(from); l++) {
+            int vertex = graph.getNeighbour(from, l);
+            if (!waterDrop.isVisited(vertex)) {
+                minSoil = Math.min(minSoil, soil[graph.getEdgeId(from, vertex)]);
+            }
+        }
+        return minSoil;
+    }
+
+    private List<WaterDrop> getWDs(WeightedGraph graph) {
         List<WaterDrop> waterDrops = new ArrayList<WaterDrop>(graph.getNumberOfVertices());
 
         for (int i = 0; i < graph.getNumberOfVertices(); i++) {
@@ -168,31 +190,19 @@ public class IWD extends TSP {
         return random.ints(min, (max + 1)).findFirst().getAsInt();
     }
 
-    private void initParams(Graph graph, List<Vertex> verticesBEst, WaterDrop bestWaterDrop) {
-        List<Vertex> vertices;
-        for (int i = 0; i < graph.getNumberOfVertices(); i++) {
-            vertices = graph.adjacentOf(i);
-            for (Vertex vertex : vertices) {
-                vertex.addCharacteristic("soil", (double) 1000);
-            }}
-            int from = bestWaterDrop.getFirstVertexId();
-            for (Vertex v : verticesBEst) {
-                double soil = (0.1 * v.getCharacteristic("soil")) + (0.9 * ((2 * bestWaterDrop.getCarriedSoil()) / (graph.getNumberOfVertices() * (graph.getNumberOfVertices() - 1))));
-                graph.getVertex(from, v.getId()).addCharacteristic("soil", soil);
-                // because it's symmetric? how can we solve this issue in this case?
-                graph.getVertex(v.getId(), from).addCharacteristic("soil", soil);
-                from = v.getId();
-            }
+    private void initParams(WeightedGraph graph, int[] verticesBEst, WaterDrop bestWaterDrop) {
+        initParams(graph);
+        int from = bestWaterDrop.getFirstVertexId();
+        for (int v : verticesBEst) {
+            double pathSoil = (0.1 * soil[graph.getEdgeId(from, v)]) + (0.9 * ((2 * bestWaterDrop.getCarriedSoil()) / (graph.getNumberOfVertices() * (graph.getNumberOfVertices() - 1))));
+            graph.set(soil, from, v, pathSoil);
+            from = v;
+        }
 
     }
-    private void initParams(Graph graph) {
-        List<Vertex> vertices;
-        for (int i = 0; i < graph.getNumberOfVertices(); i++) {
-            vertices = graph.adjacentOf(i);
-            for (Vertex vertex : vertices) {
-                vertex.addCharacteristic("soil", (double) 1000);
-            }
-        }
+    // every edge id, also the ones of edges outside the adjacency lists.
+    private void initParams(WeightedGraph graph) {
+        Arrays.fill(soil, 1000);
     }
 
     public static void main(String[] args) {
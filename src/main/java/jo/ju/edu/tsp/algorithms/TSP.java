@@ -1,21 +1,37 @@
 package jo.ju.edu.tsp.algorithms;
 
 import jo.ju.edu.tsp.core.Graph;
-import jo.ju.edu.tsp.core.xml.Transformer;
+import jo.ju.edu.tsp.core.NeighbourLists;
+import jo.ju.edu.tsp.core.OverlayGraph;
+import jo.ju.edu.tsp.core.PackedGraph;
+import jo.ju.edu.tsp.core.WeightedGraph;
+import jo.ju.edu.tsp.core.kernels.CostBuffer;
+import jo.ju.edu.tsp.core.kernels.JavaTourKernels;
+import jo.ju.edu.tsp.core.kernels.TourKernels;
+import jo.ju.edu.tsp.core.xml.GraphCache;
 import jo.ju.edu.tsp.set.SetDetails;
 import jo.ju.edu.tsp.set.SetInstance;
 import org.jetbrains.annotations.NotNull;
 import org.xml.sax.SAXException;
 
 import javax.xml.parsers.ParserConfigurationException;
+import java.io.File;
 import java.io.IOException;
 
 public abstract class TSP {
+    // the length of the lists of getNeighbourLists (-Dtsp.neighbours=K).
+    private static final String NEIGHBOURS_PROPERTY = "tsp.neighbours";
+    private static final int DEFAULT_NEIGHBOURS = 10;
+    // the file of the instance being solved, if it was read from one.
+    private File instanceFile;
+    private NeighbourLists neighbourLists;
+    private TourKernels tourKernels;
+    private WeightedGraph tourKernelsGraph;
 
     public TSP() {
     }
 
-    public @NotNull Graph solve()
+    public @NotNull WeightedGraph solve()
             throws ParserConfigurationException, SAXException, IOException {
         return solve(SetInstance.SIMPLE);
     }
@@ -28,10 +44,80 @@ public abstract class TSP {
      * @throws SAXException in case the XML has a parsing problem.
      * @throws ParserConfigurationException in case the XML has a parsing problem for hugeXML files.
      */
-    public @NotNull Graph solve(@NotNull SetDetails set)
+    public @NotNull WeightedGraph solve(@NotNull SetDetails set)
             throws IOException, SAXException, ParserConfigurationException {
-        return solve(Transformer.constructGraph(set));
+        WeightedGraph graph = GraphCache.get(set);
+        instanceFile = set.getFile();
+        try {
+            return solve(graph);
+        } finally {
+            instanceFile = null;
+        }
     }
 
-    public abstract @NotNull Graph solve(@NotNull Graph graph);
+    // The nearest neighbours of every vertex of the graph being solved, sorted by cost: built once per graph (the runs
+    // on a cached graph share them) and kept next to the instance file (see NeighbourLists).
+    protected @NotNull NeighbourLists getNeighbourLists(@NotNull WeightedGraph graph) {
+        WeightedGraph shared = OverlayGraph.getShared(graph);
+        if(neighbourLists == null || neighbourLists.getGraph() != shared) {
+            int k = Integer.getInteger(NEIGHBOURS_PROPERTY, DEFAULT_NEIGHBOURS);
+            neighbourLists = instanceFile != null ? NeighbourLists.of(shared, k, instanceFile) : NeighbourLists.build(shared, k);
+        }
+        return neighbourLists;
+    }
+
+    // The kernels evaluating and improving the tours of the graph being solved: the native ones if the costs are in a
+    // CostBuffer (a mapped or a coordinate graph, see TourKernels.create), the Java ones reading getCost otherwise.
+    protected @NotNull TourKernels getTourKernels(@NotNull WeightedGraph graph) {
+        WeightedGraph shared = OverlayGraph.getShared(graph);
+        if(tourKernels == null || tourKernelsGraph != shared) {
+            CostBuffer costs = shared.getCostBuffer();
+            tourKernels = costs != null ? TourKernels.create(costs) : new JavaTourKernels(shared::getCost);
+            tourKernelsGraph = shared;
+        }
+        return tourKernels;
+    }
+
+    // the length of the closed tour (the vertices in the order of the tour).
+    protected double getTourLength(@NotNull WeightedGraph graph, @NotNull int[] tour) {
+        return getTourKernels(graph).getTourLength(tour);
+    }
+
+    // Applies the best 2-opt move along the neighbour lists until none improves the tour (a permutation of all vertices)
+    // and returns its length. A 2-opt move reverses a part of the tour, so the tours of asymmetric graphs are kept.
+    protected double improveByTwoOpt(@NotNull WeightedGraph graph, @NotNull int[] tour) {
+        if(!graph.isSymmetric() || tour.length < 4 || !isPermutation(tour, graph.getNumberOfVertices())) {
+            return getTourLength(graph, tour);
+        }
+        NeighbourLists lists = getNeighbourLists(graph);
+        return getTourKernels(graph).improveByTwoOpt(tour, lists.toKernelLists(), lists.getWidth());
+    }
+
+    private static boolean isPermutation(@NotNull int[] tour, int n) {
+        if(tour.length != n) return false;
+        boolean[] visited = new boolean[n];
+        for(int vertex : tour) {
+            if(vertex < 0 || vertex >= n || visited[vertex]) return false;
+            visited[vertex] = true;
+        }
+        return true;
+    }
+
+    // HCA and IWD send one water drop from every vertex and keep its tour and its visited vertices: 5 n^2 bytes, 37 GB
+    // for pla85900. Fails before the allocation if they cannot fit into the heap (WFA has no such state).
+    protected static void checkWaterDropMemory(@NotNull WeightedGraph graph, @NotNull String algorithm) {
+        long n = graph.getNumberOfVertices();
+        long required = n * n * (Integer.BYTES + 1);
+        if(required > Runtime.getRuntime().maxMemory()) {
+            throw new IllegalArgumentException(algorithm + " needs " + (required >> 20) + " MB for the water drops of "
+                    + n + " vertices, more than the heap of " + (Runtime.getRuntime().maxMemory() >> 20) + " MB");
+        }
+    }
+
+    // the adjacency lists are packed first.
+    public @NotNull WeightedGraph solve(@NotNull Graph graph) {
+        return solve(PackedGraph.of(graph));
+    }
+
+    public abstract @NotNull WeightedGraph solve(@NotNull WeightedGraph graph);
 }
@@ -1,8 +1,6 @@
 package jo.ju.edu.tsp.algorithms;
 
-import jo.ju.edu.tsp.core.Graph;
-import jo.ju.edu.tsp.core.Vertex;
-import jo.ju.edu.tsp.core.xml.Transformer;
+import jo.ju.edu.tsp.core.WeightedGraph;
 import org.jetbrains.annotations.NotNull;
 import org.xml.sax.SAXException;
 
@@ -27,14 +25,20 @@ public class WFA extends TSP {
     private Random randomGenerator;
     private HashMap<Integer, ArrayList<WaterFlowData> > waterFlows;
 
-    public @NotNull Graph solve(@NotNull Graph graph) {
+    public @NotNull WeightedGraph solve(@NotNull WeightedGraph graph) {
         Date previous = new Date(System.currentTimeMillis());
-        Transformer.print(graph);
         initializingStep(graph);
-        bestCost = generateInitialSolutionUsingNN(graph);
-      //  applyOPT2VersionTwo(initialPath, graph, bestCost);
-
-        bestCost += graph.getGraph().get(initialPath.get(initialPath.size() - 1)).get(initialPath.get(0)).getCost();
+        generateInitialSolutionUsingNN(graph);
+        // the nearest-neighbour tour is improved by 2-opt and evaluated by the tour kernels.
+        int[] tour = new int[initialPath.size()];
+        for (int k = 0; k < tour.length; k++) {
+            tour[k] = initialPath.get(k);
+        }
+        bestCost = improveByTwoOpt(graph, tour);
+        initialPath = new ArrayList<Integer>(tour.length + 1);
+        for (int vertex : tour) {
+            initialPath.add(vertex);
+        }
         initialPath.add(initialPath.get(0));
         bestPath = initialPath;
         while (!stopCreation) {
@@ -79,19 +83,18 @@ public class WFA extends TSP {
         return graph;
     }
 
-    private void generateSubFlows(Graph graph, WaterFlowData subMainFlow, int level) {
+    private void generateSubFlows(WeightedGraph graph, WaterFlowData subMainFlow, int level) {
         double n = Math.ceil(calculateSubFlowsInIteration(subMainFlow.getMass(), subMainFlow.getVelocity()));
         double Wik[] = new double[(int) n];
         double Vik[] = new double[(int) n];
 
-        ArrayList<Vertex> bestNodes = new ArrayList<Vertex>(graph.getGraph().get(subMainFlow.getNodes().get(subMainFlow.getNodes().size() - 1)));
-        Collections.sort(bestNodes);
-
-        for (Integer v : subMainFlow.getNodes()) {
-            bestNodes.remove(new Vertex(v, 0));
-        }
+        int last = subMainFlow.getNodes().get(subMainFlow.getNodes().size() - 1);
+        // the n closest unvisited vertices, from the sorted neighbour lists.
+        Set<Integer> visited = new HashSet<Integer>(subMainFlow.getNodes());
+        int[] bestNodes = new int[(int) n];
+        int numberOfBestNodes = getNeighbourLists(graph).getNearest(last, visited::contains, bestNodes);
 
-        if (bestNodes.isEmpty())
+        if (numberOfBestNodes == 0)
             return;
 
         for (int k = 0; k < n; k++) {
@@ -100,16 +103,14 @@ public class WFA extends TSP {
 
             WaterFlowData flow = new WaterFlowData(subMainFlow.getNodes(), subMainFlow.getCost(), Wik[k], Vik[k], k);
 
-            if (bestNodes.size() - 1 < k || bestNodes.get(k) == null) continue;
-            flow.addNodeToFlow(bestNodes.get(k).getId());
-            flow.addCost(bestNodes.get(k).getCost());
+            if (numberOfBestNodes - 1 < k) continue;
+            flow.addNodeToFlow(bestNodes[k]);
+            flow.addCost(graph.getCost(last, bestNodes[k]));
             waterFlows.get(level).add(flow);
 
             if (flow.getNodes().size() == graph.getNumberOfVertices()) {
                 flow.addNodeToFlow(flow.getNodes().get(0));
-                flow.addCost(graph.getGraph()
-                        .get(flow.getNodes().get(flow.getNodes().size() - 2))
-                        .get(flow.getNodes().get(0) > flow.getNodes().get(flow.getNodes().size() - 2) ? flow.getNodes().get(0) - 1 : flow.getNodes().get(0)).getCost());
+                flow.addCost(graph.getCost(flow.getNodes().get(flow.getNodes().size() - 2), flow.getNodes().get(0)));
 
                 if(flow.getCost() < bestCost) {
                     bestPath = flow.getNodes();
@@ -122,7 +123,7 @@ public class WFA extends TSP {
 
     }
 
-    private void initializingStep(Graph graph) {
+    private void initializingStep(WeightedGraph graph) {
         G = graph.getNumberOfVertices();
         W = new double[graph.getNumberOfVertices()];
         V = new double[graph.getNumberOfVertices()];
@@ -220,34 +221,26 @@ public class WFA extends TSP {
         W[i] = distributedInitialMassValueToI(i) - calculateSumOfW(n[i]);
     }
 
-    private int generateInitialSolutionUsingNN(Graph graph) {
-        int roadCost = 0;
+    // a nearest-neighbour tour into initialPath.
+    private void generateInitialSolutionUsingNN(WeightedGraph graph) {
         Map<Integer, Boolean> visited;
         Integer initialNode;
         Integer nextNode;
-        double minCost;
         int minNode;
         initialPath = new ArrayList<Integer>();
 
         for (int i = 0; i < graph.getNumberOfVertices(); i++) {
-            minCost = Integer.MAX_VALUE;
             minNode = Integer.MAX_VALUE;
             nextNode = new Random().nextInt(graph.getNumberOfVertices() - 1);
             initialNode = new Random().nextInt(graph.getNumberOfVertices() - 1);
-            roadCost = 0;
             visited = new HashMap<Integer, Boolean>();
             visited.put(initialNode, true);
             initialPath.add(initialNode);
             while (nextNode != -1) {
-                minCost = Integer.MAX_VALUE;
-                minNode = Integer.MAX_VALUE;
-                for (Vertex vertex : graph.getGraph().get(nextNode)) {
-                    if (minCost > vertex.getCost() && visited.get(vertex.getId()) == null) {
-                        minNode = vertex.getId();
-                        minCost = vertex.getCost();
-                    }
-                }
-                roadCost += minCost;
+                // the closest unvisited vertex, from the sorted neighbour lists.
+                Map<Integer, Boolean> excluded = visited;
+                minNode = getNeighbourLists(graph).getNearest(nextNode, v -> excluded.get(v) != null);
+                if (minNode == -1) break;
 
                 if (visited.get(minNode) != null) {
                     break;
@@ -262,78 +255,12 @@ public class WFA extends TSP {
 
             }
             if (visited.size() == graph.getNumberOfVertices()) {
-                Vertex backNode = graph.getGraph().get(minNode).get(initialNode);
-                if (backNode != null) {
-                    roadCost += backNode.getCost();
+                if (minNode != initialNode) {
                     break;
                 }
             }
 
         }
-
-        return roadCost;
-    }
-
-    private void applyOPT2VersionTwo(ArrayList<Integer> initialPath, Graph graph, double initialDist) {
-        double bestDist = initialDist;
-        double newDist;
-        int swaps = 1;
-        ArrayList<Integer> newTour;
-
-
-        while (swaps != 0) { //loop until no improvements are made.
-            swaps = 0;
-            //initialise inner/outer loops avoiding adjacent calculations and making use of problem symmetry to half total comparisons.
-
-            for (int i = 1; i < initialPath.size() - 2; i++) {
-                for (int j = i + 1; j < initialPath.size() - 1; j++) {
-                    //check distance of line A,B + line C,D against A,C + B,D if there is improvement, call swap method.
-                    if ((graph.getGraph().get(initialPath.get(i)).get(initialPath.get(i - 1) > initialPath.get(i) ? initialPath.get(i - 1) - 1 : initialPath.get(i - 1)).getCost()
-                            + graph.getGraph().get(initialPath.get(j + 1)).get(initialPath.get(j) > initialPath.get(j + 1) ? initialPath.get(j) - 1 : initialPath.get(j)).getCost())
-                            >= (graph.getGraph().get(initialPath.get(i)).get(initialPath.get(j + 1) > initialPath.get(i) ? initialPath.get(j + 1) - 1 : initialPath.get(j + 1)).getCost()
-                            + graph.getGraph().get(initialPath.get(i - 1)).get(initialPath.get(j) > initialPath.get(i - 1) ? initialPath.get(j) - 1 : initialPath.get(j)).getCost())) {
-
-
-                        Double newTourCost = 0.0;
-                        newTour = swap(initialPath, i, j, newTourCost, graph);
-
-                        if (newTourCost < bestDist) {
-                            initialPath = newTour;
-                            bestDist = newTourCost;
-                            swaps++;
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    private static ArrayList<Integer> swap(ArrayList<Integer> cities, int i, int j, Double newTourDistance, Graph graph) {
-        //conducts a 2 opt swap by inverting the order of the points between i and j
-        ArrayList<Integer> newTour = new ArrayList<Integer>();
-        int size = cities.size();
-
-        for (int c = 0; c <= i - 1; c++) {
-            newTour.add(cities.get(c));
-        }
-
-        //invert order between 2 passed points i and j and add to newTour
-        int dec = 0;
-        for (int c = i; c <= j; c++) {
-            newTour.add(cities.get(j - dec));
-            dec++;
-        }
-
-        //append array from point j to end to newTour
-        for (int c = j + 1; c < size; c++) {
-            newTour.add(cities.get(c));
-        }
-
-        for (int c = 0; c < cities.size() - 1; c++) {
-            newTourDistance += graph.getGraph().get(cities.get(c)).get(cities.get(c + 1)).getCost();
-        }
-        newTourDistance += graph.getGraph().get(cities.get(cities.size() - 1)).get(0).getCost();
-        return newTour;
     }
 
     private void printTour(ArrayList<Integer> path) {
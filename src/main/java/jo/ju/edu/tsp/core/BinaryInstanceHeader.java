@@ -0,0 +1,75 @@
+package jo.ju.edu.tsp.core;
+
+import jo.ju.edu.tsp.core.kernels.Metric;
+import org.jetbrains.annotations.NotNull;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+
+// The header of a binary instance (.tspb, see BinaryInstanceFormat.hpp): 32 bytes, little endian, followed by the
+// payload of doubles (the coordinates x, y of each vertex, the strictly lower triangle or the full matrix).
+final class BinaryInstanceHeader {
+    static final int SIZE = 32;
+    static final int KIND_COORDINATES = 1;
+    static final int KIND_LOWER_MATRIX = 2;
+    static final int KIND_FULL_MATRIX = 3;
+    private static final byte[] MAGIC = {'T', 'S', 'P', 'B', 'I', 'N', '0', '1'};
+
+    final int kind;
+    // 0 for matrices, otherwise the ordinal of the Metric + 1.
+    final int metric;
+    final long numberOfVertices;
+
+    BinaryInstanceHeader(int kind, int metric, long numberOfVertices) {
+        this.kind = kind;
+        this.metric = metric;
+        this.numberOfVertices = numberOfVertices;
+    }
+
+    static @NotNull BinaryInstanceHeader read(@NotNull FileChannel channel, @NotNull File file) throws IOException {
+        ByteBuffer header = ByteBuffer.allocate(SIZE).order(ByteOrder.LITTLE_ENDIAN);
+        while(header.hasRemaining() && channel.read(header, header.position()) > 0) {
+            // a positional read may return less than asked.
+        }
+        if(header.hasRemaining()) throw new IOException(file + " is not a binary instance");
+        for(int i = 0; i < MAGIC.length; i++) {
+            if(header.get(i) != MAGIC[i]) throw new IOException(file + " is not a binary instance");
+        }
+        int kind = header.getInt(8), metric = header.getInt(12);
+        long n = header.getLong(16);
+        if(kind < KIND_COORDINATES || kind > KIND_FULL_MATRIX || metric < 0 || metric > Metric.values().length
+                || (kind == KIND_COORDINATES && metric == 0) || n < 0 || n > Integer.MAX_VALUE) {
+            throw new IOException(file + " is not a valid binary instance");
+        }
+        BinaryInstanceHeader result = new BinaryInstanceHeader(kind, metric, n);
+        if(channel.size() < SIZE + result.getPayloadSize()) throw new IOException(file + " is truncated");
+        return result;
+    }
+
+    // at the start of the channel.
+    void write(@NotNull FileChannel channel) throws IOException {
+        ByteBuffer header = ByteBuffer.allocate(SIZE).order(ByteOrder.LITTLE_ENDIAN);
+        header.put(MAGIC).putInt(kind).putInt(metric).putLong(numberOfVertices).putLong(0);
+        header.flip();
+        while(header.hasRemaining()) {
+            channel.write(header, header.position());
+        }
+    }
+
+    // the number of doubles of the payload.
+    long getNumberOfValues() {
+        long n = numberOfVertices;
+        return kind == KIND_COORDINATES ? 2 * n : kind == KIND_LOWER_MATRIX ? n * (n - 1) / 2 : n * n;
+    }
+
+    long getPayloadSize() {
+        return getNumberOfValues() * Double.BYTES;
+    }
+
+    @NotNull Metric getMetric() {
+        return Metric.values()[metric - 1];
+    }
+}
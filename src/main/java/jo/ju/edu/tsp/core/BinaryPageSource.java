@@ -0,0 +1,96 @@
+package jo.ju.edu.tsp.core;
+
+import org.jetbrains.annotations.NotNull;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.channels.FileChannel;
+
+// Reads the rows of a binary instance (.tspb) with a lower triangle or a full matrix for a PagedGraph. The rows of a
+// page are consecutive in the file, so a full matrix is read with one positional read per page. Of a lower triangle,
+// the same read gives the costs to the smaller vertices; the costs to the larger vertices j are the entries of the page
+// in the rows j of the triangle, which follow in the file: the ones of the page itself are copied, the later rows take
+// one short read each.
+public class BinaryPageSource implements PagedGraph.PageSource {
+    private final RandomAccessFile raf;
+    private final FileChannel channel;
+    private final BinaryInstanceHeader header;
+    private ByteBuffer buffer = ByteBuffer.allocate(0);
+
+    public BinaryPageSource(@NotNull File file) throws IOException {
+        this.raf = new RandomAccessFile(file, "r");
+        this.channel = raf.getChannel();
+        try {
+            this.header = BinaryInstanceHeader.read(channel, file);
+            if(header.kind == BinaryInstanceHeader.KIND_COORDINATES) {
+                throw new IOException(file + " holds coordinates, which need no pages (see CoordinateGraph)");
+            }
+        } catch (IOException | RuntimeException ex) {
+            raf.close();
+            throw ex;
+        }
+    }
+
+    @Override
+    public int getNumberOfVertices() {
+        return (int) header.numberOfVertices;
+    }
+
+    @Override
+    public boolean isSymmetric() {
+        return header.kind == BinaryInstanceHeader.KIND_LOWER_MATRIX;
+    }
+
+    @Override
+    public void readRows(int first, @NotNull double[][] rows) throws IOException {
+        int n = getNumberOfVertices(), last = first + rows.length - 1;
+        if(!isSymmetric()) {
+            DoubleBuffer doubles = read((long) first * n, (long) rows.length * n, first);
+            for(double[] row : rows) {
+                doubles.get(row);
+            }
+            return;
+        }
+
+        // the rows of the page in the triangle: the costs to the smaller vertices.
+        DoubleBuffer doubles = read((long) first * (first - 1) / 2, ((long) last * (last + 1) - (long) first * (first - 1)) / 2, first);
+        for(int i = first; i <= last; i++) {
+            double[] row = rows[i - first];
+            doubles.get(row, 0, i);
+            row[i] = 0;
+            for(int j = first; j < i; j++) {
+                rows[j - first][i] = row[j];
+            }
+        }
+        // the costs to the larger vertices: the columns first ... last of the later rows.
+        for(int j = last + 1; j < n; j++) {
+            doubles = read((long) j * (j - 1) / 2 + first, rows.length, first);
+            for(int i = first; i <= last; i++) {
+                rows[i - first][j] = doubles.get();
+            }
+        }
+    }
+
+    // the values start ... start + values - 1 of the payload, read with one positional read.
+    private @NotNull DoubleBuffer read(long start, long values, int first) throws IOException {
+        if(values * Double.BYTES > Integer.MAX_VALUE) throw new IOException("The page of the row " + first + " is too large");
+        int size = (int) (values * Double.BYTES);
+        if(buffer.capacity() < size) buffer = ByteBuffer.allocateDirect(size).order(ByteOrder.LITTLE_ENDIAN);
+        buffer.clear().limit(size);
+        long position = BinaryInstanceHeader.SIZE + start * Double.BYTES;
+        while(buffer.hasRemaining()) {
+            if(channel.read(buffer, position + buffer.position()) < 0) throw new IOException("Unexpected end of the file");
+        }
+        buffer.flip();
+        return buffer.asDoubleBuffer();
+    }
+
+    @Override
+    public void close() throws IOException {
+        raf.close();
+    }
+}
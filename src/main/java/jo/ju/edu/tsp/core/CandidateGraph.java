@@ -0,0 +1,226 @@
+package jo.ju.edu.tsp.core;
+
+import jo.ju.edu.tsp.core.kernels.CostBuffer;
+import org.jetbrains.annotations.NotNull;
+import org.jetbrains.annotations.Nullable;
+
+import java.util.Arrays;
+import java.util.function.IntPredicate;
+
+// The candidate edges of an instance (e.g. the k nearest neighbours of every vertex) in CSR layout: the adjacent vertices
+// of v are targets[offsets[v]] ... targets[offsets[v + 1] - 1], sorted by increasing cost, so a solver choosing the next
+// vertex looks at k vertices instead of n - 1. Of a symmetric instance the lists are made symmetric (j is a candidate
+// of i if i is one of j) and both directions share an edge id. The costs of the other edges come from the base graph,
+// which a solver reaches through getFallbackNeighbour when all candidates of a vertex are visited. All non-candidate
+// edges share the last edge id, whose entry of a column is read-only: set and setDirected skip them, so every
+// non-candidate edge keeps the initial value of the column (e.g. the initial soil) and no write spreads to others.
+public class CandidateGraph implements WeightedGraph {
+    private final WeightedGraph base;
+    private final int[] offsets;
+    private final int[] targets;
+    private final double[] costs;
+    private final int[] edgeIds;
+    private final int numberOfCandidateEdges;
+    private final EdgeColumns columns = new EdgeColumns();
+
+    private CandidateGraph(@NotNull WeightedGraph base, @NotNull int[] offsets, @NotNull int[] targets, @NotNull double[] costs) {
+        this.base = base;
+        this.offsets = offsets;
+        this.targets = targets;
+        this.costs = costs;
+        this.edgeIds = new int[targets.length];
+        Arrays.fill(edgeIds, -1);
+        int next = 0;
+        for(int v = 0; v < offsets.length - 1; v++) {
+            for(int p = offsets[v]; p < offsets[v + 1]; p++) {
+                if(edgeIds[p] >= 0) continue;
+                edgeIds[p] = next;
+                if(base.isSymmetric()) edgeIds[find(targets[p], v)] = next;
+                next++;
+            }
+        }
+        this.numberOfCandidateEdges = next;
+    }
+
+    // The candidates of v are given by targets[offsets[v]] ... targets[offsets[v + 1] - 1] with their costs (the arrays
+    // are kept); of a symmetric base graph the missing reverse candidates are added and the lists sorted.
+    public static @NotNull CandidateGraph of(@NotNull WeightedGraph base, @NotNull int[] offsets, @NotNull int[] targets, @NotNull double[] costs) {
+        int n = base.getNumberOfVertices();
+        if(offsets.length != n + 1 || offsets[0] != 0 || offsets[n] > targets.length || offsets[n] > costs.length) {
+            throw new IllegalArgumentException("The offsets do not fit the " + n + " vertices");
+        }
+        for(int v = 0; v < n; v++) {
+            if(offsets[v + 1] < offsets[v]) throw new IllegalArgumentException("The offsets decrease at the vertex " + v);
+            for(int p = offsets[v]; p < offsets[v + 1]; p++) {
+                if(targets[p] < 0 || targets[p] >= n || targets[p] == v || indexOf(offsets, targets, v, targets[p]) < p) {
+                    throw new IllegalArgumentException("Invalid candidate " + targets[p] + " of the vertex " + v);
+                }
+            }
+        }
+        if(!base.isSymmetric()) {
+            return new CandidateGraph(base, offsets, Arrays.copyOf(targets, offsets[n]), Arrays.copyOf(costs, offsets[n]));
+        }
+
+        int[] degrees = new int[n];
+        for(int v = 0; v < n; v++) {
+            degrees[v] += offsets[v + 1] - offsets[v];
+            for(int p = offsets[v]; p < offsets[v + 1]; p++) {
+                if(indexOf(offsets, targets, targets[p], v) < 0) degrees[targets[p]]++;
+            }
+        }
+        int[] symmetricOffsets = new int[n + 1];
+        for(int v = 0; v < n; v++) {
+            symmetricOffsets[v + 1] = symmetricOffsets[v] + degrees[v];
+        }
+        int[] symmetricTargets = new int[symmetricOffsets[n]], ends = new int[n];
+        double[] symmetricCosts = new double[symmetricOffsets[n]];
+        for(int v = 0; v < n; v++) {
+            int length = offsets[v + 1] - offsets[v];
+            System.arraycopy(targets, offsets[v], symmetricTargets, symmetricOffsets[v], length);
+            System.arraycopy(costs, offsets[v], symmetricCosts, symmetricOffsets[v], length);
+            ends[v] = symmetricOffsets[v] + length;
+        }
+        for(int v = 0; v < n; v++) {
+            for(int p = offsets[v]; p < offsets[v + 1]; p++) {
+                int u = targets[p];
+                if(indexOf(offsets, targets, u, v) >= 0) continue;
+                symmetricTargets[ends[u]] = v;
+                symmetricCosts[ends[u]++] = costs[p];
+            }
+        }
+        for(int v = 0; v < n; v++) {
+            sortByCost(symmetricTargets, symmetricCosts, symmetricOffsets[v], symmetricOffsets[v + 1]);
+        }
+        return new CandidateGraph(base, symmetricOffsets, symmetricTargets, symmetricCosts);
+    }
+
+    // the k cheapest edges leaving every vertex (see NeighbourLists).
+    public static @NotNull CandidateGraph ofNearestNeighbours(@NotNull WeightedGraph base, int k) {
+        NeighbourLists lists = NeighbourLists.build(base, k);
+        return of(base, lists.offsets, lists.targets, lists.costs);
+    }
+
+    // an insertion sort, the lists are short.
+    private static void sortByCost(@NotNull int[] targets, @NotNull double[] costs, int start, int end) {
+        for(int i = start + 1; i < end; i++) {
+            int target = targets[i];
+            double cost = costs[i];
+            int p = i;
+            for(; p > start && costs[p - 1] > cost; p--) {
+                targets[p] = targets[p - 1];
+                costs[p] = costs[p - 1];
+            }
+            targets[p] = target;
+            costs[p] = cost;
+        }
+    }
+
+    private static int indexOf(@NotNull int[] offsets, @NotNull int[] targets, int from, int to) {
+        for(int p = offsets[from]; p < offsets[from + 1]; p++) {
+            if(targets[p] == to) return p;
+        }
+        return -1;
+    }
+
+    private int find(int from, int to) {
+        return indexOf(offsets, targets, from, to);
+    }
+
+    public @NotNull WeightedGraph getBase() {
+        return base;
+    }
+
+    // the number of candidate edges, a symmetric edge counted once.
+    public int getNumberOfCandidateEdges() {
+        return numberOfCandidateEdges;
+    }
+
+    @Override
+    public @NotNull String getName() {
+        return base.getName();
+    }
+
+    @Override
+    public int getNumberOfVertices() {
+        return offsets.length - 1;
+    }
+
+    @Override
+    public boolean isSymmetric() {
+        return base.isSymmetric();
+    }
+
+    // the candidate edges and the shared id of the other edges.
+    @Override
+    public int getNumberOfEdges() {
+        return numberOfCandidateEdges + 1;
+    }
+
+    @Override
+    public int getEdgeId(int from, int to) {
+        int p = find(from, to);
+        return p >= 0 ? edgeIds[p] : numberOfCandidateEdges;
+    }
+
+    // the entry of the non-candidate edges is not written.
+    @Override
+    public void set(@NotNull double[] column, int from, int to, double value) {
+        setDirected(column, from, to, value);
+        if(!isSymmetric()) setDirected(column, to, from, value);
+    }
+
+    @Override
+    public void setDirected(@NotNull double[] column, int from, int to, double value) {
+        int p = find(from, to);
+        if(p >= 0) column[edgeIds[p]] = value;
+    }
+
+    @Override
+    public double getCost(int from, int to) {
+        int p = find(from, to);
+        return p >= 0 ? costs[p] : base.getCost(from, to);
+    }
+
+    @Override
+    public double getCostConcurrently(int from, int to) {
+        int p = find(from, to);
+        return p >= 0 ? costs[p] : base.getCostConcurrently(from, to);
+    }
+
+    // the costs of all edges, those of the base graph.
+    @Override
+    public @Nullable CostBuffer getCostBuffer() {
+        return base.getCostBuffer();
+    }
+
+    @Override
+    public int getDegree(int vertex) {
+        return offsets[vertex + 1] - offsets[vertex];
+    }
+
+    @Override
+    public int getNeighbour(int vertex, int k) {
+        return targets[offsets[vertex] + k];
+    }
+
+    // the cheapest vertex that is not excluded, O(n).
+    @Override
+    public int getFallbackNeighbour(int vertex, @NotNull IntPredicate excluded) {
+        int nearest = -1;
+        double nearestCost = Double.POSITIVE_INFINITY;
+        for(int u = 0; u < getNumberOfVertices(); u++) {
+            if(u == vertex || excluded.test(u)) continue;
+            double cost = base.getCost(vertex, u);
+            if(nearest == -1 || cost < nearestCost) {
+                nearest = u;
+                nearestCost = cost;
+            }
+        }
+        return nearest;
+    }
+
+    @Override
+    public @NotNull double[] getColumn(@NotNull EdgeAttribute attribute) {
+        return columns.get(attribute, getNumberOfEdges());
+    }
+}
@@ -0,0 +1,135 @@
+package jo.ju.edu.tsp.core;
+
+import jo.ju.edu.tsp.core.kernels.CostBuffer;
+import jo.ju.edu.tsp.core.kernels.Metric;
+import org.jetbrains.annotations.NotNull;
+import org.jetbrains.annotations.Nullable;
+
+// A complete symmetric graph given by the coordinates of its vertices: the costs are computed on demand with a TSPLIB
+// metric (see CostBuffer), so the graph takes O(n) memory and even pla85900 fits. With a row cache, the rows of costs
+// read last are kept within a budget in MB (see RowCache), as the solvers read the row of the current vertex several
+// times per step; a cost is served from the row of either vertex. A miss computes only the asked cost, a row is filled
+// once SCAN_MISSES costs in a row missed from the same vertex (a scan of its adjacent vertices). The edge ids are those of PackedGraph; for more than
+// 65536 vertices they do not fit in an int, so only the costs can be used (Transformer then restricts the solvers to
+// candidate edges, see CandidateGraph).
+public class CoordinateGraph implements WeightedGraph {
+    public static final int MAX_VERTICES_WITH_EDGE_IDS = 65536;
+    private static final int SCAN_MISSES = 16;
+
+    private final String name;
+    private final int numberOfVertices;
+    private final CostBuffer costs;
+    private final EdgeColumns columns = new EdgeColumns();
+    private final RowCache rows;
+    // the vertex whose costs missed last, and how many times in a row.
+    private int scanVertex = -1, scanMisses = 0;
+
+    // rounded: the costs of EUC_2D and CEIL_2D are rounded as defined by the TSPLIB, otherwise they are exact (as in the
+    // XML files); ATT and GEO are always rounded, as TransformTSPLIB writes them (see Metric.isAlwaysRounded);
+    // cacheMegabytes: the budget of the row cache, 0 for none.
+    public CoordinateGraph(@NotNull String name, @NotNull double[] x, @NotNull double[] y, @NotNull Metric metric, boolean rounded, int cacheMegabytes) {
+        this.name = name;
+        this.numberOfVertices = x.length;
+        this.costs = CostBuffer.ofCoordinates(x, y, metric, rounded || metric.isAlwaysRounded());
+        this.rows = cacheMegabytes > 0 ? new RowCache(this::computeRow, numberOfVertices, cacheMegabytes) : null;
+    }
+
+    public CoordinateGraph(@NotNull String name, @NotNull double[] x, @NotNull double[] y, @NotNull Metric metric) {
+        this(name, x, y, metric, false, 0);
+    }
+
+    private void computeRow(int vertex, @NotNull double[] row) {
+        for(int j = 0; j < numberOfVertices; j++) {
+            row[j] = j == vertex ? 0 : costs.getCost(vertex, j);
+        }
+    }
+
+    // the row cache with its hit and miss counters, or null.
+    public @Nullable RowCache getRowCache() {
+        return rows;
+    }
+
+    // the coordinates, from which the TourKernels compute the costs.
+    @Override
+    public @NotNull CostBuffer getCostBuffer() {
+        return costs;
+    }
+
+    @Override
+    public @NotNull String getName() {
+        return name;
+    }
+
+    @Override
+    public int getNumberOfVertices() {
+        return numberOfVertices;
+    }
+
+    @Override
+    public boolean isSymmetric() {
+        return true;
+    }
+
+    // false for more than MAX_VERTICES_WITH_EDGE_IDS vertices: getNumberOfEdges, getEdgeId and getColumn fail.
+    public boolean hasEdgeIds() {
+        return numberOfVertices <= MAX_VERTICES_WITH_EDGE_IDS;
+    }
+
+    @Override
+    public int getNumberOfEdges() {
+        checkEdgeIds();
+        return (int) ((long) numberOfVertices * (numberOfVertices - 1) / 2);
+    }
+
+    @Override
+    public int getEdgeId(int from, int to) {
+        checkEdgeIds();
+        return PackedGraph.getLowerEdgeId(from, to);
+    }
+
+    @Override
+    public double getCost(int from, int to) {
+        if(rows == null) return costs.getCost(from, to);
+        double[] row = rows.peek(from);
+        if(row != null) return row[to];
+        row = rows.peek(to);
+        if(row != null) return row[from];
+        if(from != scanVertex) {
+            scanVertex = from;
+            scanMisses = 0;
+        }
+        if(++scanMisses < SCAN_MISSES) {
+            rows.countMiss();
+            return costs.getCost(from, to);
+        }
+        return rows.getRow(from)[to];
+    }
+
+    // computed, the row cache is not thread-safe.
+    @Override
+    public double getCostConcurrently(int from, int to) {
+        return costs.getCost(from, to);
+    }
+
+    @Override
+    public int getDegree(int vertex) {
+        return numberOfVertices - 1;
+    }
+
+    // all other vertices in increasing order.
+    @Override
+    public int getNeighbour(int vertex, int k) {
+        return k < vertex ? k : k + 1;
+    }
+
+    @Override
+    public @NotNull double[] getColumn(@NotNull EdgeAttribute attribute) {
+        return columns.get(attribute, getNumberOfEdges());
+    }
+
+    private void checkEdgeIds() {
+        if(!hasEdgeIds()) {
+            throw new IllegalStateException("The edges of " + numberOfVertices + " vertices have no int ids");
+        }
+    }
+}
@@ -0,0 +1,47 @@
+package jo.ju.edu.tsp.core;
+
+import org.jetbrains.annotations.NotNull;
+
+import java.util.ArrayList;
+import java.util.List;
+
+// A registered attribute of the edges, such as the soil of the water drop algorithms. The handle is resolved once by
+// WeightedGraph.getColumn to a double[] indexed by the edge id, so an algorithm reads and writes soil[edge] directly.
+public final class EdgeAttribute {
+    private static final List<EdgeAttribute> ATTRIBUTES = new ArrayList<EdgeAttribute>();
+
+    public static final EdgeAttribute SOIL = register("soil");
+    public static final EdgeAttribute DEPTH = register("depth");
+
+    private final String name;
+    private final int index;
+
+    private EdgeAttribute(@NotNull String name, int index) {
+        this.name = name;
+        this.index = index;
+    }
+
+    // returns the attribute of this name, which is registered on the first call.
+    public static synchronized @NotNull EdgeAttribute register(@NotNull String name) {
+        for(EdgeAttribute attribute : ATTRIBUTES) {
+            if(attribute.name.equals(name)) return attribute;
+        }
+        EdgeAttribute attribute = new EdgeAttribute(name, ATTRIBUTES.size());
+        ATTRIBUTES.add(attribute);
+        return attribute;
+    }
+
+    public @NotNull String getName() {
+        return name;
+    }
+
+    // the attributes are numbered 0, 1, ... in the order of registration.
+    public int getIndex() {
+        return index;
+    }
+
+    @Override
+    public String toString() {
+        return name;
+    }
+}
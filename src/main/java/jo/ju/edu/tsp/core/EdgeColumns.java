@@ -0,0 +1,25 @@
+package jo.ju.edu.tsp.core;
+
+import org.jetbrains.annotations.NotNull;
+
+import java.util.Arrays;
+
+// The columns of the edge attributes of a graph, indexed by EdgeAttribute.getIndex(). A column is allocated (with
+// zeros) when it is first asked for, so a graph only holds the attributes its algorithm uses.
+final class EdgeColumns {
+    private double[][] columns = new double[2][];
+
+    // the column of the attribute with at least numberOfEdges entries; a shorter one is extended with zeros.
+    @NotNull double[] get(@NotNull EdgeAttribute attribute, int numberOfEdges) {
+        int index = attribute.getIndex();
+        if(index >= columns.length) {
+            columns = Arrays.copyOf(columns, index + 1);
+        }
+        if(columns[index] == null) {
+            columns[index] = new double[numberOfEdges];
+        } else if(columns[index].length < numberOfEdges) {
+            columns[index] = Arrays.copyOf(columns[index], numberOfEdges);
+        }
+        return columns[index];
+    }
+}
@@ -0,0 +1,84 @@
+package jo.ju.edu.tsp.core;
+
+import java.util.Arrays;
+
+// Maps the edges (from, to) of a graph with n vertices to ints in constant time: an open-addressed hash table (linear
+// probing) while the graph is sparse, and a direct table of n * n slots once a quarter of them would be used, which
+// then takes less memory than the hash table.
+final class EdgeIndex {
+    static final int NONE = -1;
+    private static final long EMPTY = -1L;
+    private final int numberOfVertices;
+    private long[] keys;
+    private int[] values;
+    private int[] direct = null;
+    private int size = 0;
+
+    EdgeIndex(int numberOfVertices) {
+        this.numberOfVertices = numberOfVertices;
+        this.keys = new long[16];
+        this.values = new int[16];
+        Arrays.fill(keys, EMPTY);
+    }
+
+    int get(int from, int to) {
+        if(from < 0 || from >= numberOfVertices || to < 0 || to >= numberOfVertices) return NONE;
+        if(direct != null) return direct[from * numberOfVertices + to];
+
+        long key = (long) from * numberOfVertices + to;
+        for(int slot = slot(key, keys.length); keys[slot] != EMPTY; slot = (slot + 1) & (keys.length - 1)) {
+            if(keys[slot] == key) return values[slot];
+        }
+        return NONE;
+    }
+
+    // keeps the first value of an edge, as a scan of the adjacency list finds the first vertex.
+    void putIfAbsent(int from, int to, int value) {
+        if(from < 0 || from >= numberOfVertices || to < 0 || to >= numberOfVertices) return;
+        if(direct != null) {
+            if(direct[from * numberOfVertices + to] == NONE) direct[from * numberOfVertices + to] = value;
+            return;
+        }
+
+        long key = (long) from * numberOfVertices + to;
+        int slot = slot(key, keys.length);
+        for(; keys[slot] != EMPTY; slot = (slot + 1) & (keys.length - 1)) {
+            if(keys[slot] == key) return;
+        }
+        keys[slot] = key;
+        values[slot] = value;
+        if(++size * 2 > keys.length) grow();
+    }
+
+    private void grow() {
+        long slots = (long) numberOfVertices * numberOfVertices;
+        if(slots <= Integer.MAX_VALUE && size * 4L >= slots) {
+            direct = new int[(int) slots];
+            Arrays.fill(direct, NONE);
+            for(int slot = 0; slot < keys.length; slot++) {
+                if(keys[slot] != EMPTY) direct[(int) keys[slot]] = values[slot];
+            }
+            keys = null;
+            values = null;
+            return;
+        }
+
+        long[] oldKeys = keys;
+        int[] oldValues = values;
+        keys = new long[oldKeys.length * 2];
+        values = new int[oldKeys.length * 2];
+        Arrays.fill(keys, EMPTY);
+        for(int old = 0; old < oldKeys.length; old++) {
+            if(oldKeys[old] == EMPTY) continue;
+            int slot = slot(oldKeys[old], keys.length);
+            while(keys[slot] != EMPTY) slot = (slot + 1) & (keys.length - 1);
+            keys[slot] = oldKeys[old];
+            values[slot] = oldValues[old];
+        }
+    }
+
+    private static int slot(long key, int length) {
+        long hash = key * 0x9E3779B97F4A7C15L;
+        return (int) (hash ^ (hash >>> 32)) & (length - 1);
+    }
+}
@@ -1,16 +1,26 @@
 package jo.ju.edu.tsp.core;
 
+import org.jetbrains.annotations.NotNull;
+
 import java.util.ArrayList;
 import java.util.List;
 
-public class Graph {
+// The edge ids of the WeightedGraph view are the order in which the vertices were put. The edges (i, j) and (j, i) are
+// separate vertices, so the graph is not symmetric in the sense of WeightedGraph even if their costs are equal.
+public class Graph implements WeightedGraph {
     private int numberOfVertices;
     private List<List<Vertex>> graph;
     private String name;
+    private List<Vertex> edges;
+    private EdgeIndex index;
+    private EdgeColumns columns;
     
     public Graph(int numberOfVertices, String name) {
         this.numberOfVertices = numberOfVertices;
         this.name = name;
+        edges = new ArrayList<Vertex>();
+        index = new EdgeIndex(numberOfVertices);
+        columns = new EdgeColumns();
         graph = new ArrayList<List<Vertex>>(numberOfVertices);
         for(int i = 0; i < numberOfVertices; i++) {
             // initialize all items with empty lists.
@@ -26,6 +36,8 @@ public class Graph {
         }
 
         graph.get(idx).add(vertex);
+        index.putIfAbsent(idx, vertex.getId(), edges.size());
+        edges.add(vertex);
     }
 
     public List<Vertex> adjacentOf(int idx) {
@@ -36,7 +48,16 @@ public class Graph {
         return vertices;
     }
 
+    // throws IndexOutOfBoundsException if from is not a vertex, as graph.get(from) did before the index.
     public Vertex getVertex(int from, int to) {
+        if(from < 0 || from >= numberOfVertices) {
+            throw new IndexOutOfBoundsException("vertex " + from + " of " + numberOfVertices);
+        }
+        int edge = index.get(from, to);
+        if(edge != EdgeIndex.NONE) return edges.get(edge);
+        if(to >= 0 && to < numberOfVertices) return null;
+
+        // false information: an id out of range is not indexed.
         List<Vertex> vertices = graph.get(from);
         if(vertices != null && !vertices.isEmpty()) {
             for(Vertex v : vertices) {
@@ -46,15 +67,59 @@ public class Graph {
         return null;
     }
 
+    @Override
     public int getNumberOfVertices() {
         return numberOfVertices;
     }
 
+    @Override
+    public boolean isSymmetric() {
+        return false;
+    }
+
+    @Override
+    public int getNumberOfEdges() {
+        return edges.size();
+    }
+
+    // the edge id of the vertex to in the adjacency list of from, or -1.
+    @Override
+    public int getEdgeId(int from, int to) {
+        return index.get(from, to);
+    }
+
+    @Override
+    public double getCost(int from, int to) {
+        return edges.get(index.get(from, to)).getCost();
+    }
+
+    @Override
+    public double getCostConcurrently(int from, int to) {
+        return getCost(from, to);
+    }
+
+    @Override
+    public int getDegree(int vertex) {
+        return adjacentOf(vertex).size();
+    }
+
+    @Override
+    public int getNeighbour(int vertex, int k) {
+        return graph.get(vertex).get(k).getId();
+    }
+
+    // a column taken before more vertices are put is not extended; take it again.
+    @Override
+    public @NotNull double[] getColumn(@NotNull EdgeAttribute attribute) {
+        return columns.get(attribute, edges.size());
+    }
+
     public List<List<Vertex>> getGraph() {
         return graph;
     }
 
-    public String getName() {
+    @Override
+    public @NotNull String getName() {
         return name;
     }
 }
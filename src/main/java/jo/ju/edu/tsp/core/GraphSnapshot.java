@@ -0,0 +1,111 @@
+package jo.ju.edu.tsp.core;
+
+import org.jetbrains.annotations.NotNull;
+import org.jetbrains.annotations.Nullable;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+import java.nio.file.AtomicMoveNotSupportedException;
+import java.nio.file.Files;
+import java.nio.file.StandardCopyOption;
+
+// The binary snapshot (.tspb, see BinaryInstanceHeader) of the graph parsed from a source file, kept in a cache
+// directory so that the next JVM maps the matrix (see MappedGraph) instead of parsing the file. The snapshot is named
+// after the file and the XXH64 hash of its content (rl5934.xml-1f0e...-9a3c....tspb): a changed file has another hash,
+// so it is parsed and snapshotted again, and the snapshots of its former contents are deleted. The snapshot is written
+// to a temporary file and renamed, so a JVM never maps a partial one.
+public final class GraphSnapshot {
+    private static final String EXTENSION = ".tspb";
+    private static final int BUFFER_SIZE = 1 << 20;
+
+    private final File directory;
+    // the name of the source file and the hash of its path.
+    private final String prefix;
+    private final File file;
+
+    private GraphSnapshot(@NotNull File directory, @NotNull String prefix, long hash) {
+        this.directory = directory;
+        this.prefix = prefix;
+        this.file = new File(directory, prefix + String.format("%016x", hash) + EXTENSION);
+    }
+
+    // hashes the content of the source file.
+    public static @NotNull GraphSnapshot of(@NotNull File directory, @NotNull File source) throws IOException {
+        String prefix = source.getName() + '-' + String.format("%08x", source.getCanonicalPath().hashCode()) + '-';
+        return new GraphSnapshot(directory, prefix, XXHash64.of(source));
+    }
+
+    public @NotNull File getFile() {
+        return file;
+    }
+
+    // the mapped snapshot of a graph of numberOfVertices vertices, or null if there is none.
+    public @Nullable MappedGraph open(@NotNull String name, int numberOfVertices) {
+        if(!file.isFile()) return null;
+        try {
+            MappedGraph graph = MappedGraph.open(file, name);
+            if(graph.getNumberOfVertices() == numberOfVertices) return graph;
+        } catch (IOException ex) {
+            // a broken snapshot is written again.
+        }
+        return null;
+    }
+
+    // writes the costs of a complete graph (the lower triangle if it is symmetric, the full matrix otherwise); a graph
+    // whose matrix cannot be mapped is not written.
+    public void write(@NotNull WeightedGraph graph) throws IOException {
+        int n = graph.getNumberOfVertices();
+        boolean symmetric = graph.isSymmetric();
+        BinaryInstanceHeader header = new BinaryInstanceHeader(symmetric ? BinaryInstanceHeader.KIND_LOWER_MATRIX
+                : BinaryInstanceHeader.KIND_FULL_MATRIX, 0, n);
+        if(header.getPayloadSize() > Integer.MAX_VALUE) return;
+        if(!directory.isDirectory() && !directory.mkdirs()) throw new IOException("Cannot create " + directory);
+
+        File temporary = File.createTempFile(prefix, ".tmp", directory);
+        try {
+            try(RandomAccessFile raf = new RandomAccessFile(temporary, "rw"); FileChannel channel = raf.getChannel()) {
+                header.write(channel);
+                channel.position(BinaryInstanceHeader.SIZE);
+                ByteBuffer buffer = ByteBuffer.allocateDirect(BUFFER_SIZE).order(ByteOrder.LITTLE_ENDIAN);
+                for(int i = 0; i < n; i++) {
+                    for(int j = 0, end = symmetric ? i : n; j < end; j++) {
+                        if(!buffer.hasRemaining()) flush(buffer, channel);
+                        buffer.putDouble(i == j ? 0 : graph.getCost(i, j));
+                    }
+                }
+                flush(buffer, channel);
+            }
+            try {
+                Files.move(temporary.toPath(), file.toPath(), StandardCopyOption.ATOMIC_MOVE);
+            } catch (AtomicMoveNotSupportedException ex) {
+                Files.move(temporary.toPath(), file.toPath(), StandardCopyOption.REPLACE_EXISTING);
+            }
+        } finally {
+            Files.deleteIfExists(temporary.toPath());
+        }
+        deleteFormerSnapshots();
+    }
+
+    private static void flush(@NotNull ByteBuffer buffer, @NotNull FileChannel channel) throws IOException {
+        buffer.flip();
+        while(buffer.hasRemaining()) {
+            channel.write(buffer);
+        }
+        buffer.clear();
+    }
+
+    private void deleteFormerSnapshots() {
+        File[] snapshots = directory.listFiles((dir, name) -> name.startsWith(prefix) && name.endsWith(EXTENSION));
+        if(snapshots == null) return;
+        for(File snapshot : snapshots) {
+            if(!snapshot.getName().equals(file.getName())) {
+                // a snapshot mapped by another JVM stays readable until it is unmapped (on POSIX systems).
+                snapshot.delete();
+            }
+        }
+    }
+}
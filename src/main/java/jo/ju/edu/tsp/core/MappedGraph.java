@@ -0,0 +1,124 @@
+package jo.ju.edu.tsp.core;
+
+import jo.ju.edu.tsp.core.kernels.CostBuffer;
+import jo.ju.edu.tsp.core.kernels.Metric;
+import org.jetbrains.annotations.NotNull;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.ByteOrder;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+
+// A read-only view of a binary instance (.tspb, written by TransformTSPLIB --emit or GenerateTSPLIB, see
+// BinaryInstanceFormat.hpp). The matrix of the file is memory-mapped and read in place, so opening an instance takes no
+// time and all JVMs on a machine share the pages of the file; coordinates are copied (2n doubles) and the costs are
+// computed on demand with the rules of TransformTSPLIB: exact for EUC_2D and CEIL_2D, rounded for ATT and GEO (see
+// Metric.isAlwaysRounded). The edge ids are those of PackedGraph; the columns of the edge attributes are the only
+// arrays on the heap.
+public class MappedGraph implements WeightedGraph {
+    private final String name;
+    private final int numberOfVertices;
+    private final boolean symmetric;
+    private final int numberOfEdges;
+    private final CostBuffer costs;
+    private final EdgeColumns columns = new EdgeColumns();
+
+    private MappedGraph(@NotNull String name, boolean symmetric, @NotNull CostBuffer costs) {
+        this.name = name;
+        this.numberOfVertices = costs.getNumberOfVertices();
+        this.symmetric = symmetric;
+        this.numberOfEdges = symmetric ? numberOfVertices * (numberOfVertices - 1) / 2 : numberOfVertices * numberOfVertices;
+        this.costs = costs;
+    }
+
+    public static @NotNull MappedGraph open(@NotNull File file, @NotNull String name) throws IOException {
+        try(RandomAccessFile raf = new RandomAccessFile(file, "r"); FileChannel channel = raf.getChannel()) {
+            BinaryInstanceHeader header = BinaryInstanceHeader.read(channel, file);
+            long n = header.numberOfVertices, values = header.getNumberOfValues();
+            if(n * n > Integer.MAX_VALUE) throw new IOException(file + " has more than 46340 vertices");
+            if(header.getPayloadSize() > Integer.MAX_VALUE) throw new IOException(file + " is too large to be mapped");
+            // the mapping stays valid after the channel is closed.
+            MappedByteBuffer payload = channel.map(FileChannel.MapMode.READ_ONLY, BinaryInstanceHeader.SIZE, header.getPayloadSize());
+            payload.order(ByteOrder.LITTLE_ENDIAN);
+
+            if(header.kind == BinaryInstanceHeader.KIND_COORDINATES) {
+                double[] x = new double[(int) n], y = new double[(int) n];
+                for(int i = 0; i < n; i++) {
+                    x[i] = payload.getDouble(16 * i);
+                    y[i] = payload.getDouble(16 * i + 8);
+                }
+                Metric metric = header.getMetric();
+                return new MappedGraph(name, true, CostBuffer.ofCoordinates(x, y, metric, metric.isAlwaysRounded()));
+            }
+
+            boolean lower = header.kind == BinaryInstanceHeader.KIND_LOWER_MATRIX;
+            if(ByteOrder.nativeOrder() != ByteOrder.LITTLE_ENDIAN) {
+                // the buffers of CostBuffer are read in the native order.
+                double[] matrix = new double[(int) values];
+                payload.asDoubleBuffer().get(matrix);
+                return new MappedGraph(name, lower, CostBuffer.ofMatrix(matrix, (int) n, lower));
+            }
+            return new MappedGraph(name, lower, CostBuffer.ofMatrix(payload, (int) n, lower));
+        }
+    }
+
+    // the native TourKernels read a mapped matrix in place, too.
+    @Override
+    public @NotNull CostBuffer getCostBuffer() {
+        return costs;
+    }
+
+    @Override
+    public @NotNull String getName() {
+        return name;
+    }
+
+    @Override
+    public int getNumberOfVertices() {
+        return numberOfVertices;
+    }
+
+    @Override
+    public boolean isSymmetric() {
+        return symmetric;
+    }
+
+    @Override
+    public int getNumberOfEdges() {
+        return numberOfEdges;
+    }
+
+    @Override
+    public int getEdgeId(int from, int to) {
+        if(!symmetric) return from * numberOfVertices + to;
+        return PackedGraph.getLowerEdgeId(from, to);
+    }
+
+    @Override
+    public double getCost(int from, int to) {
+        return costs.getCost(from, to);
+    }
+
+    @Override
+    public double getCostConcurrently(int from, int to) {
+        return costs.getCost(from, to);
+    }
+
+    @Override
+    public int getDegree(int vertex) {
+        return numberOfVertices - 1;
+    }
+
+    // all other vertices in increasing order.
+    @Override
+    public int getNeighbour(int vertex, int k) {
+        return k < vertex ? k : k + 1;
+    }
+
+    @Override
+    public @NotNull double[] getColumn(@NotNull EdgeAttribute attribute) {
+        return columns.get(attribute, numberOfEdges);
+    }
+}
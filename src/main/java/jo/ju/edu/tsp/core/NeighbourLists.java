@@ -0,0 +1,232 @@
+package jo.ju.edu.tsp.core;
+
+import org.jetbrains.annotations.NotNull;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.util.function.IntPredicate;
+import java.util.stream.IntStream;
+
+// The k nearest adjacent vertices of every vertex, sorted by increasing cost, so that a solver asking for the closest
+// unvisited vertices walks a short list instead of sorting or scanning the adjacency list. The lists are built once per
+// graph by the common ForkJoinPool (a vertex per task, see WeightedGraph.getCostConcurrently), those of a PagedGraph by
+// one thread in the order of the rows, and, for a complete graph read from a file, kept next to the file
+// (NAME.xml.knn); they belong to the file of the recorded length and modification time and are rebuilt otherwise.
+public final class NeighbourLists {
+    private static final String EXTENSION = ".knn";
+    private static final int MAGIC = 0x4b4e4e4c; // "KNNL"
+
+    private final WeightedGraph graph;
+    private final int k;
+    // the list of v is targets[offsets[v]] ... targets[offsets[v + 1] - 1].
+    final int[] offsets;
+    final int[] targets;
+    final double[] costs;
+
+    private NeighbourLists(@NotNull WeightedGraph graph, int k, @NotNull int[] offsets, @NotNull int[] targets, @NotNull double[] costs) {
+        this.graph = graph;
+        this.k = k;
+        this.offsets = offsets;
+        this.targets = targets;
+        this.costs = costs;
+    }
+
+    public static @NotNull NeighbourLists build(@NotNull WeightedGraph graph, int k) {
+        int n = graph.getNumberOfVertices();
+        k = Math.max(0, k);
+        if((long) n * Math.min(k, Math.max(0, n - 1)) > Integer.MAX_VALUE) {
+            throw new IllegalArgumentException(n + " lists of " + k + " neighbours do not fit into an array; choose a smaller k");
+        }
+        final int[] offsets = new int[n + 1];
+        for(int v = 0; v < n; v++) {
+            offsets[v + 1] = offsets[v] + Math.min(k, graph.getDegree(v));
+        }
+        final int[] targets = new int[offsets[n]];
+        final double[] costs = new double[offsets[n]];
+        // a PagedGraph holds one current page: walking its rows in order reads every page once, tasks on other rows
+        // would read the pages again and again.
+        IntStream vertices = IntStream.range(0, n);
+        if(!(graph instanceof PagedGraph)) vertices = vertices.parallel();
+        vertices.forEach(v -> select(graph, v, targets, costs, offsets[v], offsets[v + 1]));
+        return new NeighbourLists(graph, k, offsets, targets, costs);
+    }
+
+    // the lists kept next to the instance file, or built and kept there if the graph is complete.
+    public static @NotNull NeighbourLists of(@NotNull WeightedGraph graph, int k, @NotNull File instance) {
+        k = Math.max(0, k);
+        if(!isComplete(graph)) return build(graph, k);
+        File listsFile = new File(instance.getPath() + EXTENSION);
+        try {
+            NeighbourLists lists = read(listsFile, instance, graph, k);
+            if(lists != null) return lists;
+        } catch (IOException ex) {
+            // a broken file is rebuilt.
+        }
+        NeighbourLists lists = build(graph, k);
+        try {
+            lists.write(listsFile, instance);
+        } catch (IOException ex) {
+            // the file only saves the build of the next run.
+        }
+        return lists;
+    }
+
+    // the k cheapest adjacent vertices of v, sorted by cost, into targets and costs[start, end).
+    private static void select(@NotNull WeightedGraph graph, int v, @NotNull int[] targets, @NotNull double[] costs, int start, int end) {
+        if(start == end) return;
+        int count = 0, length = end - start, last = end - 1;
+        for(int l = 0; l < graph.getDegree(v); l++) {
+            int u = graph.getNeighbour(v, l);
+            double cost = graph.getCostConcurrently(v, u);
+            if(count == length && cost >= costs[last]) continue;
+            int p = count < length ? start + count++ : last;
+            for(; p > start && costs[p - 1] > cost; p--) {
+                targets[p] = targets[p - 1];
+                costs[p] = costs[p - 1];
+            }
+            targets[p] = u;
+            costs[p] = cost;
+        }
+    }
+
+    // the lists of a complete graph depend on the costs only.
+    private static boolean isComplete(@NotNull WeightedGraph graph) {
+        for(int v = 0; v < graph.getNumberOfVertices(); v++) {
+            if(graph.getDegree(v) != graph.getNumberOfVertices() - 1) return false;
+        }
+        return true;
+    }
+
+    private static NeighbourLists read(@NotNull File listsFile, @NotNull File instance, @NotNull WeightedGraph graph, int k) throws IOException {
+        if(!listsFile.isFile()) return null;
+        try(DataInputStream in = new DataInputStream(new BufferedInputStream(new FileInputStream(listsFile), 1 << 16))) {
+            if(in.readInt() != MAGIC || in.readLong() != instance.length() || in.readLong() != instance.lastModified()
+                    || in.readInt() != graph.getNumberOfVertices() || in.readInt() != k) {
+                return null;
+            }
+            int n = graph.getNumberOfVertices(), length = Math.min(k, Math.max(0, n - 1));
+            // build rejects lists that do not fit into an array.
+            if((long) n * length > Integer.MAX_VALUE) return null;
+            int[] offsets = new int[n + 1], targets = new int[n * length];
+            double[] costs = new double[n * length];
+            for(int v = 0; v < n; v++) {
+                offsets[v + 1] = offsets[v] + length;
+            }
+            for(int p = 0; p < targets.length; p++) {
+                targets[p] = in.readInt();
+                costs[p] = in.readDouble();
+                if(targets[p] < 0 || targets[p] >= n) throw new IOException(listsFile + " is broken");
+            }
+            return new NeighbourLists(graph, k, offsets, targets, costs);
+        }
+    }
+
+    private void write(@NotNull File listsFile, @NotNull File instance) throws IOException {
+        try(DataOutputStream out = new DataOutputStream(new BufferedOutputStream(new FileOutputStream(listsFile), 1 << 16))) {
+            out.writeInt(MAGIC);
+            out.writeLong(instance.length());
+            out.writeLong(instance.lastModified());
+            out.writeInt(graph.getNumberOfVertices());
+            out.writeInt(k);
+            for(int p = 0; p < targets.length; p++) {
+                out.writeInt(targets[p]);
+                out.writeDouble(costs[p]);
+            }
+        }
+    }
+
+    public @NotNull WeightedGraph getGraph() {
+        return graph;
+    }
+
+    public int getK() {
+        return k;
+    }
+
+    public int getLength(int vertex) {
+        return offsets[vertex + 1] - offsets[vertex];
+    }
+
+    // the i-th nearest adjacent vertex, i < getLength(vertex).
+    public int getNeighbour(int vertex, int i) {
+        return targets[offsets[vertex] + i];
+    }
+
+    public double getCost(int vertex, int i) {
+        return costs[offsets[vertex] + i];
+    }
+
+    // The lists in the layout of the tour kernels (see TourKernels.findTwoOptMove): getWidth() vertices per vertex, a
+    // shorter list is filled up with its last vertex, which gives no further move, an empty one with the next vertex.
+    public @NotNull int[] toKernelLists() {
+        int n = graph.getNumberOfVertices(), width = getWidth();
+        int[] lists = new int[n * width];
+        for(int v = 0; v < n; v++) {
+            int length = getLength(v);
+            for(int i = 0; i < width; i++) {
+                lists[v * width + i] = length == 0 ? (v + 1) % n : getNeighbour(v, Math.min(i, length - 1));
+            }
+        }
+        return lists;
+    }
+
+    // the length of the longest list.
+    public int getWidth() {
+        int width = 0;
+        for(int v = 0; v < graph.getNumberOfVertices(); v++) {
+            width = Math.max(width, getLength(v));
+        }
+        return width;
+    }
+
+    // the nearest adjacent vertex that is not excluded, or the fallback of the graph (see getFallbackNeighbour), or -1.
+    public int getNearest(int vertex, @NotNull IntPredicate excluded) {
+        int[] nearest = new int[1];
+        return getNearest(vertex, excluded, nearest) == 0 ? -1 : nearest[0];
+    }
+
+    // The nearest adjacent vertices that are not excluded in increasing order of the costs, up to nearest.length of them;
+    // returns their number. Beyond the list, each further vertex takes a scan of the adjacency list; if there is none
+    // at all, the fallback of the graph is taken.
+    public int getNearest(int vertex, @NotNull IntPredicate excluded, @NotNull int[] nearest) {
+        int count = 0;
+        for(int p = offsets[vertex]; p < offsets[vertex + 1] && count < nearest.length; p++) {
+            if(!excluded.test(targets[p])) nearest[count++] = targets[p];
+        }
+        if(count < nearest.length && getLength(vertex) < graph.getDegree(vertex)) {
+            while(count < nearest.length) {
+                int next = -1;
+                double nextCost = Double.POSITIVE_INFINITY;
+                for(int l = 0; l < graph.getDegree(vertex); l++) {
+                    int u = graph.getNeighbour(vertex, l);
+                    if(excluded.test(u) || contains(nearest, count, u)) continue;
+                    double cost = graph.getCost(vertex, u);
+                    if(next == -1 || cost < nextCost) {
+                        next = u;
+                        nextCost = cost;
+                    }
+                }
+                if(next == -1) break;
+                nearest[count++] = next;
+            }
+        }
+        if(count == 0 && nearest.length > 0) {
+            int fallback = graph.getFallbackNeighbour(vertex, excluded);
+            if(fallback != -1) nearest[count++] = fallback;
+        }
+        return count;
+    }
+
+    private static boolean contains(@NotNull int[] vertices, int count, int vertex) {
+        for(int i = 0; i < count; i++) {
+            if(vertices[i] == vertex) return true;
+        }
+        return false;
+    }
+}
@@ -0,0 +1,95 @@
+package jo.ju.edu.tsp.core;
+
+import jo.ju.edu.tsp.core.kernels.CostBuffer;
+import org.jetbrains.annotations.NotNull;
+import org.jetbrains.annotations.Nullable;
+
+import java.util.function.IntPredicate;
+
+// A view of a shared graph (see GraphCache) with edge attributes of its own: the costs and the adjacency lists are read
+// from the shared graph, while the columns (soil, depth, ...) belong to the view. So every run of a solver gets a fresh
+// state, allocated when first asked for, and the shared graph is never written.
+public class OverlayGraph implements WeightedGraph {
+    private final WeightedGraph shared;
+    private final EdgeColumns columns = new EdgeColumns();
+
+    public OverlayGraph(@NotNull WeightedGraph shared) {
+        this.shared = getShared(shared);
+    }
+
+    // the graph a view reads its costs from, or the graph itself.
+    public static @NotNull WeightedGraph getShared(@NotNull WeightedGraph graph) {
+        return graph instanceof OverlayGraph ? ((OverlayGraph) graph).shared : graph;
+    }
+
+    @Override
+    public @NotNull String getName() {
+        return shared.getName();
+    }
+
+    @Override
+    public int getNumberOfVertices() {
+        return shared.getNumberOfVertices();
+    }
+
+    @Override
+    public boolean isSymmetric() {
+        return shared.isSymmetric();
+    }
+
+    @Override
+    public int getNumberOfEdges() {
+        return shared.getNumberOfEdges();
+    }
+
+    @Override
+    public int getEdgeId(int from, int to) {
+        return shared.getEdgeId(from, to);
+    }
+
+    @Override
+    public double getCost(int from, int to) {
+        return shared.getCost(from, to);
+    }
+
+    @Override
+    public double getCostConcurrently(int from, int to) {
+        return shared.getCostConcurrently(from, to);
+    }
+
+    @Override
+    public @Nullable CostBuffer getCostBuffer() {
+        return shared.getCostBuffer();
+    }
+
+    @Override
+    public int getDegree(int vertex) {
+        return shared.getDegree(vertex);
+    }
+
+    @Override
+    public int getNeighbour(int vertex, int k) {
+        return shared.getNeighbour(vertex, k);
+    }
+
+    @Override
+    public int getFallbackNeighbour(int vertex, @NotNull IntPredicate excluded) {
+        return shared.getFallbackNeighbour(vertex, excluded);
+    }
+
+    @Override
+    public @NotNull double[] getColumn(@NotNull EdgeAttribute attribute) {
+        return columns.get(attribute, getNumberOfEdges());
+    }
+
+    // the shared graph decides which entries are written (see CandidateGraph).
+    @Override
+    public void set(@NotNull double[] column, int from, int to, double value) {
+        shared.set(column, from, to, value);
+    }
+
+    @Override
+    public void setDirected(@NotNull double[] column, int from, int to, double value) {
+        shared.setDirected(column, from, to, value);
+    }
+}
@@ -0,0 +1,125 @@
+package jo.ju.edu.tsp.core;
+
+import org.jetbrains.annotations.NotNull;
+
+// A complete graph in primitive arrays: the costs of a symmetric graph are the strictly lower triangle of the matrix
+// (the edge {i, j}, j < i, has the id i * (i - 1) / 2 + j), the costs of an asymmetric graph are the full matrix (the
+// edge (i, j) has the id i * n + j). The costs are kept as doubles, or as floats to halve the memory; the edge
+// attributes are parallel arrays indexed by the edge id. No object is allocated per edge.
+public class PackedGraph implements WeightedGraph {
+    private final String name;
+    private final int numberOfVertices;
+    private final boolean symmetric;
+    private final int numberOfEdges;
+    private final double[] costs;
+    private final float[] floatCosts;
+    private final EdgeColumns columns = new EdgeColumns();
+
+    public PackedGraph(@NotNull String name, int numberOfVertices, boolean symmetric, boolean singlePrecision) {
+        long edges = symmetric ? (long) numberOfVertices * (numberOfVertices - 1) / 2 : (long) numberOfVertices * numberOfVertices;
+        if(numberOfVertices < 0 || edges > Integer.MAX_VALUE) {
+            throw new IllegalArgumentException("A packed graph cannot hold " + numberOfVertices + " vertices");
+        }
+        this.name = name;
+        this.numberOfVertices = numberOfVertices;
+        this.symmetric = symmetric;
+        this.numberOfEdges = (int) Math.max(0, edges);
+        this.costs = singlePrecision ? null : new double[numberOfEdges];
+        this.floatCosts = singlePrecision ? new float[numberOfEdges] : null;
+    }
+
+    public PackedGraph(@NotNull String name, int numberOfVertices, boolean symmetric) {
+        this(name, numberOfVertices, symmetric, false);
+    }
+
+    // the strictly lower triangle of a symmetric matrix in the layout above (e.g. NativeTSPLIB.getLowerCosts()).
+    public static @NotNull PackedGraph ofLowerCosts(@NotNull String name, int numberOfVertices, @NotNull double[] lowerCosts) {
+        PackedGraph graph = new PackedGraph(name, numberOfVertices, true);
+        System.arraycopy(lowerCosts, 0, graph.costs, 0, graph.numberOfEdges);
+        return graph;
+    }
+
+    // packs a graph of adjacency lists; it is symmetric if the vertex 0 has no loop (as written by TransformTSPLIB).
+    public static @NotNull PackedGraph of(@NotNull Graph graph) {
+        int n = graph.getNumberOfVertices();
+        boolean symmetric = n == 0 || graph.getVertex(0, 0) == null;
+        PackedGraph packedGraph = new PackedGraph(graph.getName(), n, symmetric);
+        for(int i = 0; i < n; i++) {
+            for(Vertex vertex : graph.adjacentOf(i)) {
+                int j = vertex.getId();
+                if(!symmetric || j < i) {
+                    packedGraph.setCost(i, j, vertex.getCost());
+                }
+            }
+        }
+        return packedGraph;
+    }
+
+    public void setCost(int from, int to, double cost) {
+        int edge = getEdgeId(from, to);
+        if(costs != null) {
+            costs[edge] = cost;
+        } else {
+            floatCosts[edge] = (float) cost;
+        }
+    }
+
+    @Override
+    public @NotNull String getName() {
+        return name;
+    }
+
+    @Override
+    public int getNumberOfVertices() {
+        return numberOfVertices;
+    }
+
+    @Override
+    public boolean isSymmetric() {
+        return symmetric;
+    }
+
+    @Override
+    public int getNumberOfEdges() {
+        return numberOfEdges;
+    }
+
+    @Override
+    public int getEdgeId(int from, int to) {
+        if(!symmetric) return from * numberOfVertices + to;
+        return getLowerEdgeId(from, to);
+    }
+
+    // the id of the edge {from, to} in the strictly lower triangle; i * (i - 1) overflows an int from i = 46342 on, so it
+    // is computed in long (the id itself fits as long as the graph has at most Integer.MAX_VALUE edges).
+    public static int getLowerEdgeId(int from, int to) {
+        return (int) (from > to ? (long) from * (from - 1) / 2 + to : (long) to * (to - 1) / 2 + from);
+    }
+
+    @Override
+    public double getCost(int from, int to) {
+        int edge = getEdgeId(from, to);
+        return costs != null ? costs[edge] : floatCosts[edge];
+    }
+
+    @Override
+    public double getCostConcurrently(int from, int to) {
+        return getCost(from, to);
+    }
+
+    @Override
+    public int getDegree(int vertex) {
+        return numberOfVertices - 1;
+    }
+
+    // all other vertices in increasing order.
+    @Override
+    public int getNeighbour(int vertex, int k) {
+        return k < vertex ? k : k + 1;
+    }
+
+    @Override
+    public @NotNull double[] getColumn(@NotNull EdgeAttribute attribute) {
+        return columns.get(attribute, numberOfEdges);
+    }
+}
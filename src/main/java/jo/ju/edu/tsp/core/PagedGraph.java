@@ -0,0 +1,203 @@
+package jo.ju.edu.tsp.core;
+
+import org.jetbrains.annotations.NotNull;
+
+import java.io.Closeable;
+import java.io.IOException;
+import java.io.UncheckedIOException;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.FutureTask;
+
+// A graph whose rows of costs are read on demand, in pages of consecutive rows, from a file that does not fit on the
+// heap (see Transformer.openPagedGraph). At most residentPages pages are kept, the least recently used one is dropped;
+// when the solver enters a page, the next prefetchPages pages are read by a background thread. So only the rows the
+// solver visits are read. The page of the current row is remembered, so a solver reading the costs of the current
+// vertex touches the page table once per page change. Every row holds the costs to all n vertices, also of a symmetric
+// graph, so the cost of (from, to) is always in the row of from and a solver walking the row of its current vertex
+// stays in one page. The solver may use the graph from one thread only; close() stops the background thread.
+//
+// The edge attributes are not paged: a column would take a double per edge on the heap, which a graph too large for the
+// heap does not have, so getColumn fails. Restrict the solvers to candidate edges instead, whose columns hold one
+// entry per candidate edge: CandidateGraph.ofNearestNeighbours(pagedGraph, k) reads every page once, as NeighbourLists
+// walks the rows of a paged graph in order from one thread.
+public class PagedGraph implements WeightedGraph, AutoCloseable {
+    // reads rows of costs from a file.
+    public interface PageSource extends Closeable {
+        int getNumberOfVertices();
+
+        boolean isSymmetric();
+
+        // reads the rows first ... first + rows.length - 1, each the costs to all n vertices (0 for the loop), into the
+        // arrays of length n.
+        void readRows(int first, @NotNull double[][] rows) throws IOException;
+    }
+
+    private final String name;
+    private final PageSource source;
+    private final int numberOfVertices;
+    private final int rowsPerPage;
+    private final int prefetchPages;
+    private final Map<Integer, FutureTask<double[][]>> pages;
+    private final ExecutorService prefetcher;
+    private int currentPageIndex = -1;
+    private double[][] currentPage;
+    private long pageReads = 0;
+
+    public PagedGraph(@NotNull String name, @NotNull PageSource source, int rowsPerPage, final int residentPages, int prefetchPages) {
+        if(rowsPerPage < 1 || residentPages < 1 + prefetchPages || prefetchPages < 0) {
+            throw new IllegalArgumentException("The resident pages have to hold a page and the prefetched pages");
+        }
+        this.name = name;
+        this.source = source;
+        this.numberOfVertices = source.getNumberOfVertices();
+        this.rowsPerPage = rowsPerPage;
+        this.prefetchPages = prefetchPages;
+        this.pages = new LinkedHashMap<Integer, FutureTask<double[][]>>(16, 0.75f, true) {
+            @Override
+            protected boolean removeEldestEntry(Map.Entry<Integer, FutureTask<double[][]>> eldest) {
+                return size() > residentPages;
+            }
+        };
+        this.prefetcher = prefetchPages == 0 ? null : Executors.newSingleThreadExecutor(runnable -> {
+            Thread thread = new Thread(runnable, "PagedGraph-prefetch");
+            thread.setDaemon(true);
+            return thread;
+        });
+    }
+
+    public PagedGraph(@NotNull String name, @NotNull PageSource source) {
+        this(name, source, 256, 16, 2);
+    }
+
+    @Override
+    public double getCost(int from, int to) {
+        return getRow(from)[to];
+    }
+
+    private @NotNull double[] getRow(int row) {
+        int pageIndex = row / rowsPerPage;
+        if(pageIndex != currentPageIndex) {
+            currentPage = getPage(pageIndex);
+            currentPageIndex = pageIndex;
+            for(int next = pageIndex + 1; next <= pageIndex + prefetchPages && next * rowsPerPage < numberOfVertices; next++) {
+                prefetch(next);
+            }
+        }
+        return currentPage[row - pageIndex * rowsPerPage];
+    }
+
+    private @NotNull double[][] getPage(int pageIndex) {
+        FutureTask<double[][]> task;
+        boolean load = false;
+        synchronized (pages) {
+            task = pages.get(pageIndex);
+            if(task == null) {
+                task = newTask(pageIndex);
+                pages.put(pageIndex, task);
+                load = true;
+            }
+        }
+        if(load) task.run();
+        try {
+            return task.get();
+        } catch (InterruptedException ex) {
+            Thread.currentThread().interrupt();
+            throw new IllegalStateException("Interrupted while reading the page " + pageIndex, ex);
+        } catch (ExecutionException ex) {
+            synchronized (pages) {
+                pages.remove(pageIndex);
+            }
+            if(ex.getCause() instanceof IOException) throw new UncheckedIOException((IOException) ex.getCause());
+            throw new IllegalStateException(ex.getCause());
+        }
+    }
+
+    private void prefetch(int pageIndex) {
+        FutureTask<double[][]> task;
+        synchronized (pages) {
+            if(pages.containsKey(pageIndex)) return;
+            task = newTask(pageIndex);
+            pages.put(pageIndex, task);
+        }
+        prefetcher.execute(task);
+    }
+
+    private @NotNull FutureTask<double[][]> newTask(final int pageIndex) {
+        return new FutureTask<double[][]>(() -> {
+            int first = pageIndex * rowsPerPage;
+            double[][] page = new double[Math.min(rowsPerPage, numberOfVertices - first)][];
+            for(int i = 0; i < page.length; i++) {
+                page[i] = new double[numberOfVertices];
+            }
+            // the source is read by one thread at a time.
+            synchronized (source) {
+                source.readRows(first, page);
+                pageReads++;
+            }
+            return page;
+        });
+    }
+
+    // the number of pages read from the file.
+    public long getPageReads() {
+        synchronized (source) {
+            return pageReads;
+        }
+    }
+
+    @Override
+    public void close() throws IOException {
+        if(prefetcher != null) prefetcher.shutdownNow();
+        source.close();
+    }
+
+    @Override
+    public @NotNull String getName() {
+        return name;
+    }
+
+    @Override
+    public int getNumberOfVertices() {
+        return numberOfVertices;
+    }
+
+    @Override
+    public boolean isSymmetric() {
+        return source.isSymmetric();
+    }
+
+    @Override
+    public int getNumberOfEdges() {
+        long n = numberOfVertices, edges = isSymmetric() ? n * (n - 1) / 2 : n * n;
+        if(edges > Integer.MAX_VALUE) throw new IllegalStateException("The edges of " + n + " vertices have no int ids");
+        return (int) edges;
+    }
+
+    @Override
+    public int getEdgeId(int from, int to) {
+        if(!isSymmetric()) return from * numberOfVertices + to;
+        return PackedGraph.getLowerEdgeId(from, to);
+    }
+
+    @Override
+    public int getDegree(int vertex) {
+        return numberOfVertices - 1;
+    }
+
+    // all other vertices in increasing order.
+    @Override
+    public int getNeighbour(int vertex, int k) {
+        return k < vertex ? k : k + 1;
+    }
+
+    // the columns are not paged (see above).
+    @Override
+    public @NotNull double[] getColumn(@NotNull EdgeAttribute attribute) {
+        throw new UnsupportedOperationException("The edge attributes of the paged graph " + name
+                + " would take a double per edge on the heap; wrap it in a CandidateGraph");
+    }
+}
@@ -0,0 +1,108 @@
+package jo.ju.edu.tsp.core;
+
+import org.jetbrains.annotations.NotNull;
+import org.jetbrains.annotations.Nullable;
+
+import java.util.Arrays;
+
+// A bounded cache of rows of costs computed on demand (see CoordinateGraph). The rows of n doubles fill a budget given
+// in MB; when it is full, a row is evicted by the CLOCK algorithm (a second chance for the rows read since the hand last
+// passed them), which approximates LRU without reordering on every hit. Not thread-safe.
+public class RowCache {
+    // computes the costs of the edges leaving a vertex.
+    public interface RowSource {
+        void computeRow(int vertex, @NotNull double[] row);
+    }
+
+    private final RowSource source;
+    private final int rowLength;
+    private final double[][] rows;
+    private final int[] vertexOfSlot;
+    private final boolean[] referenced;
+    private final int[] slotOfVertex;
+    private int usedSlots = 0, hand = 0;
+    private long hits = 0, misses = 0;
+
+    public RowCache(@NotNull RowSource source, int numberOfVertices, int megabytes) {
+        long rowBytes = Math.max(1, (long) numberOfVertices * Double.BYTES);
+        int capacity = (int) Math.max(1, Math.min(numberOfVertices, ((long) megabytes << 20) / rowBytes));
+        this.source = source;
+        this.rowLength = numberOfVertices;
+        this.rows = new double[capacity][];
+        this.vertexOfSlot = new int[capacity];
+        this.referenced = new boolean[capacity];
+        this.slotOfVertex = new int[numberOfVertices];
+        Arrays.fill(slotOfVertex, -1);
+    }
+
+    // the row if it is cached (a hit), otherwise null; nothing is computed.
+    public @Nullable double[] peek(int vertex) {
+        int slot = slotOfVertex[vertex];
+        if(slot < 0) return null;
+        referenced[slot] = true;
+        hits++;
+        return rows[slot];
+    }
+
+    // the row of the vertex, computed on a miss; the array is reused once the row is evicted.
+    public @NotNull double[] getRow(int vertex) {
+        double[] row = peek(vertex);
+        if(row != null) return row;
+
+        misses++;
+        int slot = usedSlots < rows.length ? usedSlots++ : evict();
+        if(rows[slot] == null) rows[slot] = new double[rowLength];
+        source.computeRow(vertex, rows[slot]);
+        vertexOfSlot[slot] = vertex;
+        referenced[slot] = true;
+        slotOfVertex[vertex] = slot;
+        return rows[slot];
+    }
+
+    // a miss served without a row (the cost alone was computed).
+    public void countMiss() {
+        misses++;
+    }
+
+    private int evict() {
+        while(referenced[hand]) {
+            referenced[hand] = false;
+            hand = (hand + 1) % rows.length;
+        }
+        int slot = hand;
+        slotOfVertex[vertexOfSlot[slot]] = -1;
+        hand = (hand + 1) % rows.length;
+        return slot;
+    }
+
+    public void clear() {
+        Arrays.fill(slotOfVertex, -1);
+        Arrays.fill(referenced, false);
+        usedSlots = 0;
+        hand = 0;
+        hits = 0;
+        misses = 0;
+    }
+
+    // the maximal number of rows.
+    public int getCapacity() {
+        return rows.length;
+    }
+
+    public long getHits() {
+        return hits;
+    }
+
+    public long getMisses() {
+        return misses;
+    }
+
+    public double getHitRatio() {
+        return hits + misses == 0 ? 0 : (double) hits / (hits + misses);
+    }
+
+    @Override
+    public String toString() {
+        return "RowCache{" + rows.length + " rows, hits=" + hits + ", misses=" + misses + "}";
+    }
+}
@@ -10,7 +10,6 @@ public class Vertex implements Comparable<Vertex> {
     private HashMap<String, Double> characteristics;
 
     public Vertex() {
-        characteristics = new HashMap<String, Double>();
     }
 
     public Vertex(int id, double cost) {
@@ -36,17 +35,21 @@ public class Vertex implements Comparable<Vertex> {
 
     /*
     * Usually there is a need to have extra characteristics on the edges (which is represented as vertex in the current
-    * implementation). If the characteristic is in the characteristics, the value will be overridden.
+    * implementation). If the characteristic is in the characteristics, the value will be overridden. The map is only
+    * created for the first characteristic; the algorithms keep their per-edge state in EdgeAttribute columns instead.
     * */
     public void addCharacteristic(@NotNull String name, Double value) {
-        characteristics.put(name, value);
+        getCharacteristics().put(name, value);
     }
 
     public Double getCharacteristic(@NotNull String name) {
-        return characteristics.get(name);
+        return characteristics == null ? null : characteristics.get(name);
     }
 
     public HashMap<String, Double> getCharacteristics() {
+        if(characteristics == null) {
+            characteristics = new HashMap<String, Double>();
+        }
         return characteristics;
     }
 
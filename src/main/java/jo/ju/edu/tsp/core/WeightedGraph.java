@@ -0,0 +1,66 @@
+package jo.ju.edu.tsp.core;
+
+import jo.ju.edu.tsp.core.kernels.CostBuffer;
+import org.jetbrains.annotations.NotNull;
+import org.jetbrains.annotations.Nullable;
+
+import java.util.function.IntPredicate;
+
+// The view of an instance used by the solvers: the costs of the edges addressed by the vertices, integer edge ids, and
+// the per-edge state of the algorithms (e.g. soil and depth) in columns indexed by the edge id.
+public interface WeightedGraph {
+    @NotNull String getName();
+
+    int getNumberOfVertices();
+
+    // the costs of (i, j) and (j, i) are equal; both directions share one edge id.
+    boolean isSymmetric();
+
+    // the edge ids are 0 ... getNumberOfEdges() - 1.
+    int getNumberOfEdges();
+
+    // the id of the edge (from, to), from != to.
+    int getEdgeId(int from, int to);
+
+    // the cost of the edge (from, to), from != to.
+    double getCost(int from, int to);
+
+    // getCost for threads reading the graph at the same time (see NeighbourLists). Graphs whose getCost changes their
+    // state (a cache, the current page) are locked; the others override it with getCost.
+    default double getCostConcurrently(int from, int to) {
+        synchronized (this) {
+            return getCost(from, to);
+        }
+    }
+
+    // the costs in direct buffers, which the native tour kernels read in place (see TourKernels), or null if the costs
+    // are not kept in one (the Java kernels then read getCost).
+    default @Nullable CostBuffer getCostBuffer() {
+        return null;
+    }
+
+    // the adjacent vertices of a vertex are getNeighbour(vertex, 0) ... getNeighbour(vertex, getDegree(vertex) - 1).
+    int getDegree(int vertex);
+
+    int getNeighbour(int vertex, int k);
+
+    // a vertex to go on with when all adjacent vertices of vertex are excluded, or -1. The adjacency lists of a graph
+    // of candidate edges (see CandidateGraph) are short, so it returns the cheapest vertex that is not excluded.
+    default int getFallbackNeighbour(int vertex, @NotNull IntPredicate excluded) {
+        return -1;
+    }
+
+    // the values of an attribute indexed by the edge id; the same array is returned until the graph gets more edges.
+    @NotNull double[] getColumn(@NotNull EdgeAttribute attribute);
+
+    // sets the value of (from, to) and (to, from) in a column: a single write if both directions share the edge.
+    default void set(@NotNull double[] column, int from, int to, double value) {
+        column[getEdgeId(from, to)] = value;
+        if(!isSymmetric()) column[getEdgeId(to, from)] = value;
+    }
+
+    // sets the value of (from, to) in a column; (to, from) changes as well if both directions share the edge.
+    default void setDirected(@NotNull double[] column, int from, int to, double value) {
+        column[getEdgeId(from, to)] = value;
+    }
+}
@@ -0,0 +1,110 @@
+package jo.ju.edu.tsp.core;
+
+import org.jetbrains.annotations.NotNull;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+
+// The 64-bit xxHash (XXH64, seed 0) of a stream of bytes given in buffers of any size: the content hash of the source
+// files of GraphSnapshot. Stripes of 32 bytes are folded into four accumulators; the last partial stripe is kept until
+// digest().
+final class XXHash64 {
+    private static final long PRIME1 = 0x9E3779B185EBCA87L;
+    private static final long PRIME2 = 0xC2B2AE3D27D4EB4FL;
+    private static final long PRIME3 = 0x165667B19E3779F9L;
+    private static final long PRIME4 = 0x85EBCA77C2B2AE63L;
+    private static final long PRIME5 = 0x27D4EB2F165667C5L;
+    private static final int WINDOW_SIZE = 1 << 30;
+
+    private long v1 = PRIME1 + PRIME2, v2 = PRIME2, v3 = 0, v4 = -PRIME1;
+    private final ByteBuffer stripe = ByteBuffer.allocate(32).order(ByteOrder.LITTLE_ENDIAN);
+    private long length = 0;
+
+    // the hash of the file, read in memory-mapped windows.
+    static long of(@NotNull File file) throws IOException {
+        XXHash64 hash = new XXHash64();
+        try(RandomAccessFile raf = new RandomAccessFile(file, "r"); FileChannel channel = raf.getChannel()) {
+            long size = channel.size();
+            for(long position = 0; position < size; position += WINDOW_SIZE) {
+                hash.update(channel.map(FileChannel.MapMode.READ_ONLY, position, Math.min(WINDOW_SIZE, size - position)));
+            }
+        }
+        return hash.digest();
+    }
+
+    // the bytes from the position to the limit of the buffer, which is then at its limit.
+    void update(@NotNull ByteBuffer buffer) {
+        ByteBuffer in = buffer.duplicate().order(ByteOrder.LITTLE_ENDIAN);
+        buffer.position(buffer.limit());
+        length += in.remaining();
+        if(stripe.position() > 0) {
+            while(stripe.hasRemaining() && in.hasRemaining()) stripe.put(in.get());
+            if(stripe.hasRemaining()) return;
+            v1 = round(v1, stripe.getLong(0));
+            v2 = round(v2, stripe.getLong(8));
+            v3 = round(v3, stripe.getLong(16));
+            v4 = round(v4, stripe.getLong(24));
+            stripe.clear();
+        }
+        int p = in.position(), limit = in.limit();
+        for(; p + 32 <= limit; p += 32) {
+            v1 = round(v1, in.getLong(p));
+            v2 = round(v2, in.getLong(p + 8));
+            v3 = round(v3, in.getLong(p + 16));
+            v4 = round(v4, in.getLong(p + 24));
+        }
+        in.position(p);
+        while(in.hasRemaining()) stripe.put(in.get());
+    }
+
+    long digest() {
+        long h;
+        if(length >= 32) {
+            h = Long.rotateLeft(v1, 1) + Long.rotateLeft(v2, 7) + Long.rotateLeft(v3, 12) + Long.rotateLeft(v4, 18);
+            h = merge(h, v1);
+            h = merge(h, v2);
+            h = merge(h, v3);
+            h = merge(h, v4);
+        } else {
+            h = PRIME5;
+        }
+        h += length;
+
+        int remaining = stripe.position(), p = 0;
+        for(; p + 8 <= remaining; p += 8) {
+            h ^= round(0, stripe.getLong(p));
+            h = Long.rotateLeft(h, 27) * PRIME1 + PRIME4;
+        }
+        if(p + 4 <= remaining) {
+            h ^= (stripe.getInt(p) & 0xFFFFFFFFL) * PRIME1;
+            h = Long.rotateLeft(h, 23) * PRIME2 + PRIME3;
+            p += 4;
+        }
+        for(; p < remaining; p++) {
+            h ^= (stripe.get(p) & 0xFFL) * PRIME5;
+            h = Long.rotateLeft(h, 11) * PRIME1;
+        }
+
+        h ^= h >>> 33;
+        h *= PRIME2;
+        h ^= h >>> 29;
+        h *= PRIME3;
+        h ^= h >>> 32;
+        return h;
+    }
+
+    private static long round(long accumulator, long input) {
+        accumulator += input * PRIME2;
+        accumulator = Long.rotateLeft(accumulator, 31);
+        return accumulator * PRIME1;
+    }
+
+    private static long merge(long h, long accumulator) {
+        h ^= round(0, accumulator);
+        return h * PRIME1 + PRIME4;
+    }
+}
@@ -0,0 +1,157 @@
+package jo.ju.edu.tsp.core.kernels;
+
+import jo.ju.edu.tsp.core.tsplib.NativeTSPLIB;
+import org.jetbrains.annotations.NotNull;
+import org.jetbrains.annotations.Nullable;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+
+// The costs of an instance in direct (off-heap) buffers of doubles in native byte order: a full matrix, the lower
+// triangle of a symmetric matrix (the layout of the binary instance format) or the coordinates with a metric. The
+// native kernels read the buffers in place; the Java kernels read them through getCost.
+public final class CostBuffer implements EdgeCosts {
+    // layouts of the costs, in the order of CostLayout (TourKernels.hpp) of libtspkernels.
+    public static final int FULL_MATRIX = 0;
+    public static final int LOWER_MATRIX = 1;
+    public static final int COORDINATES = 2;
+
+    private static final double GEO_RADIUS = 6378.388;
+    private static final double GEO_PI = 3.141592;
+
+    private final int layout;
+    private final int numberOfVertices;
+    private final Metric metric;
+    private final boolean rounded;
+    private final ByteBuffer costs;
+    private final ByteBuffer y;
+    private final DoubleBuffer costValues;
+    private final DoubleBuffer yValues;
+
+    private CostBuffer(int layout, int numberOfVertices, Metric metric, boolean rounded, @NotNull ByteBuffer costs, @Nullable ByteBuffer y) {
+        if(!costs.isDirect() || (y != null && !y.isDirect())) throw new IllegalArgumentException("the costs have to be in a direct buffer");
+        this.layout = layout;
+        this.numberOfVertices = numberOfVertices;
+        this.metric = metric;
+        this.rounded = rounded;
+        this.costs = costs.order(ByteOrder.nativeOrder());
+        this.y = y == null ? null : y.order(ByteOrder.nativeOrder());
+        this.costValues = this.costs.asDoubleBuffer();
+        this.yValues = this.y == null ? null : this.y.asDoubleBuffer();
+        long size = layout == FULL_MATRIX ? (long) numberOfVertices * numberOfVertices
+                : layout == LOWER_MATRIX ? (long) numberOfVertices * (numberOfVertices - 1) / 2 : numberOfVertices;
+        if(costValues.capacity() < size || (yValues != null && yValues.capacity() < size)) {
+            throw new IllegalArgumentException("the buffer is too small for " + numberOfVertices + " vertices");
+        }
+    }
+
+    // lower: the strictly lower triangle of a symmetric matrix, the cost of {i, j}, j < i, is at i * (i - 1) / 2 + j.
+    public static @NotNull CostBuffer ofMatrix(@NotNull ByteBuffer costs, int numberOfVertices, boolean lower) {
+        return new CostBuffer(lower ? LOWER_MATRIX : FULL_MATRIX, numberOfVertices, Metric.EUC_2D, true, costs, null);
+    }
+
+    public static @NotNull CostBuffer ofMatrix(@NotNull double[] costs, int numberOfVertices, boolean lower) {
+        return ofMatrix(toDirectBuffer(costs), numberOfVertices, lower);
+    }
+
+    // the coordinates as given in the TSPLIB file; rounded: the costs are rounded as defined by the TSPLIB.
+    public static @NotNull CostBuffer ofCoordinates(@NotNull double[] x, @NotNull double[] y, @NotNull Metric metric, boolean rounded) {
+        if(x.length != y.length) throw new IllegalArgumentException("the numbers of x- and y-coordinates differ");
+        if(metric == Metric.GEO) {
+            // converted once per vertex, as the native kernels expect radians.
+            x = toRadians(x);
+            y = toRadians(y);
+        }
+        return new CostBuffer(COORDINATES, x.length, metric, rounded, toDirectBuffer(x), toDirectBuffer(y));
+    }
+
+    // the lower triangle of a symmetric instance, the full matrix otherwise.
+    public static @NotNull CostBuffer of(@NotNull NativeTSPLIB instance) {
+        return instance.isSymmetric()
+                ? ofMatrix(instance.getLowerCostBuffer(), instance.getDimension(), true)
+                : ofMatrix(instance.getCostBuffer(), instance.getDimension(), false);
+    }
+
+    public int getLayout() {
+        return layout;
+    }
+
+    public int getNumberOfVertices() {
+        return numberOfVertices;
+    }
+
+    public @NotNull Metric getMetric() {
+        return metric;
+    }
+
+    public boolean isRounded() {
+        return rounded;
+    }
+
+    public @NotNull ByteBuffer getCosts() {
+        return costs;
+    }
+
+    public @Nullable ByteBuffer getY() {
+        return y;
+    }
+
+    // the cost of the edge (i, j), j != i.
+    @Override
+    public double getCost(int i, int j) {
+        switch (layout) {
+            case FULL_MATRIX:
+                return costValues.get(i * numberOfVertices + j);
+            case LOWER_MATRIX:
+                return j < i ? costValues.get(i * (i - 1) / 2 + j) : costValues.get(j * (j - 1) / 2 + i);
+            default:
+                return getCost(costValues.get(i), yValues.get(i), costValues.get(j), yValues.get(j));
+        }
+    }
+
+    // the same formulas as computeBlockCost of the metric kernels.
+    private double getCost(double x1, double y1, double x2, double y2) {
+        double deltaX = x1 - x2, deltaY = y1 - y2;
+        switch (metric) {
+            case EUC_2D:
+                if(rounded) return (double) (long) (Math.sqrt(deltaX * deltaX + deltaY * deltaY) + 0.5);
+                break;
+            case CEIL_2D:
+                if(rounded) {
+                    double distance = Math.sqrt(deltaX * deltaX + deltaY * deltaY);
+                    double truncated = (double) (long) distance;
+                    return truncated + (truncated < distance ? 1.0 : 0.0);
+                }
+                break;
+            case ATT: {
+                double distance = Math.sqrt((deltaX * deltaX + deltaY * deltaY) / 10.0);
+                if(!rounded) return distance;
+                double nearest = (double) (long) (distance + 0.5);
+                return nearest + (nearest < distance ? 1.0 : 0.0);
+            }
+            case GEO: {
+                double q1 = Math.cos(y1 - y2), q2 = Math.cos(x1 - x2), q3 = Math.cos(x1 + x2);
+                double distance = GEO_RADIUS * Math.acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3));
+                return rounded ? (double) (long) (distance + 1.0) : distance;
+            }
+        }
+        return Math.sqrt(deltaX * deltaX + deltaY * deltaY);
+    }
+
+    private static double[] toRadians(@NotNull double[] coordinates) {
+        double[] radians = new double[coordinates.length];
+        for(int i = 0; i < coordinates.length; i++) {
+            double degrees = (double) (long) coordinates[i];
+            double minutes = coordinates[i] - degrees;
+            radians[i] = GEO_PI * (degrees + 5.0 * minutes / 3.0) / 180.0;
+        }
+        return radians;
+    }
+
+    private static @NotNull ByteBuffer toDirectBuffer(@NotNull double[] values) {
+        ByteBuffer buffer = ByteBuffer.allocateDirect(values.length * Double.BYTES).order(ByteOrder.nativeOrder());
+        buffer.asDoubleBuffer().put(values);
+        return buffer;
+    }
+}
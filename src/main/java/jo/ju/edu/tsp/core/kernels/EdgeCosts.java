@@ -0,0 +1,8 @@
+package jo.ju.edu.tsp.core.kernels;
+
+// The costs read by the Java tour kernels: a CostBuffer, or the getCost of a graph whose costs are not in one.
+@FunctionalInterface
+public interface EdgeCosts {
+    // the cost of the edge (i, j), j != i.
+    double getCost(int i, int j);
+}
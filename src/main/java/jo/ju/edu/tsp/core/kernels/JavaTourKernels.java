@@ -0,0 +1,79 @@
+package jo.ju.edu.tsp.core.kernels;
+
+import org.jetbrains.annotations.NotNull;
+
+// The kernels in plain Java: the same loops as TourKernels.cpp, so both give the same tours.
+public class JavaTourKernels extends TourKernels {
+    // the native kernels sum the costs of the coordinates in blocks of this size.
+    private static final int BLOCK_SIZE = 256;
+
+    private final EdgeCosts costs;
+    // the lengths are summed in blocks, as the native kernels sum those of coordinates.
+    private final boolean blocked;
+
+    public JavaTourKernels(@NotNull CostBuffer costs) {
+        this(costs, costs.getLayout() == CostBuffer.COORDINATES);
+    }
+
+    // the costs of a graph without a CostBuffer; there are no native kernels to agree with.
+    public JavaTourKernels(@NotNull EdgeCosts costs) {
+        this(costs, false);
+    }
+
+    private JavaTourKernels(@NotNull EdgeCosts costs, boolean blocked) {
+        this.costs = costs;
+        this.blocked = blocked;
+    }
+
+    @Override
+    public boolean isNative() {
+        return false;
+    }
+
+    @Override
+    public double getTourLength(@NotNull int[] tour) {
+        int n = tour.length;
+        if(!blocked) {
+            double length = 0;
+            for(int k = 0; k < n; k++) {
+                length += costs.getCost(tour[k], tour[k + 1 < n ? k + 1 : 0]);
+            }
+            return length;
+        }
+
+        double length = 0;
+        for(int start = 0; start < n; start += BLOCK_SIZE) {
+            double sum = 0;
+            for(int k = start; k < Math.min(start + BLOCK_SIZE, n); k++) {
+                sum += costs.getCost(tour[k], tour[k + 1 < n ? k + 1 : 0]);
+            }
+            length += sum;
+        }
+        return length;
+    }
+
+    @Override
+    public double findTwoOptMove(@NotNull int[] tour, @NotNull int[] position, @NotNull int[] neighbours, int k, @NotNull int[] move) {
+        int n = tour.length;
+        double bestGain = 0;
+        for(int i = 0; i < n; i++) {
+            int a = tour[i], b = tour[i + 1 < n ? i + 1 : 0];
+            double costAB = costs.getCost(a, b);
+            for(int l = 0; l < k; l++) {
+                int c = neighbours[a * k + l];
+                double costAC = costs.getCost(a, c);
+                // the lists are sorted: no further neighbour can give a gain.
+                if(costAC >= costAB) break;
+                int j = position[c], d = tour[j + 1 < n ? j + 1 : 0];
+                if(c == b || d == a) continue;
+                double gain = costAB + costs.getCost(c, d) - costAC - costs.getCost(b, d);
+                if(gain > bestGain) {
+                    bestGain = gain;
+                    move[0] = i;
+                    move[1] = j;
+                }
+            }
+        }
+        return bestGain;
+    }
+}
@@ -0,0 +1,15 @@
+package jo.ju.edu.tsp.core.kernels;
+
+// TSPLIB metrics of the coordinates, in the order of the metric kernels (MetricKernels.hpp) of libtspkernels.
+public enum Metric {
+    EUC_2D,
+    CEIL_2D,
+    ATT,
+    GEO;
+
+    // the costs of ATT and GEO are integers by definition: TransformTSPLIB rounds them in the XML and binary files, so
+    // the graphs read from the coordinates round them as well (EUC_2D and CEIL_2D are written exactly).
+    public boolean isAlwaysRounded() {
+        return this == ATT || this == GEO;
+    }
+}
@@ -0,0 +1,60 @@
+package jo.ju.edu.tsp.core.kernels;
+
+import org.jetbrains.annotations.NotNull;
+
+import java.nio.ByteBuffer;
+
+// The kernels of libtspkernels.so, which read the direct buffers of the CostBuffer in place. Build the library with
+// "make native" in src/main/resources/transformer/Debug and put it on java.library.path (or set
+// -Dtspkernels.library=/path/libtspkernels.so).
+public class NativeTourKernels extends TourKernels {
+    private static final String LIBRARY_PROPERTY = "tspkernels.library";
+    private static final String LIBRARY_NAME = "tspkernels";
+    private static final boolean AVAILABLE = loadLibrary();
+
+    private final CostBuffer costs;
+
+    public NativeTourKernels(@NotNull CostBuffer costs) {
+        if(!AVAILABLE) throw new IllegalStateException("libtspkernels is not available");
+        this.costs = costs;
+    }
+
+    private static boolean loadLibrary() {
+        try {
+            String path = System.getProperty(LIBRARY_PROPERTY);
+            if(path != null) {
+                System.load(path);
+            } else {
+                System.loadLibrary(LIBRARY_NAME);
+            }
+            return true;
+        } catch (UnsatisfiedLinkError | SecurityException ex) {
+            return false;
+        }
+    }
+
+    public static boolean isAvailable() {
+        return AVAILABLE;
+    }
+
+    @Override
+    public boolean isNative() {
+        return true;
+    }
+
+    @Override
+    public double getTourLength(@NotNull int[] tour) {
+        return getTourLength(costs.getLayout(), costs.getMetric().ordinal(), costs.isRounded(),
+                costs.getNumberOfVertices(), costs.getCosts(), costs.getY(), tour);
+    }
+
+    @Override
+    public double findTwoOptMove(@NotNull int[] tour, @NotNull int[] position, @NotNull int[] neighbours, int k, @NotNull int[] move) {
+        return findTwoOptMove(costs.getLayout(), costs.getMetric().ordinal(), costs.isRounded(),
+                costs.getNumberOfVertices(), costs.getCosts(), costs.getY(), tour, position, neighbours, k, move);
+    }
+
+    private static native double getTourLength(int layout, int metric, boolean rounded, int n, ByteBuffer costs, ByteBuffer y, int[] tour);
+    private static native double findTwoOptMove(int layout, int metric, boolean rounded, int n, ByteBuffer costs, ByteBuffer y,
+                                                int[] tour, int[] position, int[] neighbours, int k, int[] move);
+}
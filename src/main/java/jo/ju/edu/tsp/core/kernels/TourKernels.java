@@ -0,0 +1,98 @@
+package jo.ju.edu.tsp.core.kernels;
+
+import org.jetbrains.annotations.NotNull;
+
+// Tour length and 2-opt move scanning over a CostBuffer (the Java kernels also over any EdgeCosts); the solvers evaluate
+// and improve their tours with them (see TSP.getTourKernels). The native kernels (libtspkernels.so) are chosen at
+// runtime by the system property "tsp.kernels": "java", "native" (if the library is available) or "auto" (the default:
+// native for instances with at least "tsp.kernels.threshold" vertices, 1000 by default).
+public abstract class TourKernels {
+    public static final String PROPERTY = "tsp.kernels";
+    public static final String THRESHOLD_PROPERTY = "tsp.kernels.threshold";
+    private static final int DEFAULT_THRESHOLD = 1000;
+
+    public static @NotNull TourKernels create(@NotNull CostBuffer costs) {
+        String selection = System.getProperty(PROPERTY, "auto");
+        boolean useNative;
+        if(selection.equalsIgnoreCase("java")) {
+            useNative = false;
+        } else if(selection.equalsIgnoreCase("native")) {
+            useNative = true;
+        } else {
+            useNative = costs.getNumberOfVertices() >= Integer.getInteger(THRESHOLD_PROPERTY, DEFAULT_THRESHOLD);
+        }
+        return create(costs, useNative);
+    }
+
+    // falls back to the Java kernels if the native library is not available.
+    public static @NotNull TourKernels create(@NotNull CostBuffer costs, boolean useNative) {
+        if(useNative && NativeTourKernels.isAvailable()) {
+            return new NativeTourKernels(costs);
+        }
+        return new JavaTourKernels(costs);
+    }
+
+    public abstract boolean isNative();
+
+    // the length of the closed tour (a permutation of the vertices, 0-based).
+    public abstract double getTourLength(@NotNull int[] tour);
+
+    // The best improving 2-opt move along the neighbour lists (sorted by increasing cost, the neighbours of v at
+    // v * k ... v * k + k - 1): the edges (a, b) and (c, d) are replaced by (a, c) and (b, d). The positions i of a and
+    // j of c are stored in move; the gain is returned (0 if there is no improving move). The costs have to be symmetric.
+    public abstract double findTwoOptMove(@NotNull int[] tour, @NotNull int[] position, @NotNull int[] neighbours, int k, @NotNull int[] move);
+
+    // reverses the part of the tour between the positions move[0] + 1 and move[1] (or the complementary part).
+    public static void applyTwoOptMove(@NotNull int[] tour, @NotNull int[] position, @NotNull int[] move) {
+        int from = Math.min(move[0], move[1]) + 1, to = Math.max(move[0], move[1]);
+        for(; from < to; from++, to--) {
+            int vertex = tour[from];
+            tour[from] = tour[to];
+            tour[to] = vertex;
+        }
+        for(int i = Math.min(move[0], move[1]) + 1; i <= Math.max(move[0], move[1]); i++) {
+            position[tour[i]] = i;
+        }
+    }
+
+    // applies the best 2-opt move until no move improves the tour; returns the length of the improved tour.
+    public double improveByTwoOpt(@NotNull int[] tour, @NotNull int[] neighbours, int k) {
+        int[] position = new int[tour.length];
+        for(int i = 0; i < tour.length; i++) {
+            position[tour[i]] = i;
+        }
+        int[] move = new int[2];
+        while(findTwoOptMove(tour, position, neighbours, k, move) > 0) {
+            applyTwoOptMove(tour, position, move);
+        }
+        return getTourLength(tour);
+    }
+
+    // the k (at most n - 1) nearest neighbours of every vertex, sorted by increasing cost (quadratic; prefer a ".cand" file).
+    public static @NotNull int[] computeNeighbourLists(@NotNull CostBuffer costs, int k) {
+        int n = costs.getNumberOfVertices();
+        k = Math.max(0, Math.min(k, n - 1));
+        if((long) n * k > Integer.MAX_VALUE) {
+            throw new IllegalArgumentException(n + " lists of " + k + " neighbours do not fit into an array; choose a smaller k");
+        }
+        int[] neighbours = new int[n * k];
+        double[] nearest = new double[k];
+        for(int v = 0; v < n; v++) {
+            int found = 0;
+            for(int u = 0; u < n; u++) {
+                if(u == v) continue;
+                double cost = costs.getCost(v, u);
+                if(found == k && (k == 0 || cost >= nearest[k - 1])) continue;
+                // insertion into the sorted list of the nearest vertices found so far.
+                int l = found < k ? found++ : k - 1;
+                for(; l > 0 && nearest[l - 1] > cost; l--) {
+                    nearest[l] = nearest[l - 1];
+                    neighbours[v * k + l] = neighbours[v * k + l - 1];
+                }
+                nearest[l] = cost;
+                neighbours[v * k + l] = u;
+            }
+        }
+        return neighbours;
+    }
+}
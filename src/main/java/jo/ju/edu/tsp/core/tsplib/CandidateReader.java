@@ -0,0 +1,88 @@
+package jo.ju.edu.tsp.core.tsplib;
+
+import jo.ju.edu.tsp.core.CandidateGraph;
+import jo.ju.edu.tsp.core.WeightedGraph;
+import org.jetbrains.annotations.NotNull;
+
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.InputStreamReader;
+import java.nio.charset.StandardCharsets;
+import java.util.zip.GZIPInputStream;
+
+// Reads a candidate file (".cand", also ".gz", see CandidateFormat.hpp) written by TransformTSPLIB or GenerateTSPLIB:
+// the lines "i j_1 c_1 ... j_k c_k" of the CANDIDATE_SECTION become the lists of a CandidateGraph over the base graph.
+public final class CandidateReader {
+    private CandidateReader() {
+    }
+
+    public static @NotNull CandidateGraph read(@NotNull File file, @NotNull WeightedGraph base) throws IOException {
+        try(InputStream fileIn = new FileInputStream(file);
+            InputStream in = file.getName().toLowerCase().endsWith(".gz") ? new GZIPInputStream(fileIn, 1 << 16) : fileIn;
+            BufferedReader reader = new BufferedReader(new InputStreamReader(in, StandardCharsets.ISO_8859_1), 1 << 16)) {
+            String line;
+            while((line = reader.readLine()) != null) {
+                line = line.trim();
+                int colon = line.indexOf(':');
+                String key = (colon < 0 ? line : line.substring(0, colon)).trim().toUpperCase();
+                String value = colon < 0 ? "" : line.substring(colon + 1).trim();
+                if(key.equals("TYPE")) {
+                    if(!value.equalsIgnoreCase("CANDIDATES")) throw new IOException(file + " is not a candidate file");
+                } else if(key.equals("DIMENSION")) {
+                    if(!value.equals(Integer.toString(base.getNumberOfVertices()))) {
+                        throw new IOException(file + ": the DIMENSION " + value + " differs from the " + base.getNumberOfVertices() + " vertices of " + base.getName());
+                    }
+                } else if(key.equals("CANDIDATE_SECTION")) {
+                    return readSection(reader, base, file);
+                }
+            }
+            throw new IOException(file + " has no CANDIDATE_SECTION");
+        }
+    }
+
+    // the lines of the vertices 1 ... n in any order.
+    private static @NotNull CandidateGraph readSection(@NotNull BufferedReader reader, @NotNull WeightedGraph base, @NotNull File file) throws IOException {
+        int n = base.getNumberOfVertices();
+        int[][] rowTargets = new int[n][];
+        double[][] rowCosts = new double[n][];
+        for(int count = 0; count < n; count++) {
+            String line = reader.readLine();
+            if(line == null) throw new IOException(file + ": the CANDIDATE_SECTION has only " + count + " of " + n + " vertices");
+            String[] fields = line.trim().split("\\s+");
+            try {
+                int i = Integer.parseInt(fields[0]) - 1;
+                if(fields.length % 2 == 0 || i < 0 || i >= n || rowTargets[i] != null) {
+                    throw new IOException(file + ": invalid line \"" + line + "\" in the CANDIDATE_SECTION");
+                }
+                int k = fields.length / 2;
+                rowTargets[i] = new int[k];
+                rowCosts[i] = new double[k];
+                for(int l = 0; l < k; l++) {
+                    rowTargets[i][l] = Integer.parseInt(fields[1 + 2 * l]) - 1;
+                    rowCosts[i][l] = Double.parseDouble(fields[2 + 2 * l]);
+                }
+            } catch (NumberFormatException ex) {
+                throw new IOException(file + ": invalid line \"" + line + "\" in the CANDIDATE_SECTION", ex);
+            }
+        }
+
+        int[] offsets = new int[n + 1];
+        for(int i = 0; i < n; i++) {
+            offsets[i + 1] = offsets[i] + rowTargets[i].length;
+        }
+        int[] targets = new int[offsets[n]];
+        double[] costs = new double[offsets[n]];
+        for(int i = 0; i < n; i++) {
+            System.arraycopy(rowTargets[i], 0, targets, offsets[i], rowTargets[i].length);
+            System.arraycopy(rowCosts[i], 0, costs, offsets[i], rowCosts[i].length);
+        }
+        try {
+            return CandidateGraph.of(base, offsets, targets, costs);
+        } catch (IllegalArgumentException ex) {
+            throw new IOException(file + ": " + ex.getMessage(), ex);
+        }
+    }
+}
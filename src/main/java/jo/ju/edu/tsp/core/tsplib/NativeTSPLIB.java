@@ -0,0 +1,151 @@
+package jo.ju.edu.tsp.core.tsplib;
+
+import org.jetbrains.annotations.NotNull;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+// Reads TSPLIB files (".tsp", ".atsp", also ".gz") in process through libtsplib.so, which shares the reading and
+// rounding code with TransformTSPLIB: no intermediate XML file is needed. Build the library with "make native" in
+// src/main/resources/transformer/Debug and put it on java.library.path (or set -Dtsplib.library=/path/libtsplib.so).
+public final class NativeTSPLIB implements AutoCloseable {
+    private static final String LIBRARY_PROPERTY = "tsplib.library";
+    private static final String LIBRARY_NAME = "tsplib";
+    private static final boolean AVAILABLE = loadLibrary();
+
+    private long handle;
+    private final String name;
+    private final String description;
+    private final boolean symmetric;
+    private final int dimension;
+
+    private NativeTSPLIB(long handle) {
+        this.handle = handle;
+        this.name = getName(handle);
+        this.description = getDescription(handle);
+        this.symmetric = isSymmetric(handle);
+        this.dimension = (int) getDimension(handle);
+    }
+
+    private static boolean loadLibrary() {
+        try {
+            String path = System.getProperty(LIBRARY_PROPERTY);
+            if(path != null) {
+                System.load(path);
+            } else {
+                System.loadLibrary(LIBRARY_NAME);
+            }
+            return true;
+        } catch (UnsatisfiedLinkError | SecurityException ex) {
+            return false;
+        }
+    }
+
+    public static boolean isAvailable() {
+        return AVAILABLE;
+    }
+
+    public static @NotNull NativeTSPLIB open(@NotNull File file) throws IOException {
+        if(!AVAILABLE) {
+            throw new IOException("libtsplib is not available; convert " + file + " with TransformTSPLIB instead");
+        }
+        long handle = open(file.getPath());
+        if(getDimension(handle) > Integer.MAX_VALUE) {
+            close(handle);
+            throw new IOException(file + " is too large");
+        }
+        return new NativeTSPLIB(handle);
+    }
+
+    public String getName() {
+        return name;
+    }
+
+    public String getDescription() {
+        return description;
+    }
+
+    public boolean isSymmetric() {
+        return symmetric;
+    }
+
+    public int getDimension() {
+        return dimension;
+    }
+
+    public boolean hasCoordinates() {
+        return hasCoordinates(checkedHandle());
+    }
+
+    // the full matrix row by row: the cost of (i, j) is costs[i * n + j]; the diagonal of symmetric instances is 0.
+    public double[] getCosts() {
+        double[] costs = new double[checkedSize((long) dimension * dimension, 1)];
+        copyCosts(checkedHandle(), costs, false);
+        return costs;
+    }
+
+    // the strictly lower triangle of symmetric instances: the cost of (i, j), j < i, is costs[i * (i - 1) / 2 + j].
+    public double[] getLowerCosts() {
+        double[] costs = new double[checkedSize(lowerSize(), 1)];
+        copyCosts(checkedHandle(), costs, true);
+        return costs;
+    }
+
+    // the same layouts in a direct buffer (native byte order), which stays outside of the Java heap.
+    public @NotNull ByteBuffer getCostBuffer() {
+        return costBuffer((long) dimension * dimension, false);
+    }
+
+    public @NotNull ByteBuffer getLowerCostBuffer() {
+        return costBuffer(lowerSize(), true);
+    }
+
+    // x in the first row, y in the second one.
+    public double[][] getCoordinates() {
+        double[][] coordinates = new double[2][dimension];
+        copyCoordinates(checkedHandle(), coordinates[0], coordinates[1]);
+        return coordinates;
+    }
+
+    @Override
+    public void close() {
+        if(handle != 0) {
+            close(handle);
+            handle = 0;
+        }
+    }
+
+    private @NotNull ByteBuffer costBuffer(long size, boolean lower) {
+        ByteBuffer costs = ByteBuffer.allocateDirect(checkedSize(size, Double.BYTES)).order(ByteOrder.nativeOrder());
+        copyCostsToBuffer(checkedHandle(), costs, lower);
+        return costs;
+    }
+
+    private long lowerSize() {
+        if(!symmetric) throw new IllegalStateException(name + " is not symmetric");
+        return (long) dimension * (dimension - 1) / 2;
+    }
+
+    private static int checkedSize(long elements, int bytes) {
+        if(elements * bytes > Integer.MAX_VALUE) throw new IllegalStateException("the matrix does not fit into an array");
+        return (int) (elements * bytes);
+    }
+
+    private long checkedHandle() {
+        if(handle == 0) throw new IllegalStateException(name + " is closed");
+        return handle;
+    }
+
+    private static native long open(String fileName) throws IOException;
+    private static native void close(long handle);
+    private static native String getName(long handle);
+    private static native String getDescription(long handle);
+    private static native boolean isSymmetric(long handle);
+    private static native long getDimension(long handle);
+    private static native boolean hasCoordinates(long handle);
+    private static native void copyCosts(long handle, double[] costs, boolean lower);
+    private static native void copyCostsToBuffer(long handle, ByteBuffer costs, boolean lower);
+    private static native void copyCoordinates(long handle, double[] x, double[] y);
+}
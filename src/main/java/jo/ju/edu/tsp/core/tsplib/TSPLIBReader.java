@@ -0,0 +1,94 @@
+package jo.ju.edu.tsp.core.tsplib;
+
+import jo.ju.edu.tsp.core.CoordinateGraph;
+import jo.ju.edu.tsp.core.kernels.Metric;
+import org.jetbrains.annotations.NotNull;
+import org.jetbrains.annotations.Nullable;
+
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.InputStreamReader;
+import java.nio.charset.StandardCharsets;
+import java.util.zip.GZIPInputStream;
+
+// Reads the NODE_COORD_SECTION of a TSPLIB file (also ".gz") in Java, without libtsplib: the instances with the
+// EDGE_WEIGHT_TYPE EUC_2D, CEIL_2D, ATT or GEO become a CoordinateGraph. Other instances (explicit matrices, ATSP) are
+// left to NativeTSPLIB.
+public final class TSPLIBReader {
+    private TSPLIBReader() {
+    }
+
+    // null if the instance is not given by coordinates of one of these metrics.
+    public static @Nullable CoordinateGraph readCoordinates(@NotNull File file, @NotNull String name, boolean rounded, int cacheMegabytes) throws IOException {
+        try(InputStream fileIn = new FileInputStream(file);
+            InputStream in = file.getName().toLowerCase().endsWith(".gz") ? new GZIPInputStream(fileIn, 1 << 16) : fileIn;
+            BufferedReader reader = new BufferedReader(new InputStreamReader(in, StandardCharsets.ISO_8859_1), 1 << 16)) {
+            int dimension = -1;
+            Metric metric = null;
+            String line;
+            while((line = reader.readLine()) != null) {
+                line = line.trim();
+                int colon = line.indexOf(':');
+                String key = (colon < 0 ? line : line.substring(0, colon)).trim().toUpperCase();
+                String value = colon < 0 ? "" : line.substring(colon + 1).trim();
+                if(key.equals("TYPE")) {
+                    if(!value.split("\\s+")[0].equalsIgnoreCase("TSP")) return null;
+                } else if(key.equals("DIMENSION")) {
+                    dimension = parseDimension(value, file);
+                } else if(key.equals("EDGE_WEIGHT_TYPE")) {
+                    metric = toMetric(value);
+                    if(metric == null) return null;
+                } else if(key.equals("NODE_COORD_SECTION")) {
+                    if(dimension < 0 || metric == null) return null;
+                    double[] x = new double[dimension], y = new double[dimension];
+                    readSection(reader, x, y, file);
+                    return new CoordinateGraph(name, x, y, metric, rounded, cacheMegabytes);
+                } else if(key.equals("EOF") || key.endsWith("_SECTION")) {
+                    return null;
+                }
+            }
+            return null;
+        }
+    }
+
+    // the lines "i x y" of the vertices 1 ... n.
+    private static void readSection(@NotNull BufferedReader reader, @NotNull double[] x, @NotNull double[] y, @NotNull File file) throws IOException {
+        boolean[] read = new boolean[x.length];
+        for(int count = 0; count < x.length; count++) {
+            String line = reader.readLine();
+            if(line == null) throw new IOException(file + ": the NODE_COORD_SECTION has only " + count + " of " + x.length + " vertices");
+            String[] fields = line.trim().split("\\s+");
+            try {
+                int i = Integer.parseInt(fields[0]) - 1;
+                if(fields.length < 3 || i < 0 || i >= x.length || read[i]) {
+                    throw new IOException(file + ": invalid line \"" + line + "\" in the NODE_COORD_SECTION");
+                }
+                x[i] = Double.parseDouble(fields[1]);
+                y[i] = Double.parseDouble(fields[2]);
+                read[i] = true;
+            } catch (NumberFormatException ex) {
+                throw new IOException(file + ": invalid line \"" + line + "\" in the NODE_COORD_SECTION", ex);
+            }
+        }
+    }
+
+    private static int parseDimension(@NotNull String value, @NotNull File file) throws IOException {
+        try {
+            int dimension = Integer.parseInt(value);
+            if(dimension < 0) throw new NumberFormatException();
+            return dimension;
+        } catch (NumberFormatException ex) {
+            throw new IOException(file + ": invalid DIMENSION \"" + value + "\"", ex);
+        }
+    }
+
+    private static @Nullable Metric toMetric(@NotNull String value) {
+        for(Metric metric : Metric.values()) {
+            if(metric.name().equalsIgnoreCase(value)) return metric;
+        }
+        return null;
+    }
+}
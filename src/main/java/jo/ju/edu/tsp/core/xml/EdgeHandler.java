@@ -0,0 +1,82 @@
+package jo.ju.edu.tsp.core.xml;
+
+import org.xml.sax.Attributes;
+import org.xml.sax.SAXException;
+import org.xml.sax.helpers.DefaultHandler;
+
+// Parses the rows of the graph (both the verbose and the compact encoding) and hands every edge to putEdge; the
+// subclasses decide how the graph is stored.
+public abstract class EdgeHandler extends DefaultHandler {
+    // compact encoding: <vertex costs="c0 c1 ..."/> lists the costs of all columns, "-" marks a missing edge.
+    private static final String COSTS = "costs";
+    private static final String ABSENT_COST = "-";
+
+    private int idx = 0, id = 0;
+    private double cost;
+
+    private boolean isEdge = false;
+
+    // the edge from the vertex idx to the vertex id.
+    protected abstract void putEdge(int idx, int id, double cost) throws SAXException;
+
+    // called after the last edge of the vertex idx.
+    protected void endVertex(int idx) throws SAXException {
+    }
+
+    @Override
+    public void startElement (String uri, String localName, String qName, Attributes attributes) throws SAXException {
+        if(qName.equalsIgnoreCase("edge")) {
+            cost = Double.valueOf(attributes.getValue("cost"));
+            isEdge = true;
+        } else if(qName.equalsIgnoreCase("vertex")) {
+            String costs = attributes.getValue(COSTS);
+            if(costs != null) {
+                putCompactRow(costs);
+            }
+        }
+    }
+
+    // the i-th entry of the list is the edge to the vertex i.
+    private void putCompactRow(String costs) throws SAXException {
+        int column = 0, length = costs.length(), start = 0;
+        while(start < length) {
+            while(start < length && Character.isWhitespace(costs.charAt(start))) start++;
+            if(start == length) break;
+
+            int end = start;
+            while(end < length && !Character.isWhitespace(costs.charAt(end))) end++;
+
+            String entry = costs.substring(start, end);
+            if(!entry.equals(ABSENT_COST)) {
+                double value;
+                try {
+                    value = Double.parseDouble(entry);
+                } catch (NumberFormatException ex) {
+                    throw new SAXException("Invalid cost \"" + entry + "\" of the vertex " + idx, ex);
+                }
+                putEdge(idx, column, value);
+            }
+            column++;
+            start = end;
+        }
+    }
+
+    @Override
+    public void characters(char ch[], int start, int length) throws SAXException {
+        if(isEdge) {
+            id = Integer.valueOf(new String(ch, start, length));
+            isEdge = false;
+        }
+    }
+
+    @Override
+    public void endElement(String uri, String localName, String qName) throws SAXException {
+        if(qName.equalsIgnoreCase("edge")) {
+            putEdge(idx, id, cost);
+            id = 0;
+        } else if(qName.equalsIgnoreCase("vertex")) {
+            endVertex(idx);
+            idx++;
+        }
+    }
+}
@@ -0,0 +1,388 @@
+package jo.ju.edu.tsp.core.xml;
+
+import org.jetbrains.annotations.NotNull;
+import org.xml.sax.SAXException;
+
+import java.io.BufferedInputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.Future;
+import java.util.zip.GZIPInputStream;
+
+// Reads the rows of the graph without an XML parser: the file is scanned byte by byte for the <vertex> and <edge>
+// elements (both encodings) and the numbers are parsed in place, so nothing is allocated per edge except by the handler
+// (PackedGraphHandler allocates nothing) and for costs with more than 18 significant digits, which are left to
+// Double.parseDouble. A plain file is memory-mapped in windows of 1 GB, a ".gz" file is decompressed into a buffer.
+// Comments, processing instructions, CDATA sections and the other elements are skipped; entities are not expanded.
+final class EdgeScanner {
+    private static final int WINDOW_SIZE = 1 << 30;
+    private static final int GZIP_BUFFER_SIZE = 1 << 16;
+    private static final int MAX_NUMBER_LENGTH = 64;
+    private static final double[] POWERS_OF_TEN = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    private static final byte[] VERTEX = {'v', 'e', 'r', 't', 'e', 'x'};
+    private static final byte[] EDGE = {'e', 'd', 'g', 'e'};
+    private static final byte[] COST = {'c', 'o', 's', 't'};
+    private static final byte[] COSTS = {'c', 'o', 's', 't', 's'};
+
+    private final EdgeHandler handler;
+    private final FileChannel channel;
+    private final InputStream in;
+    private final byte[] chunk;
+    private ByteBuffer buffer;
+    // the position of the buffer in the (decompressed) file, and the end of the mapped range.
+    private long bufferStart;
+    private final long end;
+
+    private final byte[] name = new byte[16];
+    private int nameLength;
+    private final char[] number = new char[MAX_NUMBER_LENGTH];
+    private int numberLength;
+
+    private int idx, id = 0;
+    private double cost;
+    private boolean isEdge = false;
+
+    // reads [start, end) of the channel, or the whole stream; the first vertex read is firstVertex.
+    private EdgeScanner(@NotNull EdgeHandler handler, FileChannel channel, InputStream in, long start, long end, int firstVertex) {
+        this.handler = handler;
+        this.channel = channel;
+        this.in = in;
+        this.chunk = in == null ? null : new byte[GZIP_BUFFER_SIZE];
+        this.buffer = ByteBuffer.allocate(0);
+        this.bufferStart = start;
+        this.end = end;
+        this.idx = firstVertex;
+    }
+
+    static void scan(@NotNull File file, @NotNull EdgeHandler handler) throws IOException, SAXException {
+        if(file.getName().toLowerCase().endsWith(".gz")) {
+            try(InputStream in = new GZIPInputStream(new BufferedInputStream(new FileInputStream(file), GZIP_BUFFER_SIZE), GZIP_BUFFER_SIZE)) {
+                new EdgeScanner(handler, null, in, 0, Long.MAX_VALUE, 0).scan();
+            }
+        } else {
+            try(RandomAccessFile raf = new RandomAccessFile(file, "r"); FileChannel channel = raf.getChannel()) {
+                new EdgeScanner(handler, channel, null, 0, channel.size(), 0).scan();
+            }
+        }
+    }
+
+    // Reads a plain file split at the vertices (see VertexIndex) on the pool. The first vertex, which may decide the
+    // layout of the graph (see PackedGraphHandler), is read before the others; the other vertices are read in about
+    // 4 ranges of equal size per thread, so the handler must accept the edges of different vertices concurrently.
+    static void scanInParallel(@NotNull File file, @NotNull EdgeHandler handler, @NotNull ForkJoinPool pool) throws IOException, SAXException {
+        long[] offsets = VertexIndex.of(file, pool);
+        try(RandomAccessFile raf = new RandomAccessFile(file, "r"); FileChannel channel = raf.getChannel()) {
+            long size = channel.size();
+            if(offsets.length < 2) {
+                new EdgeScanner(handler, channel, null, 0, size, 0).scan();
+                return;
+            }
+            new EdgeScanner(handler, channel, null, 0, offsets[1], 0).scan();
+
+            long rangeSize = Math.max(1, (size - offsets[1]) / (4L * pool.getParallelism()));
+            List<Callable<Void>> tasks = new ArrayList<Callable<Void>>();
+            for(int first = 1, last; first < offsets.length; first = last) {
+                last = first + 1;
+                while(last < offsets.length && offsets[last] - offsets[first] < rangeSize) last++;
+                final int firstVertex = first;
+                final long start = offsets[first], end = last < offsets.length ? offsets[last] : size;
+                tasks.add(() -> {
+                    new EdgeScanner(handler, channel, null, start, end, firstVertex).scan();
+                    return null;
+                });
+            }
+            for(Future<Void> future : pool.invokeAll(tasks)) {
+                try {
+                    future.get();
+                } catch (InterruptedException ex) {
+                    Thread.currentThread().interrupt();
+                    throw new IOException("Interrupted while reading " + file, ex);
+                } catch (ExecutionException ex) {
+                    if(ex.getCause() instanceof SAXException) throw (SAXException) ex.getCause();
+                    if(ex.getCause() instanceof IOException) throw (IOException) ex.getCause();
+                    throw new IOException(ex.getCause());
+                }
+            }
+        }
+    }
+
+    // reads the vertices from firstVertex on, which start at start, up to end (see VertexIndex).
+    static void scanRange(@NotNull FileChannel channel, @NotNull EdgeHandler handler, long start, long end, int firstVertex)
+            throws IOException, SAXException {
+        new EdgeScanner(handler, channel, null, start, end, firstVertex).scan();
+    }
+
+    private boolean refill() throws IOException {
+        bufferStart += buffer.limit();
+        if(channel != null) {
+            if(bufferStart >= end) return false;
+            buffer = channel.map(FileChannel.MapMode.READ_ONLY, bufferStart, Math.min(WINDOW_SIZE, end - bufferStart));
+        } else {
+            int read = in.read(chunk);
+            if(read <= 0) return false;
+            buffer = ByteBuffer.wrap(chunk, 0, read);
+        }
+        return true;
+    }
+
+    // the next byte, or -1 at the end of the file.
+    private int next() throws IOException {
+        if(!buffer.hasRemaining() && !refill()) return -1;
+        return buffer.get() & 0xff;
+    }
+
+    private void scan() throws IOException, SAXException {
+        int c = next();
+        while(c != -1) {
+            if(c != '<') {
+                c = next();
+                continue;
+            }
+            c = next();
+            if(c == '/') {
+                c = readName(next());
+                if(isName(EDGE)) {
+                    if(isEdge) handler.putEdge(idx, id, cost);
+                    isEdge = false;
+                    id = 0;
+                } else if(isName(VERTEX)) {
+                    handler.endVertex(idx);
+                    idx++;
+                }
+                c = skipTo(c, '>');
+            } else if(c == '?') {
+                c = skipPast("?>");
+            } else if(c == '!') {
+                c = next();
+                if(c == '-') {
+                    c = skipPast("-->");
+                } else if(c == '[') {
+                    c = skipPast("]]>");
+                } else {
+                    c = skipTo(c, '>');
+                }
+            } else {
+                c = readName(c);
+                if(isName(EDGE)) {
+                    c = startEdge(c);
+                } else if(isName(VERTEX)) {
+                    c = startVertex(c);
+                } else {
+                    c = skipTo(c, '>');
+                }
+            }
+        }
+    }
+
+    // <edge cost="...">id</edge>; returns the byte after the id.
+    private int startEdge(int c) throws IOException, SAXException {
+        boolean hasCost = false;
+        while(true) {
+            c = skipWhitespace(c);
+            if(c == '>' || c == '/' || c == -1) break;
+            c = readName(c);
+            boolean isCost = isName(COST);
+            int quote = skipWhitespace(skipWhitespace(c) == '=' ? next() : -1);
+            if(quote != '"' && quote != '\'') throw error("Malformed attribute of an edge of the vertex " + idx);
+            if(isCost) {
+                c = readNumber(skipWhitespace(next()), quote);
+                cost = toDouble();
+                hasCost = true;
+            }
+            c = skipTo(isCost ? c : next(), quote);
+        }
+        if(!hasCost) throw error("An edge of the vertex " + idx + " has no cost");
+        isEdge = true;
+        if(c == '/') { // <edge cost="..."/> has no id
+            handler.putEdge(idx, 0, cost);
+            isEdge = false;
+            return skipTo(c, '>');
+        }
+
+        c = skipWhitespace(next());
+        long value = 0;
+        boolean digits = false;
+        while(c >= '0' && c <= '9') {
+            value = value * 10 + (c - '0');
+            if(value > Integer.MAX_VALUE) throw error("Invalid id of an edge of the vertex " + idx);
+            digits = true;
+            c = next();
+        }
+        c = skipWhitespace(c);
+        if(!digits || c != '<') throw error("Invalid id of an edge of the vertex " + idx);
+        id = (int) value;
+        return c;
+    }
+
+    // <vertex> or <vertex costs="..."/>; returns the byte after the tag.
+    private int startVertex(int c) throws IOException, SAXException {
+        while(true) {
+            c = skipWhitespace(c);
+            if(c == '>' || c == -1) return next();
+            if(c == '/') {
+                handler.endVertex(idx);
+                idx++;
+                return skipTo(c, '>');
+            }
+            c = readName(c);
+            boolean isCosts = isName(COSTS);
+            int quote = skipWhitespace(skipWhitespace(c) == '=' ? next() : -1);
+            if(quote != '"' && quote != '\'') throw error("Malformed attribute of the vertex " + idx);
+            c = skipTo(isCosts ? putCompactRow(quote) : next(), quote);
+        }
+    }
+
+    // the i-th entry of the list is the edge to the vertex i, "-" marks a missing edge; returns the quote.
+    private int putCompactRow(int quote) throws IOException, SAXException {
+        int column = 0;
+        int c = next();
+        while(true) {
+            c = skipWhitespace(c);
+            if(c == quote || c == -1) return c;
+            c = readNumber(c, quote);
+            if(numberLength != 1 || number[0] != '-') {
+                handler.putEdge(idx, column, toDouble());
+            }
+            column++;
+        }
+    }
+
+    // reads a name into the name buffer (only its first bytes are kept); returns the byte after it.
+    private int readName(int c) throws IOException {
+        nameLength = 0;
+        while(c != -1 && c != '>' && c != '/' && c != '=' && !isWhitespace(c)) {
+            if(nameLength < name.length) name[nameLength] = (byte) c;
+            nameLength++;
+            c = next();
+        }
+        return c;
+    }
+
+    // the name equals the lower case expected name, ignoring the case as the SAX handler does.
+    private boolean isName(byte[] expected) {
+        if(nameLength != expected.length) return false;
+        for(int i = 0; i < nameLength; i++) {
+            if((name[i] | 0x20) != expected[i]) return false;
+        }
+        return true;
+    }
+
+    // reads a number up to the quote or a whitespace into the number buffer; returns the byte after it.
+    private int readNumber(int c, int quote) throws IOException, SAXException {
+        numberLength = 0;
+        while(c != quote && c != -1 && !isWhitespace(c)) {
+            if(numberLength == MAX_NUMBER_LENGTH) throw error("A cost of the vertex " + idx + " is too long");
+            number[numberLength++] = (char) c;
+            c = next();
+        }
+        return c;
+    }
+
+    // a decimal number of at most 18 significant digits and a power of ten up to 22 (after the trailing zeros are
+    // removed) is converted exactly as by Double.parseDouble: both the digits and the power are exact doubles, so a
+    // single multiplication or division rounds correctly. Other numbers are left to Double.parseDouble.
+    private double toDouble() throws SAXException {
+        int i = 0;
+        boolean negative = false;
+        if(i < numberLength && (number[i] == '-' || number[i] == '+')) negative = number[i++] == '-';
+
+        long digits = 0;
+        int significant = 0, exponent = 0;
+        boolean any = false, fraction = false;
+        for(; i < numberLength; i++) {
+            char d = number[i];
+            if(d == '.' && !fraction) {
+                fraction = true;
+                continue;
+            }
+            if(d < '0' || d > '9') break;
+            any = true;
+            if(digits == 0 && d == '0') {
+                if(fraction) exponent--;
+                continue;
+            }
+            if(++significant > 18) return parseDouble();
+            digits = digits * 10 + (d - '0');
+            if(fraction) exponent--;
+        }
+        if(!any) return parseDouble();
+
+        if(i < numberLength) {
+            if(number[i] != 'e' && number[i] != 'E') return parseDouble();
+            i++;
+            boolean negativeExponent = false;
+            if(i < numberLength && (number[i] == '-' || number[i] == '+')) negativeExponent = number[i++] == '-';
+            if(i == numberLength || numberLength - i > 4) return parseDouble();
+            int e = 0;
+            for(; i < numberLength; i++) {
+                if(number[i] < '0' || number[i] > '9') return parseDouble();
+                e = e * 10 + (number[i] - '0');
+            }
+            exponent += negativeExponent ? -e : e;
+        }
+
+        if(digits == 0) return negative ? -0.0 : 0.0;
+        while(digits % 10 == 0) {
+            digits /= 10;
+            exponent++;
+        }
+        if(digits > (1L << 53) || exponent < -22 || exponent > 22) return parseDouble();
+        double value = exponent < 0 ? digits / POWERS_OF_TEN[-exponent] : digits * POWERS_OF_TEN[exponent];
+        return negative ? -value : value;
+    }
+
+    private double parseDouble() throws SAXException {
+        String entry = new String(number, 0, numberLength);
+        try {
+            return Double.parseDouble(entry);
+        } catch (NumberFormatException ex) {
+            throw new SAXException("Invalid cost \"" + entry + "\" of the vertex " + idx, ex);
+        }
+    }
+
+    private int skipWhitespace(int c) throws IOException {
+        while(isWhitespace(c)) c = next();
+        return c;
+    }
+
+    // returns the byte after the first occurrence of b at or after c.
+    private int skipTo(int c, int b) throws IOException {
+        while(c != b && c != -1) c = next();
+        return c == -1 ? -1 : next();
+    }
+
+    // returns the byte after the first occurrence of the terminator.
+    private int skipPast(@NotNull String terminator) throws IOException {
+        int matched = 0, c;
+        while((c = next()) != -1) {
+            if(c == terminator.charAt(matched)) {
+                if(++matched == terminator.length()) return next();
+            } else {
+                matched = c == terminator.charAt(0) ? 1 : 0;
+            }
+        }
+        return -1;
+    }
+
+    private static boolean isWhitespace(int c) {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    private SAXException error(@NotNull String message) {
+        return new SAXException(message + " (at the byte " + (bufferStart + buffer.position()) + ")");
+    }
+}
@@ -0,0 +1,66 @@
+package jo.ju.edu.tsp.core.xml;
+
+import jo.ju.edu.tsp.core.OverlayGraph;
+import jo.ju.edu.tsp.core.WeightedGraph;
+import jo.ju.edu.tsp.set.SetDetails;
+import org.jetbrains.annotations.NotNull;
+import org.xml.sax.SAXException;
+
+import javax.xml.parsers.ParserConfigurationException;
+import java.io.File;
+import java.io.IOException;
+import java.lang.ref.SoftReference;
+import java.util.HashMap;
+import java.util.Map;
+
+// The graphs loaded by Transformer.constructWeightedGraph in this JVM, so that repeated runs on the same set load it
+// once. A graph belongs to the file of the recorded modification time and length (and to the size, the name and the
+// candidate settings of the set); it is loaded again when the file changes. Every call returns a new OverlayGraph, which
+// gives the run its own soil and depth over the shared costs. The graphs are softly referenced, so the garbage
+// collector may drop them when memory runs out; -Dtsp.graph.cache=false loads the graph on every call.
+public final class GraphCache {
+    private static final String CACHE_PROPERTY = "tsp.graph.cache";
+    private static final Map<String, SoftReference<WeightedGraph>> GRAPHS = new HashMap<String, SoftReference<WeightedGraph>>();
+
+    private GraphCache() {
+    }
+
+    public static @NotNull WeightedGraph get(@NotNull SetDetails details) throws ParserConfigurationException, SAXException, IOException {
+        if(System.getProperty(CACHE_PROPERTY, "true").equalsIgnoreCase("false")) {
+            return new OverlayGraph(Transformer.constructWeightedGraph(details));
+        }
+        String key = getKey(details);
+        // a set is loaded by one thread at a time; the loaders use the common pool themselves.
+        synchronized (GRAPHS) {
+            SoftReference<WeightedGraph> reference = GRAPHS.get(key);
+            WeightedGraph graph = reference == null ? null : reference.get();
+            if(graph == null) {
+                graph = Transformer.constructWeightedGraph(details);
+                removeStale(details.getFile());
+                GRAPHS.put(key, new SoftReference<WeightedGraph>(graph));
+            }
+            return new OverlayGraph(graph);
+        }
+    }
+
+    public static void clear() {
+        synchronized (GRAPHS) {
+            GRAPHS.clear();
+        }
+    }
+
+    private static @NotNull String getKey(@NotNull SetDetails details) throws IOException {
+        return getVersion(details.getFile()) + details.getSize() + '|' + details.getName() + '|'
+                + Integer.getInteger(Transformer.CANDIDATES_PROPERTY, 0);
+    }
+
+    private static @NotNull String getVersion(@NotNull File file) throws IOException {
+        return file.getCanonicalPath() + '|' + file.lastModified() + '|' + file.length() + '|';
+    }
+
+    // the graphs of former versions of the file.
+    private static void removeStale(@NotNull File file) throws IOException {
+        String path = file.getCanonicalPath() + '|', version = getVersion(file);
+        GRAPHS.keySet().removeIf(key -> key.startsWith(path) && !key.startsWith(version));
+    }
+}
@@ -0,0 +1,68 @@
+package jo.ju.edu.tsp.core.xml;
+
+import jo.ju.edu.tsp.core.PackedGraph;
+import org.xml.sax.SAXException;
+
+// Builds a PackedGraph. TransformTSPLIB writes no loops for symmetric instances, so the first row decides the layout:
+// it is kept until its end and the graph is symmetric if it has no edge from the vertex 0 to itself. Of a symmetric
+// graph, only the lower triangle (the edges to smaller vertices) is stored.
+public class PackedGraphHandler extends EdgeHandler {
+    private final String name;
+    private final int size;
+    private final boolean singlePrecision;
+    private PackedGraph graph = null;
+    private int[] firstRowIds;
+    private double[] firstRowCosts;
+    private int firstRowSize = 0;
+
+    public PackedGraphHandler(int size, String name, boolean singlePrecision) {
+        this.name = name;
+        this.size = size;
+        this.singlePrecision = singlePrecision;
+        this.firstRowIds = new int[size];
+        this.firstRowCosts = new double[size];
+    }
+
+    @Override
+    protected void putEdge(int idx, int id, double cost) throws SAXException {
+        if(idx >= size || id >= size) return; // false information
+
+        if(graph == null) {
+            if(firstRowSize == size) throw new SAXException("The vertex " + idx + " has more than " + size + " edges");
+            firstRowIds[firstRowSize] = id;
+            firstRowCosts[firstRowSize++] = cost;
+        } else if(!graph.isSymmetric() || id < idx) {
+            graph.setCost(idx, id, cost);
+        }
+    }
+
+    @Override
+    protected void endVertex(int idx) {
+        if(graph == null) {
+            createGraph();
+        }
+    }
+
+    private void createGraph() {
+        boolean symmetric = true;
+        for(int e = 0; e < firstRowSize; e++) {
+            if(firstRowIds[e] == 0) symmetric = false;
+        }
+        graph = new PackedGraph(name, size, symmetric, singlePrecision);
+        // the first row has no edges to smaller vertices.
+        if(!symmetric) {
+            for(int e = 0; e < firstRowSize; e++) {
+                graph.setCost(0, firstRowIds[e], firstRowCosts[e]);
+            }
+        }
+        firstRowIds = null;
+        firstRowCosts = null;
+    }
+
+    public PackedGraph getGraph() {
+        if(graph == null) {
+            createGraph();
+        }
+        return graph;
+    }
+}
@@ -1,34 +1,262 @@
 package jo.ju.edu.tsp.core.xml;
 
+import jo.ju.edu.tsp.core.CoordinateGraph;
 import jo.ju.edu.tsp.core.Graph;
+import jo.ju.edu.tsp.core.GraphSnapshot;
+import jo.ju.edu.tsp.core.BinaryPageSource;
+import jo.ju.edu.tsp.core.CandidateGraph;
+import jo.ju.edu.tsp.core.MappedGraph;
+import jo.ju.edu.tsp.core.PackedGraph;
+import jo.ju.edu.tsp.core.PagedGraph;
 import jo.ju.edu.tsp.core.Vertex;
+import jo.ju.edu.tsp.core.WeightedGraph;
+import jo.ju.edu.tsp.core.tsplib.CandidateReader;
+import jo.ju.edu.tsp.core.tsplib.NativeTSPLIB;
+import jo.ju.edu.tsp.core.tsplib.TSPLIBReader;
 import jo.ju.edu.tsp.set.SetDetails;
 import org.jetbrains.annotations.NotNull;
 import org.xml.sax.SAXException;
 
 import javax.xml.parsers.*;
+import java.io.BufferedInputStream;
 import java.io.File;
+import java.io.FileInputStream;
 import java.io.IOException;
+import java.io.InputStream;
 import java.util.List;
+import java.util.concurrent.ForkJoinPool;
+import java.util.zip.GZIPInputStream;
 
 // We can handle HUGE XML
 public class Transformer {
+    // files ending with ".gz" are decompressed while they are parsed.
+    private static final String GZIP_EXTENSION = ".gz";
+    private static final int GZIP_BUFFER_SIZE = 1 << 16;
+    // TSPLIB files are read in process by libtsplib (see NativeTSPLIB) instead of being parsed as XML.
+    private static final String[] TSPLIB_EXTENSIONS = {".tsp", ".atsp"};
+    // binary instances are memory-mapped (see MappedGraph).
+    private static final String BINARY_EXTENSION = ".tspb";
+    // the budget of the row cache of a CoordinateGraph in MB (-Dtsp.rows.cache=0 computes every cost).
+    private static final String ROW_CACHE_PROPERTY = "tsp.rows.cache";
+    private static final int DEFAULT_ROW_CACHE = 64;
+    // -Dtsp.candidates=K restricts the solvers to candidate edges (see CandidateGraph): the ones of the candidate file
+    // next to the instance (NAME.cand), otherwise the K nearest neighbours of every vertex.
+    static final String CANDIDATES_PROPERTY = "tsp.candidates";
+    // the candidates of the graphs that need them (see withCandidates).
+    private static final int DEFAULT_CANDIDATES = 10;
+    private static final String CANDIDATE_EXTENSION = ".cand";
+    // -Dtsp.snapshots=DIR keeps binary snapshots of the parsed graphs (see GraphSnapshot) in DIR, by default in
+    // java.io.tmpdir/tsp-snapshots; -Dtsp.snapshots=false parses the file on every load.
+    private static final String SNAPSHOTS_PROPERTY = "tsp.snapshots";
+    // -Dtsp.xml.loader=scan (default) reads the graph with the EdgeScanner, =sax with a SAX parser.
+    private static final String LOADER_PROPERTY = "tsp.xml.loader";
+    // plain files of at least 64 MB are read by the common ForkJoinPool unless -Dtsp.xml.parallel=false.
+    private static final String PARALLEL_PROPERTY = "tsp.xml.parallel";
+    private static final long PARALLEL_THRESHOLD = 1 << 26;
+    // -Dtsp.paged=true reads plain XML files in pages of rows (see PagedGraph), =false parses them into a PackedGraph;
+    // by default (auto) a file whose costs would take more than half of the heap is paged.
+    private static final String PAGED_PROPERTY = "tsp.paged";
+    private static final int PAGE_ROWS = 256;
+    private static final int RESIDENT_PAGES = 16;
 
     public static @NotNull Graph constructGraph(@NotNull SetDetails details) throws ParserConfigurationException, SAXException, IOException {
         return constructGraph(details.getFile(), details.getName(), details.getSize());
     }
 
     public static @NotNull Graph constructGraph(@NotNull File fullPath, @NotNull String name, int size) throws ParserConfigurationException, SAXException, IOException {
+        if(isTSPLIBFile(fullPath)) {
+            return constructGraphFromTSPLIB(fullPath, name);
+        }
+
+        VertexHandler handler = new VertexHandler(size, name);
+        parse(fullPath, handler);
+        return handler.getGraph();
+    }
+
+    public static @NotNull PackedGraph constructPackedGraph(@NotNull SetDetails details) throws ParserConfigurationException, SAXException, IOException {
+        return constructPackedGraph(details.getFile(), details.getName(), details.getSize(), false);
+    }
+
+    // singlePrecision: the costs are kept as floats.
+    public static @NotNull PackedGraph constructPackedGraph(@NotNull File fullPath, @NotNull String name, int size, boolean singlePrecision) throws ParserConfigurationException, SAXException, IOException {
+        if(isTSPLIBFile(fullPath)) {
+            return constructPackedGraphFromTSPLIB(fullPath, name, singlePrecision);
+        }
+
+        PackedGraphHandler handler = new PackedGraphHandler(size, name, singlePrecision);
+        if(isParallel(fullPath)) {
+            EdgeScanner.scanInParallel(fullPath, handler, ForkJoinPool.commonPool());
+        } else {
+            parse(fullPath, handler);
+        }
+        return handler.getGraph();
+    }
+
+    // a binary instance is mapped, a TSPLIB file given by coordinates is read into a CoordinateGraph (with the costs of
+    // the XML files: exact for EUC_2D and CEIL_2D, rounded for ATT and GEO; and a row cache), any other file is read into
+    // a PackedGraph or mapped from its snapshot, or read in pages if it is too large for the heap (see isPaged). A graph
+    // without edge ids (a CoordinateGraph of more than 65536 vertices) or columns (a PagedGraph) is restricted to
+    // candidate edges even if tsp.candidates is not set.
+    public static @NotNull WeightedGraph constructWeightedGraph(@NotNull SetDetails details) throws ParserConfigurationException, SAXException, IOException {
+        return withCandidates(constructCompleteGraph(details), details.getFile());
+    }
+
+    private static @NotNull WeightedGraph constructCompleteGraph(@NotNull SetDetails details) throws ParserConfigurationException, SAXException, IOException {
+        if(details.getFile().getName().toLowerCase().endsWith(BINARY_EXTENSION)) {
+            return MappedGraph.open(details.getFile(), details.getName());
+        }
+        if(isTSPLIBFile(details.getFile())) {
+            int cacheMegabytes = Integer.getInteger(ROW_CACHE_PROPERTY, DEFAULT_ROW_CACHE);
+            CoordinateGraph graph = TSPLIBReader.readCoordinates(details.getFile(), details.getName(), false, cacheMegabytes);
+            if(graph != null) return graph;
+        }
+        if(isPaged(details.getFile(), details.getSize())) {
+            // open as long as the loaded graph is used; the prefetch thread is a daemon.
+            return openPagedGraph(details.getFile(), details.getName(), details.getSize(), PAGE_ROWS, RESIDENT_PAGES);
+        }
+        return constructSnapshottedGraph(details);
+    }
+
+    // a plain XML file (a binary instance is mapped off the heap, see MappedGraph) if tsp.paged says so.
+    private static boolean isPaged(@NotNull File fullPath, int size) {
+        String paged = System.getProperty(PAGED_PROPERTY, "auto");
+        String fileName = fullPath.getName().toLowerCase();
+        if(paged.equalsIgnoreCase("false") || fileName.endsWith(GZIP_EXTENSION) || fileName.endsWith(BINARY_EXTENSION)
+                || isTSPLIBFile(fullPath)) {
+            return false;
+        }
+        if(paged.equalsIgnoreCase("true")) return true;
+        if(!paged.equalsIgnoreCase("auto")) throw new IllegalArgumentException("Unknown " + PAGED_PROPERTY + ": " + paged);
+        // the lower triangle of a PackedGraph.
+        return (long) size * (size - 1) / 2 * Double.BYTES > Runtime.getRuntime().maxMemory() / 2;
+    }
+
+    // the snapshot of the file if there is one, otherwise the parsed graph, whose snapshot is written.
+    private static @NotNull WeightedGraph constructSnapshottedGraph(@NotNull SetDetails details) throws ParserConfigurationException, SAXException, IOException {
+        String directory = System.getProperty(SNAPSHOTS_PROPERTY, new File(System.getProperty("java.io.tmpdir"), "tsp-snapshots").getPath());
+        if(directory.equalsIgnoreCase("false")) return constructPackedGraph(details);
+
+        GraphSnapshot snapshot = GraphSnapshot.of(new File(directory), details.getFile());
+        MappedGraph mappedGraph = snapshot.open(details.getName(), details.getSize());
+        if(mappedGraph != null) return mappedGraph;
+        PackedGraph graph = constructPackedGraph(details);
+        try {
+            snapshot.write(graph);
+        } catch (IOException ex) {
+            // the snapshot only saves the parse of the next load.
+        }
+        return graph;
+    }
+
+    private static @NotNull WeightedGraph withCandidates(@NotNull WeightedGraph graph, @NotNull File fullPath) throws IOException {
+        int k = Integer.getInteger(CANDIDATES_PROPERTY, 0);
+        if(k <= 0 && (graph instanceof PagedGraph
+                || graph instanceof CoordinateGraph && !((CoordinateGraph) graph).hasEdgeIds())) {
+            k = DEFAULT_CANDIDATES;
+        }
+        if(k <= 0) return graph;
+        File candidates = getCandidateFile(fullPath);
+        if(candidates.isFile()) return CandidateReader.read(candidates, graph);
+        return CandidateGraph.ofNearestNeighbours(graph, k);
+    }
+
+    // NAME.cand next to NAME.xml, NAME.tsp.gz, ...
+    private static @NotNull File getCandidateFile(@NotNull File fullPath) {
+        String name = fullPath.getName();
+        if(name.toLowerCase().endsWith(GZIP_EXTENSION)) name = name.substring(0, name.length() - GZIP_EXTENSION.length());
+        int dot = name.lastIndexOf('.');
+        return new File(fullPath.getParentFile(), (dot < 0 ? name : name.substring(0, dot)) + CANDIDATE_EXTENSION);
+    }
+
+    // Opens a graph whose rows are read on demand in pages of rowsPerPage rows, at most residentPages of them kept (see
+    // PagedGraph), from a binary matrix or a plain XML file; the caller closes it.
+    public static @NotNull PagedGraph openPagedGraph(@NotNull File fullPath, @NotNull String name, int size, int rowsPerPage, int residentPages) throws IOException {
+        String fileName = fullPath.getName().toLowerCase();
+        if(fileName.endsWith(GZIP_EXTENSION)) {
+            throw new IOException(fullPath + " is compressed and cannot be read in pages");
+        }
+        PagedGraph.PageSource source = fileName.endsWith(BINARY_EXTENSION) ? new BinaryPageSource(fullPath) : new XMLPageSource(fullPath, size);
+        return new PagedGraph(name, source, rowsPerPage, residentPages, Math.min(2, residentPages - 1));
+    }
+
+    private static boolean isParallel(@NotNull File fullPath) {
+        return System.getProperty(LOADER_PROPERTY, "scan").equalsIgnoreCase("scan")
+                && !System.getProperty(PARALLEL_PROPERTY, "true").equalsIgnoreCase("false")
+                && !fullPath.getName().toLowerCase().endsWith(GZIP_EXTENSION)
+                && fullPath.length() >= PARALLEL_THRESHOLD
+                && ForkJoinPool.getCommonPoolParallelism() > 1;
+    }
+
+    private static void parse(@NotNull File fullPath, @NotNull EdgeHandler handler) throws ParserConfigurationException, SAXException, IOException {
+        String loader = System.getProperty(LOADER_PROPERTY, "scan");
+        if(loader.equalsIgnoreCase("scan")) {
+            EdgeScanner.scan(fullPath, handler);
+            return;
+        } else if(!loader.equalsIgnoreCase("sax")) {
+            throw new IllegalArgumentException("Unknown " + LOADER_PROPERTY + ": " + loader);
+        }
+
         SAXParserFactory spf = SAXParserFactory.newInstance();
         spf.setNamespaceAware(true);
 
         SAXParser saxParser = spf.newSAXParser();
         org.xml.sax.XMLReader reader = saxParser.getXMLReader();
-        VertexHandler handler = new VertexHandler(size, name);
         reader.setContentHandler(handler);
-        saxParser.parse(fullPath, handler);
+        if(fullPath.getName().toLowerCase().endsWith(GZIP_EXTENSION)) {
+            try(InputStream in = new GZIPInputStream(new BufferedInputStream(new FileInputStream(fullPath), GZIP_BUFFER_SIZE), GZIP_BUFFER_SIZE)) {
+                saxParser.parse(in, handler, fullPath.toURI().toString());
+            }
+        } else {
+            saxParser.parse(fullPath, handler);
+        }
+    }
 
-        return handler.getGraph();
+    // the same graph as the XML file written by TransformTSPLIB: no self loops for symmetric instances.
+    public static @NotNull Graph constructGraphFromTSPLIB(@NotNull File fullPath, @NotNull String name) throws IOException {
+        try(NativeTSPLIB instance = NativeTSPLIB.open(fullPath)) {
+            int n = instance.getDimension();
+            boolean symmetric = instance.isSymmetric();
+            double[] costs = instance.getCosts();
+            Graph graph = new Graph(n, name);
+            for(int i = 0; i < n; i++) {
+                for(int j = 0; j < n; j++) {
+                    if(symmetric && j == i) continue;
+                    Vertex v = new Vertex();
+                    v.setId(j);
+                    v.setCost(costs[i * n + j]);
+                    graph.put(i, v);
+                }
+            }
+            return graph;
+        }
+    }
+
+    public static @NotNull PackedGraph constructPackedGraphFromTSPLIB(@NotNull File fullPath, @NotNull String name, boolean singlePrecision) throws IOException {
+        try(NativeTSPLIB instance = NativeTSPLIB.open(fullPath)) {
+            int n = instance.getDimension();
+            if(instance.isSymmetric() && !singlePrecision) {
+                return PackedGraph.ofLowerCosts(name, n, instance.getLowerCosts());
+            }
+            PackedGraph graph = new PackedGraph(name, n, instance.isSymmetric(), singlePrecision);
+            double[] costs = instance.getCosts();
+            for(int i = 0; i < n; i++) {
+                for(int j = 0; j < n; j++) {
+                    if(!graph.isSymmetric() || j < i) graph.setCost(i, j, costs[i * n + j]);
+                }
+            }
+            return graph;
+        }
+    }
+
+    private static boolean isTSPLIBFile(@NotNull File file) {
+        String fileName = file.getName().toLowerCase();
+        if(fileName.endsWith(GZIP_EXTENSION)) {
+            fileName = fileName.substring(0, fileName.length() - GZIP_EXTENSION.length());
+        }
+        for(String extension : TSPLIB_EXTENSIONS) {
+            if(fileName.endsWith(extension)) return true;
+        }
+        return false;
     }
 
     public static @NotNull Graph constructGraph(@NotNull String fullPath, @NotNull String name, int size) throws ParserConfigurationException, SAXException, IOException {
@@ -50,6 +278,19 @@ public class Transformer {
         }
     }
 
+    // DON'T USE IT FOR BIG GRAPHS
+    public static void print(@NotNull WeightedGraph graph) {
+        System.out.println("Graph details:");
+        for (int i = 0; i < graph.getNumberOfVertices(); i++) {
+            System.out.print(i);
+            for(int k = 0; k < graph.getDegree(i); k++) {
+                int j = graph.getNeighbour(i, k);
+                System.out.print(" -> " + j + "(" + graph.getCost(i, j) + ")");
+            }
+            System.out.println();
+        }
+    }
+
     public static void main(String[] args) {
         try {
 
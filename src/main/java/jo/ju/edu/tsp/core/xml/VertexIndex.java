@@ -0,0 +1,136 @@
+package jo.ju.edu.tsp.core.xml;
+
+import org.jetbrains.annotations.NotNull;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.Future;
+
+// The byte offsets of the <vertex> elements of an XML file, which split the file into ranges that are parsed
+// independently. The offsets are kept in an index file next to the XML file (NAME.xml.vidx); it belongs to the file of
+// the recorded length and modification time and is recreated otherwise. Without a valid index the file is scanned for
+// "<vertex" in parallel, and the index is written if the directory is writable. A "<vertex" inside a comment would be
+// taken as an element.
+final class VertexIndex {
+    private static final String EXTENSION = ".vidx";
+    private static final int MAGIC = 0x56494458; // "VIDX"
+    private static final long PART_SIZE = 1 << 26;
+    private static final byte[] VERTEX = {'<', 'v', 'e', 'r', 't', 'e', 'x'};
+
+    private VertexIndex() {
+    }
+
+    static @NotNull long[] of(@NotNull File file, @NotNull ForkJoinPool pool) throws IOException {
+        File indexFile = new File(file.getPath() + EXTENSION);
+        long[] offsets = read(indexFile, file);
+        if(offsets != null) return offsets;
+
+        offsets = scan(file, pool);
+        try {
+            write(indexFile, file, offsets);
+        } catch (IOException ex) {
+            // the index only saves the scan of the next load.
+        }
+        return offsets;
+    }
+
+    private static long[] read(@NotNull File indexFile, @NotNull File file) throws IOException {
+        if(!indexFile.isFile()) return null;
+        try(DataInputStream in = new DataInputStream(new BufferedInputStream(new FileInputStream(indexFile)))) {
+            if(in.readInt() != MAGIC || in.readLong() != file.length() || in.readLong() != file.lastModified()) return null;
+            long[] offsets = new long[in.readInt()];
+            for(int i = 0; i < offsets.length; i++) {
+                offsets[i] = in.readLong();
+            }
+            return offsets;
+        }
+    }
+
+    private static void write(@NotNull File indexFile, @NotNull File file, @NotNull long[] offsets) throws IOException {
+        try(DataOutputStream out = new DataOutputStream(new BufferedOutputStream(new FileOutputStream(indexFile)))) {
+            out.writeInt(MAGIC);
+            out.writeLong(file.length());
+            out.writeLong(file.lastModified());
+            out.writeInt(offsets.length);
+            for(long offset : offsets) {
+                out.writeLong(offset);
+            }
+        }
+    }
+
+    // every part of PART_SIZE bytes is searched by a task for the elements starting in it.
+    private static @NotNull long[] scan(@NotNull File file, @NotNull ForkJoinPool pool) throws IOException {
+        try(RandomAccessFile raf = new RandomAccessFile(file, "r"); FileChannel channel = raf.getChannel()) {
+            long size = channel.size();
+            List<Callable<long[]>> tasks = new ArrayList<Callable<long[]>>();
+            for(long start = 0; start < size; start += PART_SIZE) {
+                final long partStart = start;
+                tasks.add(() -> scan(channel, partStart, Math.min(partStart + PART_SIZE, size), size));
+            }
+
+            List<long[]> parts = new ArrayList<long[]>(tasks.size());
+            int count = 0;
+            for(Future<long[]> future : pool.invokeAll(tasks)) {
+                long[] part = get(future);
+                parts.add(part);
+                count += part.length;
+            }
+
+            long[] offsets = new long[count];
+            int i = 0;
+            for(long[] part : parts) {
+                System.arraycopy(part, 0, offsets, i, part.length);
+                i += part.length;
+            }
+            return offsets;
+        }
+    }
+
+    // the offsets of the elements starting in [start, end).
+    private static @NotNull long[] scan(@NotNull FileChannel channel, long start, long end, long size) throws IOException {
+        // an element may reach into the next part.
+        long mapEnd = Math.min(end + VERTEX.length, size);
+        MappedByteBuffer buffer = channel.map(FileChannel.MapMode.READ_ONLY, start, mapEnd - start);
+        int length = (int) (end - start), limit = (int) (mapEnd - start);
+        long[] offsets = new long[16];
+        int count = 0;
+        for(int i = 0; i < length; i++) {
+            if(buffer.get(i) != '<' || i + VERTEX.length >= limit) continue;
+            int k = 1;
+            while(k < VERTEX.length && (buffer.get(i + k) | 0x20) == VERTEX[k]) k++;
+            if(k < VERTEX.length) continue;
+            int c = buffer.get(i + k);
+            if(c != ' ' && c != '\t' && c != '\r' && c != '\n' && c != '>' && c != '/') continue;
+            if(count == offsets.length) offsets = Arrays.copyOf(offsets, offsets.length * 2);
+            offsets[count++] = start + i;
+        }
+        return Arrays.copyOf(offsets, count);
+    }
+
+    private static <T> T get(@NotNull Future<T> future) throws IOException {
+        try {
+            return future.get();
+        } catch (InterruptedException ex) {
+            Thread.currentThread().interrupt();
+            throw new IOException("Interrupted while indexing the vertices", ex);
+        } catch (ExecutionException ex) {
+            if(ex.getCause() instanceof IOException) throw (IOException) ex.getCause();
+            throw new IOException(ex.getCause());
+        }
+    }
+}
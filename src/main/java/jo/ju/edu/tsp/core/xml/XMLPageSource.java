@@ -0,0 +1,86 @@
+package jo.ju.edu.tsp.core.xml;
+
+import jo.ju.edu.tsp.core.PagedGraph;
+import org.jetbrains.annotations.NotNull;
+import org.xml.sax.SAXException;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.channels.FileChannel;
+import java.util.Arrays;
+import java.util.concurrent.ForkJoinPool;
+
+// Reads the rows of a plain XML file for a PagedGraph: the offsets of the vertices (see VertexIndex) locate the rows of
+// a page, which are scanned alone. Every row holds the costs to all vertices, a missing edge costs 0 as in a
+// PackedGraph. Like PackedGraphHandler, the graph is symmetric if the first row has no edge from the vertex 0 to itself.
+final class XMLPageSource implements PagedGraph.PageSource {
+    private final File file;
+    private final RandomAccessFile raf;
+    private final FileChannel channel;
+    private final long[] offsets;
+    private final int numberOfVertices;
+    private final boolean symmetric;
+
+    XMLPageSource(@NotNull File file, int size) throws IOException {
+        this.file = file;
+        this.offsets = VertexIndex.of(file, ForkJoinPool.commonPool());
+        this.numberOfVertices = Math.min(size, offsets.length);
+        this.raf = new RandomAccessFile(file, "r");
+        this.channel = raf.getChannel();
+        try {
+            double[][] firstRow = {new double[numberOfVertices]};
+            boolean[] loop = {false};
+            if(numberOfVertices > 0) {
+                scan(0, firstRow, new EdgeHandler() {
+                    @Override
+                    protected void putEdge(int idx, int id, double cost) {
+                        if(idx == 0 && id == 0) loop[0] = true;
+                    }
+                });
+            }
+            this.symmetric = !loop[0];
+        } catch (IOException | RuntimeException ex) {
+            raf.close();
+            throw ex;
+        }
+    }
+
+    @Override
+    public int getNumberOfVertices() {
+        return numberOfVertices;
+    }
+
+    @Override
+    public boolean isSymmetric() {
+        return symmetric;
+    }
+
+    @Override
+    public void readRows(final int first, @NotNull final double[][] rows) throws IOException {
+        for(double[] row : rows) {
+            Arrays.fill(row, 0);
+        }
+        scan(first, rows, new EdgeHandler() {
+            @Override
+            protected void putEdge(int idx, int id, double cost) {
+                if(idx - first < rows.length && id < numberOfVertices) rows[idx - first][id] = cost; // false information
+            }
+        });
+    }
+
+    private void scan(int first, @NotNull double[][] rows, @NotNull EdgeHandler handler) throws IOException {
+        int last = first + rows.length;
+        long end = last < offsets.length ? offsets[last] : channel.size();
+        try {
+            EdgeScanner.scanRange(channel, handler, offsets[first], end, first);
+        } catch (SAXException ex) {
+            throw new IOException("Invalid rows " + first + " ... " + (last - 1) + " of " + file, ex);
+        }
+    }
+
+    @Override
+    public void close() throws IOException {
+        raf.close();
+    }
+}
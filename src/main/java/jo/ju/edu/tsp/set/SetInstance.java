@@ -3,6 +3,7 @@ package jo.ju.edu.tsp.set;
 import org.jetbrains.annotations.NotNull;
 
 import java.io.File;
+import java.net.URL;
 
 public class SetInstance {
     public final static SetDetails
@@ -33,8 +34,12 @@ public class SetInstance {
             xqc2175  = f("xqc2175", 2175, "xqc2175.xml");
 
 
+    // the XML file in dataset/must, or the TSPLIB file in elearning if there is none.
     private static @NotNull SetDetails f(@NotNull String name, int size, @NotNull String uri) {
-        return new SetDetails(new File(SetInstance.class.getClassLoader().getResource("dataset/must/" + uri).getFile()),
-                size, name);
+        URL url = SetInstance.class.getClassLoader().getResource("dataset/must/" + uri);
+        if(url == null) {
+            url = SetInstance.class.getClassLoader().getResource("elearning/" + name + ".tsp");
+        }
+        return new SetDetails(url == null ? new File("dataset/must/" + uri) : new File(url.getFile()), size, name);
     }
 }
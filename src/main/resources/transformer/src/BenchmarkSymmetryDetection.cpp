@@ -0,0 +1,173 @@
+/**
+ * @file BenchmarkSymmetryDetection.cpp
+ * Measures the checks at the end of a validated document (see
+ * ValidateSymmetry.hpp) against the former element-wise scan, on the
+ * matrix of a generated Euclidean instance: once symmetric and once
+ * with a single asymmetric pair in the middle of the matrix.
+ * Usage: BenchmarkSymmetryDetection [VERTICES [REPETITIONS]], by default
+ * 5000 vertices (at least 2) and 5 repetitions; the median time is printed.
+ *
+ * @brief Measures the symmetry detection of Validate.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "Statistics.hpp"
+#include "ValidateSymmetry.hpp"
+
+using namespace std;
+
+
+/**
+ * Largest difference of two equal entries.
+ */
+const double BENCHMARK_DOUBLE_ZERO = 1e-9;
+
+
+/**
+ * The former check: every pair (i, j), j < i, is looked up in both
+ * directions with checked indexing and the scan does not stop at an
+ * asymmetric pair.
+ * @param parsedEntries The parsed entries.
+ * @param adjacencyMatrix The matrix.
+ * @param failed Set to true if an entry is not parsed.
+ * @return True if the matrix is symmetric.
+ */
+bool isSymmetricElementWise(
+		const vector<vector<bool> > &parsedEntries,
+		const vector<vector<double> > &adjacencyMatrix,
+		bool &failed) {
+	bool isUndirected = true;
+	failed = false;
+	for (vector<vector<double> >::size_type i = 0; i < adjacencyMatrix.size(); i++) {
+		for (vector<double>::size_type j = 0; j < i; j++) {
+			if ((!parsedEntries.at(i).at(j)) || (!parsedEntries.at(j).at(i))) {
+				failed = true;
+				return (false);
+			}
+			if (abs(adjacencyMatrix.at(i).at(j) - adjacencyMatrix.at(j).at(i)) > BENCHMARK_DOUBLE_ZERO) {
+				isUndirected = false;
+			}
+		}
+	}
+	return (isUndirected);
+}
+
+/**
+ * The current check (see ValidateSymmetry.hpp).
+ * @param parsedEntries The parsed entries.
+ * @param adjacencyMatrix The matrix.
+ * @param failed Set to true if an entry is not parsed.
+ * @return True if the matrix is symmetric.
+ */
+bool isSymmetricBlocked(
+		const vector<vector<bool> > &parsedEntries,
+		const vector<vector<double> > &adjacencyMatrix,
+		bool &failed) {
+	failed = !areAllEntriesParsed(parsedEntries);
+	return ((!failed) && isSymmetricMatrix(adjacencyMatrix, BENCHMARK_DOUBLE_ZERO));
+}
+
+/**
+ * Returns the median time of a check in milliseconds.
+ * @param check The check.
+ * @param parsedEntries The parsed entries.
+ * @param adjacencyMatrix The matrix.
+ * @param repetitions Number of runs.
+ * @param result Set to the result of the check.
+ * @return The median time in milliseconds.
+ */
+double measure(
+		bool (*check)(const vector<vector<bool> > &, const vector<vector<double> > &, bool &),
+		const vector<vector<bool> > &parsedEntries,
+		const vector<vector<double> > &adjacencyMatrix,
+		const unsigned int repetitions,
+		bool &result) {
+	vector<double> times;
+	for (unsigned int r = 0; r < repetitions; r++) {
+		bool failed;
+		const double start = getMonotonicTime();
+		result = check(parsedEntries, adjacencyMatrix, failed);
+		times.push_back(1000.0 * (getMonotonicTime() - start));
+	}
+	sort(times.begin(), times.end());
+	return (times[times.size() / 2]);
+}
+
+/**
+ * Parses a positive number of the command line.
+ * @param argument The argument.
+ * @param value Set to the number.
+ * @return True if the argument is a positive number.
+ */
+bool parsePositive(const char *argument, unsigned int &value) {
+	istringstream in(argument);
+	return ((in >> value) && in.eof() && (value > 0));
+}
+
+/**
+ * The main function.
+ * @param argc Number of elements in the array argv.
+ * @param argv Name of the running program, the number of vertices and the
+ *   number of repetitions.
+ * @return
+ *   <ul>
+ *     <li>0 if both checks agree,</li>
+ *     <li>1 otherwise.</li>
+ *   </ul>
+ */
+int main(int argc, char *argv[]) {
+	unsigned int n = 5000;
+	unsigned int repetitions = 5;
+	if ((argc > 3) ||
+			((argc > 1) && (!parsePositive(argv[1], n) || (n < 2))) ||
+			((argc > 2) && !parsePositive(argv[2], repetitions))) {
+		cerr << "Usage: BenchmarkSymmetryDetection [VERTICES [REPETITIONS]]" << endl;
+		return (1);
+	}
+
+	//A random Euclidean instance in a square of 10^6 x 10^6 (fixed seed).
+	srand(1);
+	vector<double> x(n);
+	vector<double> y(n);
+	for (unsigned int i = 0; i < n; i++) {
+		x[i] = 1e6 * static_cast<double>(rand()) / RAND_MAX;
+		y[i] = 1e6 * static_cast<double>(rand()) / RAND_MAX;
+	}
+	vector<vector<double> > adjacencyMatrix(n, vector<double>(n));
+	vector<vector<bool> > parsedEntries(n, vector<bool>(n, true));
+	for (unsigned int i = 0; i < n; i++) {
+		for (unsigned int j = 0; j < n; j++) {
+			adjacencyMatrix[i][j] = sqrt((x[i] - x[j]) * (x[i] - x[j]) + (y[i] - y[j]) * (y[i] - y[j]));
+		}
+		parsedEntries[i][i] = false;
+	}
+
+	cout << "Symmetry detection, " << n << " vertices, median of " << repetitions << " runs:" << endl;
+	bool agree = true;
+	for (int asymmetric = 0; asymmetric <= 1; asymmetric++) {
+		if (asymmetric == 1) {
+			adjacencyMatrix[n / 2][n / 2 - 1] += 1.0;
+		}
+		bool elementWiseResult;
+		bool blockedResult;
+		const double elementWise = measure(
+				isSymmetricElementWise, parsedEntries, adjacencyMatrix, repetitions, elementWiseResult);
+		const double blocked = measure(
+				isSymmetricBlocked, parsedEntries, adjacencyMatrix, repetitions, blockedResult);
+		agree = agree && (elementWiseResult == blockedResult);
+		cout << fixed << setprecision(1) <<
+				"  " << ((asymmetric == 1) ? "asymmetric" : "symmetric ") <<
+				"  element-wise " << setw(8) << elementWise << " ms" <<
+				"  blocked " << setw(8) << blocked << " ms" <<
+				"  speed-up " << setprecision(2) << (elementWise / max(blocked, 1e-3)) << "x" <<
+				((elementWiseResult == blockedResult) ? "" : "  RESULTS DIFFER") << endl;
+	}
+	return (agree ? 0 : 1);
+}
@@ -0,0 +1,257 @@
+/**
+ * @file BinaryInstanceFormat.hpp
+ * Defines the binary instance format. A binary instance starts with a
+ * header of 32 bytes (all numbers are little endian):
+ * <ul>
+ *   <li>8 bytes: the magic "TSPBIN01",</li>
+ *   <li>4 bytes: the kind of the payload (coordinates, strictly lower
+ *     triangular matrix or full matrix),</li>
+ *   <li>4 bytes: the metric of the coordinates (0 for matrices),</li>
+ *   <li>8 bytes: the number of vertices n,</li>
+ *   <li>8 bytes: reserved (0).</li>
+ * </ul>
+ * The payload follows as IEEE 754 doubles:
+ * <ul>
+ *   <li>coordinates: x_1, y_1, ..., x_n, y_n,</li>
+ *   <li>strictly lower triangular matrix: the rows i = 1, ..., n - 1
+ *     with the columns j = 0, ..., i - 1,</li>
+ *   <li>full matrix: n rows with n columns.</li>
+ * </ul>
+ *
+ * @brief Defines the binary instance format.
+ */
+
+#ifndef _BinaryInstanceFormat_HPP_
+#define _BinaryInstanceFormat_HPP_
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+
+/**
+ * Filename extension for binary instances.
+ */
+const std::string BINARY_INSTANCE_FILENAME_EXTENSION = ".tspb";
+
+/**
+ * Magic of binary instances (identifies the format and its version).
+ */
+const std::string BINARY_INSTANCE_MAGIC = "TSPBIN01";
+
+/**
+ * Size of the header of binary instances in bytes.
+ */
+const std::streamsize BINARY_INSTANCE_HEADER_SIZE = 32;
+
+/**
+ * Kind of the payload: Coordinates of the vertices.
+ */
+const unsigned int BINARY_INSTANCE_KIND_COORDINATES = 1;
+
+/**
+ * Kind of the payload: Strictly lower triangular matrix of the costs.
+ */
+const unsigned int BINARY_INSTANCE_KIND_LOWER_MATRIX = 2;
+
+/**
+ * Kind of the payload: Full matrix of the costs.
+ */
+const unsigned int BINARY_INSTANCE_KIND_FULL_MATRIX = 3;
+
+/**
+ * Metric: The costs are given explicitly.
+ */
+const unsigned int BINARY_INSTANCE_METRIC_EXPLICIT = 0;
+
+/**
+ * Metric: "EUC_2D".
+ */
+const unsigned int BINARY_INSTANCE_METRIC_EUC_2D = 1;
+
+/**
+ * Metric: "CEIL_2D".
+ */
+const unsigned int BINARY_INSTANCE_METRIC_CEIL_2D = 2;
+
+/**
+ * Metric: "ATT".
+ */
+const unsigned int BINARY_INSTANCE_METRIC_ATT = 3;
+
+/**
+ * Metric: "GEO".
+ */
+const unsigned int BINARY_INSTANCE_METRIC_GEO = 4;
+
+
+/**
+ * Exception class used if a binary instance is not valid.
+ */
+class BinaryInstanceFormatInvalid : public std::exception {
+public:
+	/**
+	 * Constructor for the class BinaryInstanceFormatInvalid.
+	 */
+	inline BinaryInstanceFormatInvalid() {
+	}
+};
+
+
+/**
+ * Header of a binary instance.
+ */
+struct BinaryInstanceHeader {
+	/**
+	 * Kind of the payload.
+	 */
+	unsigned int kind;
+
+	/**
+	 * Metric of the coordinates.
+	 */
+	unsigned int metric;
+
+	/**
+	 * Number of vertices.
+	 */
+	unsigned long long n;
+
+	/**
+	 * Constructor for the struct BinaryInstanceHeader.
+	 * @param kind Kind of the payload.
+	 * @param metric Metric of the coordinates.
+	 * @param n Number of vertices.
+	 */
+	inline BinaryInstanceHeader(
+			const unsigned int kind = BINARY_INSTANCE_KIND_COORDINATES,
+			const unsigned int metric = BINARY_INSTANCE_METRIC_EXPLICIT,
+			const unsigned long long n = 0) {
+		this->kind = kind;
+		this->metric = metric;
+		this->n = n;
+	}
+};
+
+
+/**
+ * Encodes an unsigned number as little endian.
+ * @param value The number.
+ * @param bytes Number of bytes (at most 8).
+ * @param buffer Buffer of at least bytes bytes.
+ */
+inline void encodeLittleEndian(
+		const unsigned long long value,
+		const std::size_t bytes,
+		char *buffer) {
+	for (std::size_t i = 0; i < bytes; i++) {
+		buffer[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+	}
+}
+
+/**
+ * Decodes an unsigned number saved as little endian.
+ * @param buffer Buffer of at least bytes bytes.
+ * @param bytes Number of bytes (at most 8).
+ * @return The number.
+ */
+inline unsigned long long decodeLittleEndian(const char *buffer, const std::size_t bytes) {
+	unsigned long long value = 0;
+	for (std::size_t i = 0; i < bytes; i++) {
+		value |= static_cast<unsigned long long>(static_cast<unsigned char>(buffer[i])) << (8 * i);
+	}
+	return (value);
+}
+
+/**
+ * Encodes a double as little endian.
+ * @param value The double.
+ * @param buffer Buffer of at least 8 bytes.
+ */
+inline void encodeBinaryDouble(const double value, char *buffer) {
+	unsigned long long bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	encodeLittleEndian(bits, sizeof(bits), buffer);
+}
+
+/**
+ * Decodes a double saved as little endian.
+ * @param buffer Buffer of at least 8 bytes.
+ * @return The double.
+ */
+inline double decodeBinaryDouble(const char *buffer) {
+	const unsigned long long bits = decodeLittleEndian(buffer, 8);
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return (value);
+}
+
+/**
+ * Writes a double as little endian.
+ * @param out Output stream.
+ * @param value The double.
+ */
+inline void writeBinaryDouble(std::ostream &out, const double value) {
+	char buffer[8];
+	encodeBinaryDouble(value, buffer);
+	out.write(buffer, 8);
+}
+
+/**
+ * Reads a double saved as little endian.
+ * @param in Input stream.
+ * @return The double.
+ */
+inline double readBinaryDouble(std::istream &in) {
+	char buffer[8];
+	in.read(buffer, 8);
+	return (decodeBinaryDouble(buffer));
+}
+
+/**
+ * Writes the header of a binary instance.
+ * @param out Output stream.
+ * @param header The header.
+ */
+inline void writeBinaryInstanceHeader(std::ostream &out, const BinaryInstanceHeader &header) {
+	char buffer[BINARY_INSTANCE_HEADER_SIZE];
+	std::memset(buffer, 0, sizeof(buffer));
+	std::memcpy(buffer, BINARY_INSTANCE_MAGIC.data(), 8);
+	encodeLittleEndian(header.kind, 4, buffer + 8);
+	encodeLittleEndian(header.metric, 4, buffer + 12);
+	encodeLittleEndian(header.n, 8, buffer + 16);
+	out.write(buffer, BINARY_INSTANCE_HEADER_SIZE);
+}
+
+/**
+ * Reads the header of a binary instance.
+ * @param in Input stream.
+ * @return The header.
+ * @throws BinaryInstanceFormatInvalid if the header is not valid.
+ */
+inline BinaryInstanceHeader readBinaryInstanceHeader(std::istream &in) {
+	char buffer[BINARY_INSTANCE_HEADER_SIZE];
+	if (!in.read(buffer, BINARY_INSTANCE_HEADER_SIZE)) {
+		throw BinaryInstanceFormatInvalid();
+	}
+	if (std::memcmp(buffer, BINARY_INSTANCE_MAGIC.data(), 8) != 0) {
+		throw BinaryInstanceFormatInvalid();
+	}
+
+	BinaryInstanceHeader header(
+			static_cast<unsigned int>(decodeLittleEndian(buffer + 8, 4)),
+			static_cast<unsigned int>(decodeLittleEndian(buffer + 12, 4)),
+			decodeLittleEndian(buffer + 16, 8));
+	if (
+			(header.kind < BINARY_INSTANCE_KIND_COORDINATES) ||
+			(header.kind > BINARY_INSTANCE_KIND_FULL_MATRIX) ||
+			(header.metric > BINARY_INSTANCE_METRIC_GEO)) {
+		throw BinaryInstanceFormatInvalid();
+	}
+	return (header);
+}
+
+
+#endif
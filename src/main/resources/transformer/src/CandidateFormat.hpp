@@ -0,0 +1,46 @@
+/**
+ * @file CandidateFormat.hpp
+ * Defines the candidate format: a sparse text file which lists for every
+ * vertex its nearest neighbours together with the costs of the edges.
+ * The keywords follow the TSPLIB style:
+ * "NAME:", "TYPE:" (= "CANDIDATES"), "DIMENSION:", "CANDIDATES:" (the
+ * number k of neighbours per vertex), "CANDIDATE_SECTION", n lines of
+ * the form "i j_1 c_1 ... j_k c_k" (1-based vertices, the neighbours are
+ * sorted by increasing cost), "EOF".
+ *
+ * @brief Defines the candidate format.
+ */
+
+#ifndef _CandidateFormat_HPP_
+#define _CandidateFormat_HPP_
+
+#include <string>
+
+
+/**
+ * Filename extension for candidate files.
+ */
+const std::string CANDIDATE_FILENAME_EXTENSION = ".cand";
+
+/**
+ * Value for the tag "TYPE:" for candidate files.
+ */
+const std::string CANDIDATE_VALUE_TYPE = "CANDIDATES";
+
+/**
+ * Tag for candidate files: "CANDIDATES:" (the number of neighbours per vertex).
+ */
+const std::string CANDIDATE_TAG_CANDIDATES = "CANDIDATES:";
+
+/**
+ * Tag for candidate files: "CANDIDATE_SECTION".
+ */
+const std::string CANDIDATE_TAG_CANDIDATE_SECTION = "CANDIDATE_SECTION";
+
+/**
+ * Default number of neighbours per vertex.
+ */
+const unsigned int CANDIDATE_DEFAULT_K = 10;
+
+
+#endif
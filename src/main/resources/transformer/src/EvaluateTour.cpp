@@ -0,0 +1,268 @@
+/**
+ * @file EvaluateTour.cpp
+ * Evaluates tours of an instance of the symmetric travelling salesman
+ * problem given by coordinates: every tour is checked to be a
+ * permutation of the vertices, its length is computed directly from
+ * the coordinates (no matrix of the costs is created) and the gap to
+ * the optimum is reported. The optimum is taken from the command line
+ * ("--optimum=VALUE"), from the tag "BEST_KNOWN:" of the instance or
+ * from the optimal tour "NAME.opt.tour" next to the instance. Tours of
+ * an instance renumbered by TransformTSPLIB ("--renumber=...") are
+ * translated back with "--permutation=NAME.perm".
+ *
+ * @brief Evaluates tours of an travelling salesman problem instance.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+
+#include "EvaluateTourIO.hpp"
+#include "MetricKernels.hpp"
+#include "Statistics.hpp"
+
+using namespace std;
+
+
+/**
+ * Returns the name of the optimal tour file next to an instance
+ * ("eil76.tsp" -> "eil76.opt.tour").
+ * @param instanceFileName Name of the instance file.
+ * @return Name of the optimal tour file.
+ */
+string getOptimalTourFileName(const string &instanceFileName) {
+	const string::size_type dot = instanceFileName.rfind('.');
+	const string::size_type slash = instanceFileName.rfind('/');
+	if ((dot == string::npos) || ((slash != string::npos) && (dot < slash))) {
+		return (instanceFileName + OPTIMAL_TOUR_FILENAME_EXTENSION);
+	}
+	return (instanceFileName.substr(0, dot) + OPTIMAL_TOUR_FILENAME_EXTENSION);
+}
+
+/**
+ * Returns true if a file exists.
+ * @param fileName Name of the file.
+ * @return
+ *   <ul>
+ *     <li>true if the file exists,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool fileExists(const string &fileName) {
+	ifstream file(fileName.c_str());
+	return (file.good());
+}
+
+
+/**
+ * The main function.
+ * @param argc Number of elements in the array argv.
+ * @param argv Name of the running program, options (--exact, --optimum=VALUE,
+ *   --permutation=FILE, --stats, --stats=json), name of the instance file and names of the
+ *   tour files (the optimal tour next to the instance if there is none).
+ * @return
+ *   <ul>
+ *     <li>0 if all tours are valid,</li>
+ *     <li>1 otherwise.</li>
+ *   </ul>
+ */
+int main(int argc, char* argv[]) {
+	/*
+	 * Initialling.
+	 */
+	cout << "EvaluateTour.cpp:" << endl;
+	cout << "----------------------------------------------------------------" << endl;
+
+	vector<string> fileNames;
+	EvaluateTourOptions options;
+	try {
+		fileNames = parseCommandLineArguments(argc, argv, options);
+	}
+	catch (CommandLineArgumentsInvalid &e) {
+		cerr << "The command-line arguments are invalid!" << endl;
+		cerr << "Usage: EvaluateTour [--exact] [--optimum=VALUE] [--permutation=FILE] [--stats[=json]] INSTANCE.tsp [TOUR ...]" << endl;
+		return (1);
+	}
+
+	const string instanceFileName = fileNames[0];
+	const string optimalTourFileName = getOptimalTourFileName(instanceFileName);
+	vector<string> tourFileNames(fileNames.begin() + 1, fileNames.end());
+	if ((tourFileNames.empty()) && (fileExists(optimalTourFileName))) {
+		tourFileNames.push_back(optimalTourFileName);
+	}
+
+	//Writing the used filenames on the standard output
+	cout << "Instance file: " << instanceFileName << endl;
+	for (vector<string>::size_type i = 0; i < tourFileNames.size(); i++) {
+		cout << "Tour file: " << tourFileNames[i] << endl;
+	}
+
+	cout << endl;
+
+	Statistics *statistics = 0;
+	if (options.statisticsFormat != STATISTICS_NONE) {
+		statistics = new Statistics("EvaluateTour");
+	}
+
+
+	/*
+	 * Reading of the instance.
+	 */
+	cout << "Reading the file \"" << instanceFileName << "\" ... " << flush;
+
+	CoordinateInstance instance;
+	try {
+		readCoordinateInstance(instanceFileName, instance, statistics);
+	}
+	catch (InputFileInvalid &e) {
+		cerr << "the file \"" << instanceFileName << "\" is not valid! " << e.what() << endl;
+		delete statistics;
+		return (1);
+	}
+	catch (MetricNotSupported &e) {
+		cerr << "the costs of the file \"" << instanceFileName << "\" are not given by coordinates!" << endl;
+		delete statistics;
+		return (1);
+	}
+	catch (bad_alloc &e) {
+		cerr << "the instance is too large!" << endl;
+		delete statistics;
+		return (1);
+	}
+
+	cout << "OK" << endl;
+
+	const size_t n = instance.coordinates.getN();
+
+	vector<unsigned int> permutation;
+	if (!options.permutationFileName.empty()) {
+		cout << "Reading the file \"" << options.permutationFileName << "\" ... " << flush;
+		try {
+			readPermutation(options.permutationFileName, permutation, statistics);
+		}
+		catch (InputFileInvalid &e) {
+			cerr << "the file \"" << options.permutationFileName << "\" is not valid! " << e.what() << endl;
+			delete statistics;
+			return (1);
+		}
+		if (permutation.size() != n) {
+			cerr << "the permutation does not match the instance!" << endl;
+			delete statistics;
+			return (1);
+		}
+		cout << "OK" << endl;
+	}
+
+
+	/*
+	 * Determining the optimum.
+	 */
+	bool hasOptimum = true;
+	double optimum = 0.0;
+	string optimumSource;
+	if (options.hasOptimum) {
+		optimum = options.optimum;
+		optimumSource = "command line";
+	}
+	else if ((instance.hasBestKnown) && (options.rounded)) {
+		optimum = instance.bestKnown;
+		optimumSource = "BEST_KNOWN";
+	}
+	else if (fileExists(optimalTourFileName)) {
+		//The length of the optimal tour is computed with the same costs as the evaluated tours.
+		try {
+			vector<vector<unsigned int> > optimalTours;
+			readTours(optimalTourFileName, optimalTours, statistics);
+			string message;
+			hasOptimum =
+					(optimalTours.size() == 1) &&
+					(checkTour(optimalTours[0], n, message));
+			if (hasOptimum) {
+				optimum = instance.coordinates.getTourLength(optimalTours[0], options.rounded);
+				optimumSource = optimalTourFileName;
+			}
+		}
+		catch (InputFileInvalid &e) {
+			hasOptimum = false;
+		}
+	}
+	else {
+		hasOptimum = false;
+	}
+
+
+	/*
+	 * Evaluating of the tours.
+	 */
+	cout << "----------------------------------------------------------------" << endl;
+	cout << "Instance: " << instance.name << " (" << n << " vertices)" << endl;
+	cout << "Costs: " << (options.rounded ? "TSPLIB (rounded)" : "exact") << endl;
+	cout.setf(ios::fixed, ios::floatfield);
+	if (hasOptimum) {
+		cout << "Optimum: " << setprecision(options.rounded ? 0 : 6) << optimum <<
+				" (" << optimumSource << ")" << endl;
+	}
+	else {
+		cout << "Optimum: unknown" << endl;
+	}
+
+	bool allToursValid = true;
+	for (vector<string>::size_type f = 0; f < tourFileNames.size(); f++) {
+		vector<vector<unsigned int> > tours;
+		try {
+			readTours(tourFileNames[f], tours, statistics);
+		}
+		catch (InputFileInvalid &e) {
+			cerr << "The file \"" << tourFileNames[f] << "\" is not valid! " << e.what() << endl;
+			allToursValid = false;
+			continue;
+		}
+		catch (bad_alloc &e) {
+			cerr << "The tours of the file \"" << tourFileNames[f] << "\" are too large!" << endl;
+			allToursValid = false;
+			continue;
+		}
+
+		ScopedPhaseTimer evaluationTimer(statistics, PHASE_TOUR_EVALUATION);
+		for (vector<vector<unsigned int> >::size_type t = 0; t < tours.size(); t++) {
+			cout << tourFileNames[f];
+			if (tours.size() > 1) {
+				cout << " #" << t + 1;
+			}
+			cout << ": ";
+
+			if (!permutation.empty()) {
+				translateTour(permutation, tours[t]);
+			}
+			string message;
+			if (!checkTour(tours[t], n, message)) {
+				cout << "invalid (" << message << ")" << endl;
+				allToursValid = false;
+				continue;
+			}
+
+			const double length = instance.coordinates.getTourLength(tours[t], options.rounded);
+			if (statistics != 0) {
+				statistics->addEdges(n);
+			}
+			cout << "length " << setprecision(options.rounded ? 0 : 6) << length;
+			if (hasOptimum) {
+				cout << ", gap " << setprecision(4) << 100.0 * (length - optimum) / optimum << " %";
+			}
+			cout << endl;
+		}
+		evaluationTimer.stop();
+	}
+
+
+	/*
+	 * Printing the statistics.
+	 */
+	if (statistics != 0) {
+		cout << endl;
+		statistics->print(cout, options.statisticsFormat);
+		delete statistics;
+	}
+
+	return (allToursValid ? 0 : 1);
+}
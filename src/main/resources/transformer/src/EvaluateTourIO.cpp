@@ -0,0 +1,382 @@
+/**
+ * @file EvaluateTourIO.cpp
+ * Defines the functions and classes necessary for the IO of the tour
+ * evaluation. The files are read into memory at once and parsed with
+ * strtod/strtol, so instances with 100000 vertices are read in a few
+ * milliseconds.
+ *
+ * @brief Defines the functions necessary for the IO of the tour evaluation.
+ */
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "EvaluateTourIO.hpp"
+#include "PermutationFormat.hpp"
+
+using namespace std;
+
+
+std::vector<std::string> parseCommandLineArguments(int argc, char* argv[], EvaluateTourOptions &options) {
+	vector<string> fileNames;
+	for (int i = 1; i < argc; i++) {
+		const string argument = argv[i];
+		//The options have to precede the file names.
+		if ((!fileNames.empty()) || (argument.compare(0, 2, "--") != 0)) {
+			fileNames.push_back(argument);
+		}
+		else if (argument == COMMAND_LINE_OPTION_EXACT) {
+			options.rounded = false;
+		}
+		else if (argument.compare(0, COMMAND_LINE_OPTION_OPTIMUM.size(), COMMAND_LINE_OPTION_OPTIMUM) == 0) {
+			istringstream optimumIStringstream(argument.substr(COMMAND_LINE_OPTION_OPTIMUM.size()));
+			if ((!(optimumIStringstream >> options.optimum)) || (!optimumIStringstream.eof()) ||
+					(options.optimum <= 0.0)) {
+				throw CommandLineArgumentsInvalid();
+			}
+			options.hasOptimum = true;
+		}
+		else if (argument.compare(0, COMMAND_LINE_OPTION_PERMUTATION.size(), COMMAND_LINE_OPTION_PERMUTATION) == 0) {
+			options.permutationFileName = argument.substr(COMMAND_LINE_OPTION_PERMUTATION.size());
+			if (options.permutationFileName.empty()) {
+				throw CommandLineArgumentsInvalid();
+			}
+		}
+		else if (!parseStatisticsOption(argument, options.statisticsFormat)) {
+			throw CommandLineArgumentsInvalid();
+		}
+	}
+
+	if (fileNames.empty()) {
+		throw CommandLineArgumentsInvalid();
+	}
+	return (fileNames);
+}
+
+
+/**
+ * Reads a whole file into memory. The content is terminated by '\0',
+ * so it can be parsed by strtod and strtol.
+ * @param fileName Name of the file.
+ * @param content Content of the file.
+ * @param statistics Statistics of the run (can be 0).
+ * @throws InputFileInvalid if the file cannot be read.
+ */
+void readFileContent(const string &fileName, vector<char> &content, Statistics *statistics) {
+	ifstream inputFile(fileName.c_str(), ios::in | ios::binary);
+	if (!inputFile) {
+		throw InputFileInvalid("The file does not exist!");
+	}
+	inputFile.seekg(0, ios::end);
+	const streamoff size = inputFile.tellg();
+	inputFile.seekg(0, ios::beg);
+	if (size < 0) {
+		throw InputFileInvalid("The file cannot be read!");
+	}
+	content.resize(static_cast<vector<char>::size_type>(size) + 1);
+	if (!inputFile.read(&content[0], static_cast<streamsize>(size))) {
+		throw InputFileInvalid("The file cannot be read!");
+	}
+	content[static_cast<vector<char>::size_type>(size)] = '\0';
+	if (statistics != 0) {
+		statistics->addBytesRead(static_cast<unsigned long long>(size));
+	}
+}
+
+/**
+ * Returns the next line of a '\0'-terminated text without the leading
+ * and the trailing white spaces.
+ * @param position Position in the text; moved behind the line.
+ * @param line The line.
+ * @return
+ *   <ul>
+ *     <li>true if a line was read,</li>
+ *     <li>false at the end of the text.</li>
+ *   </ul>
+ */
+bool getTrimmedLine(const char *&position, string &line) {
+	if (*position == '\0') {
+		return (false);
+	}
+	const char *end = position;
+	while ((*end != '\0') && (*end != '\n')) {
+		end++;
+	}
+	const char *begin = position;
+	position = (*end == '\0') ? end : end + 1;
+	while ((begin < end) && (isspace(static_cast<unsigned char>(*begin)))) {
+		begin++;
+	}
+	while ((begin < end) && (isspace(static_cast<unsigned char>(*(end - 1))))) {
+		end--;
+	}
+	line.assign(begin, end);
+	return (true);
+}
+
+/**
+ * Splits a line of the specification part into the keyword and the
+ * value ("KEY: value", "KEY : value" or "KEY").
+ * @param line The line.
+ * @param key The keyword.
+ * @param value The value (empty if there is none).
+ */
+void splitSpecification(const string &line, string &key, string &value) {
+	const string::size_type colon = line.find(':');
+	key = line.substr(0, colon);
+	value = (colon == string::npos) ? "" : line.substr(colon + 1);
+	while ((!key.empty()) && (isspace(static_cast<unsigned char>(key[key.size() - 1])))) {
+		key.erase(key.size() - 1);
+	}
+	while ((!value.empty()) && (isspace(static_cast<unsigned char>(value[0])))) {
+		value.erase(0, 1);
+	}
+}
+
+void readCoordinateInstance(
+		const std::string &fileName,
+		CoordinateInstance &instance,
+		Statistics *statistics) {
+	ScopedPhaseTimer parsingTimer(statistics, PHASE_PARSING);
+
+	vector<char> content;
+	readFileContent(fileName, content, statistics);
+
+	//Specification part.
+	const char *position = &content[0];
+	string line;
+	string key;
+	string value;
+	unsigned long n = 0;
+	bool hasMetric = false;
+	for (;;) {
+		if (!getTrimmedLine(position, line)) {
+			throw InputFileInvalid("The keyword \"NODE_COORD_SECTION\" is missing!");
+		}
+		if (line.empty()) {
+			continue;
+		}
+		splitSpecification(line, key, value);
+		if (key == "NAME") {
+			instance.name = value;
+		}
+		else if (key == "COMMENT") {
+			instance.comment += (instance.comment.empty() ? "" : " ") + value;
+		}
+		else if (key == "TYPE") {
+			if (value != "TSP") {
+				throw InputFileInvalid("Only instances of the type \"TSP\" are supported!");
+			}
+		}
+		else if (key == "DIMENSION") {
+			char *end;
+			n = strtoul(value.c_str(), &end, 10);
+			if ((value.empty()) || (*end != '\0') || (n < 1)) {
+				throw InputFileInvalid("The dimension is not valid!");
+			}
+		}
+		else if (key == "EDGE_WEIGHT_TYPE") {
+			instance.coordinates.setMetric(getMetric(value));
+			hasMetric = true;
+		}
+		else if (key == "BEST_KNOWN") {
+			char *end;
+			instance.bestKnown = strtod(value.c_str(), &end);
+			if ((value.empty()) || (*end != '\0')) {
+				throw InputFileInvalid("The best known length is not valid!");
+			}
+			instance.hasBestKnown = true;
+		}
+		else if (key == "NODE_COORD_SECTION") {
+			break;
+		}
+		else if ((key == "EOF") || (key.find("_SECTION") != string::npos)) {
+			throw InputFileInvalid("The keyword \"" + key + "\" is not supported!");
+		}
+	}
+	if ((n == 0) || (!hasMetric)) {
+		throw InputFileInvalid("The keyword \"DIMENSION\" or \"EDGE_WEIGHT_TYPE\" is missing!");
+	}
+
+	//NODE_COORD_SECTION.
+	instance.coordinates.reserve(n);
+	for (unsigned long i = 0; i < n; i++) {
+		char *end;
+		const unsigned long j = strtoul(position, &end, 10);
+		if ((end == position) || (j != i + 1)) {
+			throw InputFileInvalid("The vertices are not numbered consecutively!");
+		}
+		position = end;
+		const double x = strtod(position, &end);
+		if (end == position) {
+			throw InputFileInvalid("A coordinate is not valid!");
+		}
+		position = end;
+		const double y = strtod(position, &end);
+		if (end == position) {
+			throw InputFileInvalid("A coordinate is not valid!");
+		}
+		position = end;
+		instance.coordinates.addVertex(x, y);
+	}
+}
+
+void readTours(
+		const std::string &fileName,
+		std::vector<std::vector<unsigned int> > &tours,
+		Statistics *statistics) {
+	ScopedPhaseTimer parsingTimer(statistics, PHASE_PARSING);
+
+	vector<char> content;
+	readFileContent(fileName, content, statistics);
+
+	//Specification part.
+	const char *position = &content[0];
+	string line;
+	string key;
+	string value;
+	for (;;) {
+		if (!getTrimmedLine(position, line)) {
+			throw InputFileInvalid("The keyword \"TOUR_SECTION\" is missing!");
+		}
+		if (line.empty()) {
+			continue;
+		}
+		splitSpecification(line, key, value);
+		if (key == "TYPE") {
+			if (value != "TOUR") {
+				throw InputFileInvalid("Only files of the type \"TOUR\" are supported!");
+			}
+		}
+		else if (key == "TOUR_SECTION") {
+			break;
+		}
+	}
+
+	//TOUR_SECTION: tours terminated by -1 up to "EOF" or the end of the file.
+	vector<unsigned int> tour;
+	for (;;) {
+		while (isspace(static_cast<unsigned char>(*position))) {
+			position++;
+		}
+		if ((*position == '\0') || (*position == 'E')) {
+			break;
+		}
+		char *end;
+		const long vertex = strtol(position, &end, 10);
+		if (end == position) {
+			throw InputFileInvalid("A vertex of a tour is not valid!");
+		}
+		position = end;
+		if (vertex == -1) {
+			tours.push_back(vector<unsigned int>());
+			tours.back().swap(tour);
+		}
+		else if (vertex < 1) {
+			throw InputFileInvalid("A vertex of a tour is not valid!");
+		}
+		else {
+			tour.push_back(static_cast<unsigned int>(vertex - 1));
+		}
+	}
+	//The terminating -1 is optional for the last tour.
+	if (!tour.empty()) {
+		tours.push_back(vector<unsigned int>());
+		tours.back().swap(tour);
+	}
+}
+
+void readPermutation(
+		const std::string &fileName,
+		std::vector<unsigned int> &permutation,
+		Statistics *statistics) {
+	ScopedPhaseTimer parsingTimer(statistics, PHASE_PARSING);
+
+	vector<char> content;
+	readFileContent(fileName, content, statistics);
+
+	//Specification part.
+	const char *position = &content[0];
+	string line;
+	string key;
+	string value;
+	unsigned long n = 0;
+	for (;;) {
+		if (!getTrimmedLine(position, line)) {
+			throw InputFileInvalid("The keyword \"" + PERMUTATION_TAG_PERMUTATION_SECTION + "\" is missing!");
+		}
+		if (line.empty()) {
+			continue;
+		}
+		splitSpecification(line, key, value);
+		if (key == "TYPE") {
+			if (value != PERMUTATION_VALUE_TYPE) {
+				throw InputFileInvalid("Only files of the type \"" + PERMUTATION_VALUE_TYPE + "\" are supported!");
+			}
+		}
+		else if (key == "DIMENSION") {
+			char *end;
+			n = strtoul(value.c_str(), &end, 10);
+			if ((value.empty()) || (*end != '\0') || (n < 1)) {
+				throw InputFileInvalid("The dimension is not valid!");
+			}
+		}
+		else if (key == PERMUTATION_TAG_PERMUTATION_SECTION) {
+			break;
+		}
+	}
+	if (n == 0) {
+		throw InputFileInvalid("The keyword \"DIMENSION\" is missing!");
+	}
+
+	//PERMUTATION_SECTION.
+	permutation.resize(n);
+	vector<bool> used(n, false);
+	for (unsigned long i = 0; i < n; i++) {
+		char *end;
+		const unsigned long vertex = strtoul(position, &end, 10);
+		if ((end == position) || (vertex < 1) || (vertex > n) || (used[vertex - 1])) {
+			throw InputFileInvalid("The file does not contain a permutation!");
+		}
+		position = end;
+		used[vertex - 1] = true;
+		permutation[i] = static_cast<unsigned int>(vertex - 1);
+	}
+}
+
+void translateTour(const std::vector<unsigned int> &permutation, std::vector<unsigned int> &tour) {
+	for (vector<unsigned int>::size_type i = 0; i < tour.size(); i++) {
+		if (tour[i] < permutation.size()) {
+			tour[i] = permutation[tour[i]];
+		}
+	}
+}
+
+bool checkTour(const std::vector<unsigned int> &tour, const std::size_t n, std::string &message) {
+	if (tour.size() != n) {
+		ostringstream messageOStringstream;
+		messageOStringstream << "the tour has " << tour.size() << " vertices instead of " << n;
+		message = messageOStringstream.str();
+		return (false);
+	}
+
+	vector<bool> visited(n, false);
+	for (vector<unsigned int>::size_type i = 0; i < tour.size(); i++) {
+		if (tour[i] >= n) {
+			ostringstream messageOStringstream;
+			messageOStringstream << "the vertex " << tour[i] + 1 << " does not exist";
+			message = messageOStringstream.str();
+			return (false);
+		}
+		if (visited[tour[i]]) {
+			ostringstream messageOStringstream;
+			messageOStringstream << "the vertex " << tour[i] + 1 << " is visited twice";
+			message = messageOStringstream.str();
+			return (false);
+		}
+		visited[tour[i]] = true;
+	}
+	return (true);
+}
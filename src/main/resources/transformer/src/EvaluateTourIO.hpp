@@ -0,0 +1,259 @@
+/**
+ * @file EvaluateTourIO.hpp
+ * Defines the functions and classes necessary for the IO of the tour
+ * evaluation: reading of TSPLIB instances given by coordinates and of
+ * TSPLIB tour files.
+ *
+ * @brief Defines the functions necessary for the IO of the tour evaluation.
+ */
+
+#ifndef _EvaluateTourIO_HPP_
+#define _EvaluateTourIO_HPP_
+
+#include <string>
+#include <vector>
+
+#include "MetricKernels.hpp"
+#include "Statistics.hpp"
+
+
+/**
+ * Filename extension for the optimal tours from the TSPLIB.
+ */
+const std::string OPTIMAL_TOUR_FILENAME_EXTENSION = ".opt.tour";
+
+/**
+ * Command-line option: The exact distances are used instead of the
+ * rounded TSPLIB costs.
+ */
+const std::string COMMAND_LINE_OPTION_EXACT = "--exact";
+
+/**
+ * Command-line option: Length of the optimal tour.
+ */
+const std::string COMMAND_LINE_OPTION_OPTIMUM = "--optimum=";
+
+/**
+ * Command-line option: Permutation file of a renumbered instance; the
+ * tours are translated back to the original numbers of the vertices.
+ */
+const std::string COMMAND_LINE_OPTION_PERMUTATION = "--permutation=";
+
+
+/**
+ * Exception class used if the command-line arguments are invalid.
+ */
+class CommandLineArgumentsInvalid : public std::exception {
+public:
+	/**
+	 * Constructor for the class CommandLineArgumentsInvalid.
+	 */
+	inline CommandLineArgumentsInvalid() {
+	}
+};
+
+/**
+ * Exception class used if an input file is not valid.
+ */
+class InputFileInvalid : public std::exception {
+private:
+	/**
+	 * Description of the problem.
+	 */
+	std::string message;
+
+public:
+	/**
+	 * Constructor for the class InputFileInvalid.
+	 * @param message Description of the problem.
+	 */
+	inline InputFileInvalid(const std::string &message) {
+		this->message = message;
+	}
+
+	/**
+	 * Destructor for the class InputFileInvalid.
+	 */
+	inline ~InputFileInvalid() throw() {
+	}
+
+	/**
+	 * Returns the description of the problem.
+	 * @return Description of the problem.
+	 */
+	inline const char *what() const throw() {
+		return (message.c_str());
+	}
+};
+
+
+/**
+ * Options of the tour evaluation given on the command line.
+ */
+struct EvaluateTourOptions {
+	/**
+	 * True if the costs should be rounded as defined by the TSPLIB.
+	 */
+	bool rounded;
+
+	/**
+	 * True if the length of the optimal tour is given on the command line.
+	 */
+	bool hasOptimum;
+
+	/**
+	 * Length of the optimal tour given on the command line.
+	 */
+	double optimum;
+
+	/**
+	 * Name of the permutation file (empty if the tours are not translated).
+	 */
+	std::string permutationFileName;
+
+	/**
+	 * Format of the printed statistics.
+	 */
+	StatisticsFormat statisticsFormat;
+
+	/**
+	 * Constructor for the struct EvaluateTourOptions.
+	 */
+	inline EvaluateTourOptions() {
+		rounded = true;
+		hasOptimum = false;
+		optimum = 0.0;
+		statisticsFormat = STATISTICS_NONE;
+	}
+};
+
+/**
+ * Instance of the symmetric travelling salesman problem given by coordinates.
+ */
+struct CoordinateInstance {
+	/**
+	 * Name of the instance.
+	 */
+	std::string name;
+
+	/**
+	 * Comment of the instance.
+	 */
+	std::string comment;
+
+	/**
+	 * Coordinates of the vertices.
+	 */
+	Coordinates coordinates;
+
+	/**
+	 * True if the instance contains the length of the best known tour.
+	 */
+	bool hasBestKnown;
+
+	/**
+	 * Length of the best known tour (tag "BEST_KNOWN:").
+	 */
+	double bestKnown;
+
+	/**
+	 * Constructor for the struct CoordinateInstance.
+	 */
+	inline CoordinateInstance() {
+		hasBestKnown = false;
+		bestKnown = 0.0;
+	}
+};
+
+
+/**
+ * Parses the command-line arguments. The options have to precede
+ * the file names. The recognized options are:
+ * <ul>
+ *   <li>"--exact" The exact distances are used instead of the rounded
+ *     TSPLIB costs.</li>
+ *   <li>"--optimum=VALUE" The gap is computed to the given length.</li>
+ *   <li>"--permutation=FILE" The tours belong to the instance renumbered
+ *     by TransformTSPLIB and are translated back by the permutation file.</li>
+ *   <li>"--stats" or "--stats=json" The statistics of the run are printed
+ *     as a table or as one line of JSON.</li>
+ * </ul>
+ * @param argc Number of elements in the array argv.
+ * @param argv Name of the running program, options, name of the instance
+ *   file and names of the tour files.
+ * @param options Parsed options.
+ * @return Name of the instance file followed by the names of the tour files.
+ * @throws CommandLineArgumentsInvalid if the arguments are not valid.
+ */
+std::vector<std::string> parseCommandLineArguments(int argc, char* argv[], EvaluateTourOptions &options);
+
+/**
+ * Reads an instance given by coordinates ("EDGE_WEIGHT_TYPE:" "EUC_2D",
+ * "CEIL_2D", "ATT" or "GEO"). Unlike the reader of TransformTSPLIB, the
+ * keywords of the specification part may appear in any order, in the
+ * form "KEY: value" or "KEY : value"; unknown keywords are ignored.
+ * @param fileName Name of the file.
+ * @param instance The read instance.
+ * @param statistics Statistics of the run (can be 0).
+ * @throws InputFileInvalid if the file cannot be read or is not valid.
+ * @throws MetricNotSupported if the costs are not given by coordinates.
+ */
+void readCoordinateInstance(
+		const std::string &fileName,
+		CoordinateInstance &instance,
+		Statistics *statistics = 0);
+
+/**
+ * Reads the tours of a TSPLIB tour file. The "TOUR_SECTION" contains
+ * the vertices (1-based) of a tour terminated by -1. Further tours
+ * terminated by -1 may follow in the same section, so one file can
+ * hold a whole batch of candidate tours. The vertices are returned
+ * 0-based; the tours are not checked.
+ * @param fileName Name of the file.
+ * @param tours The read tours.
+ * @param statistics Statistics of the run (can be 0).
+ * @throws InputFileInvalid if the file cannot be read or is not valid.
+ */
+void readTours(
+		const std::string &fileName,
+		std::vector<std::vector<unsigned int> > &tours,
+		Statistics *statistics = 0);
+
+/**
+ * Reads a permutation file written by TransformTSPLIB (see
+ * PermutationFormat.hpp).
+ * @param fileName Name of the file.
+ * @param permutation The read permutation: the i-th element is the
+ *   original number of the vertex i (both 0-based).
+ * @param statistics Statistics of the run (can be 0).
+ * @throws InputFileInvalid if the file cannot be read or is not a permutation.
+ */
+void readPermutation(
+		const std::string &fileName,
+		std::vector<unsigned int> &permutation,
+		Statistics *statistics = 0);
+
+/**
+ * Translates a tour of a renumbered instance back to the original
+ * numbers of the vertices. Vertices without an original number are
+ * left unchanged, so checkTour reports them.
+ * @param permutation The permutation read by readPermutation.
+ * @param tour The tour (0-based vertices).
+ */
+void translateTour(const std::vector<unsigned int> &permutation, std::vector<unsigned int> &tour);
+
+/**
+ * Checks that a tour is a permutation of all vertices.
+ * @param tour The tour (0-based vertices).
+ * @param n Number of vertices.
+ * @param message Description of the problem if the tour is not valid.
+ * @return
+ *   <ul>
+ *     <li>true if the tour is valid,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool checkTour(const std::vector<unsigned int> &tour, const std::size_t n, std::string &message);
+
+
+#endif
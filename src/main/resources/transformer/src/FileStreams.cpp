@@ -0,0 +1,321 @@
+/**
+ * @file FileStreams.cpp
+ * Defines file streams with transparent gzip compression.
+ *
+ * @brief Defines file streams with transparent gzip compression.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "FileStreams.hpp"
+
+using namespace std;
+
+
+/**
+ * Window bits of zlib for the gzip format (15 bits of the window + 16).
+ */
+const int GZIP_WINDOW_BITS = 15 + 16;
+
+/**
+ * Window bits of zlib which detect the gzip or the zlib format (15 bits of the window + 32).
+ */
+const int GZIP_AUTOMATIC_WINDOW_BITS = 15 + 32;
+
+/**
+ * Memory level of zlib (the default).
+ */
+const int GZIP_MEMORY_LEVEL = 8;
+
+
+bool isGzipFileName(const std::string &fileName) {
+	if (fileName.size() < GZIP_FILENAME_EXTENSION.size() + 1) {
+		return (false);
+	}
+	string fileNameExtension = fileName.substr(fileName.size() - GZIP_FILENAME_EXTENSION.size());
+	transform(fileNameExtension.begin(), fileNameExtension.end(), fileNameExtension.begin(), ::tolower);
+	return (fileNameExtension == GZIP_FILENAME_EXTENSION);
+}
+
+std::string removeGzipFilenameExtension(const std::string &fileName) {
+	if (isGzipFileName(fileName)) {
+		return (fileName.substr(0, fileName.size() - GZIP_FILENAME_EXTENSION.size()));
+	}
+	return (fileName);
+}
+
+
+GzipOutputStreambuf::GzipOutputStreambuf() : inputBuffer(GZIP_BUFFER_SIZE), outputBuffer(GZIP_BUFFER_SIZE) {
+	file = 0;
+	memset(&stream, 0, sizeof(stream));
+}
+
+GzipOutputStreambuf::~GzipOutputStreambuf() {
+	close();
+}
+
+bool GzipOutputStreambuf::open(const std::string &fileName) {
+	if (file != 0) {
+		return (false);
+	}
+	memset(&stream, 0, sizeof(stream));
+	if (deflateInit2(
+			&stream,
+			GZIP_COMPRESSION_LEVEL,
+			Z_DEFLATED,
+			GZIP_WINDOW_BITS,
+			GZIP_MEMORY_LEVEL,
+			Z_DEFAULT_STRATEGY) != Z_OK) {
+		return (false);
+	}
+	file = fopen(fileName.c_str(), "wb");
+	if (file == 0) {
+		deflateEnd(&stream);
+		return (false);
+	}
+	setp(&inputBuffer[0], &inputBuffer[0] + inputBuffer.size());
+	return (true);
+}
+
+bool GzipOutputStreambuf::compress(const int flush) {
+	stream.next_in = reinterpret_cast<Bytef *>(pbase());
+	stream.avail_in = static_cast<uInt>(pptr() - pbase());
+	int result;
+	do {
+		stream.next_out = reinterpret_cast<Bytef *>(&outputBuffer[0]);
+		stream.avail_out = static_cast<uInt>(outputBuffer.size());
+		result = deflate(&stream, flush);
+		if (result == Z_STREAM_ERROR) {
+			return (false);
+		}
+		const size_t size = outputBuffer.size() - stream.avail_out;
+		if ((size > 0) && (fwrite(&outputBuffer[0], 1, size, file) != size)) {
+			return (false);
+		}
+	} while ((stream.avail_out == 0) || ((flush == Z_FINISH) && (result != Z_STREAM_END)));
+	setp(&inputBuffer[0], &inputBuffer[0] + inputBuffer.size());
+	return (true);
+}
+
+GzipOutputStreambuf::int_type GzipOutputStreambuf::overflow(int_type c) {
+	if ((file == 0) || (!compress(Z_NO_FLUSH))) {
+		return (traits_type::eof());
+	}
+	if (!traits_type::eq_int_type(c, traits_type::eof())) {
+		*pptr() = traits_type::to_char_type(c);
+		pbump(1);
+	}
+	return (traits_type::not_eof(c));
+}
+
+int GzipOutputStreambuf::sync() {
+	if ((file == 0) || (!compress(Z_NO_FLUSH))) {
+		return (-1);
+	}
+	return (0);
+}
+
+bool GzipOutputStreambuf::close() {
+	if (file == 0) {
+		return (false);
+	}
+	bool succeeded = compress(Z_FINISH);
+	deflateEnd(&stream);
+	if (fclose(file) != 0) {
+		succeeded = false;
+	}
+	file = 0;
+	setp(0, 0);
+	return (succeeded);
+}
+
+
+GzipInputStreambuf::GzipInputStreambuf() : inputBuffer(GZIP_BUFFER_SIZE), outputBuffer(GZIP_BUFFER_SIZE) {
+	file = 0;
+	source = 0;
+	position = 0;
+	memberComplete = false;
+	memset(&stream, 0, sizeof(stream));
+}
+
+GzipInputStreambuf::~GzipInputStreambuf() {
+	close();
+}
+
+bool GzipInputStreambuf::open(const std::string &fileName) {
+	if (isOpen()) {
+		return (false);
+	}
+	memset(&stream, 0, sizeof(stream));
+	if (inflateInit2(&stream, GZIP_AUTOMATIC_WINDOW_BITS) != Z_OK) {
+		return (false);
+	}
+	file = fopen(fileName.c_str(), "rb");
+	if (file == 0) {
+		inflateEnd(&stream);
+		return (false);
+	}
+	position = 0;
+	memberComplete = false;
+	setg(&outputBuffer[0], &outputBuffer[0], &outputBuffer[0]);
+	return (true);
+}
+
+bool GzipInputStreambuf::open(std::streambuf *source) {
+	if ((isOpen()) || (source == 0)) {
+		return (false);
+	}
+	memset(&stream, 0, sizeof(stream));
+	if (inflateInit2(&stream, GZIP_AUTOMATIC_WINDOW_BITS) != Z_OK) {
+		return (false);
+	}
+	this->source = source;
+	position = 0;
+	memberComplete = false;
+	setg(&outputBuffer[0], &outputBuffer[0], &outputBuffer[0]);
+	return (true);
+}
+
+GzipInputStreambuf::int_type GzipInputStreambuf::underflow() {
+	if (gptr() < egptr()) {
+		return (traits_type::to_int_type(*gptr()));
+	}
+	if (!isOpen()) {
+		return (traits_type::eof());
+	}
+	position += egptr() - eback();
+
+	stream.next_out = reinterpret_cast<Bytef *>(&outputBuffer[0]);
+	stream.avail_out = static_cast<uInt>(outputBuffer.size());
+	while (stream.avail_out == outputBuffer.size()) {
+		if (stream.avail_in == 0) {
+			size_t size;
+			if (source != 0) {
+				size = static_cast<size_t>(
+						source->sgetn(&inputBuffer[0], static_cast<streamsize>(inputBuffer.size())));
+			}
+			else {
+				size = fread(&inputBuffer[0], 1, inputBuffer.size(), file);
+			}
+			if (size == 0) {
+				if ((file != 0) && (ferror(file))) {
+					throw ios::failure("The compressed file cannot be read!");
+				}
+				if (!memberComplete) {
+					throw ios::failure("The compressed file is truncated!");
+				}
+				break;
+			}
+			stream.next_in = reinterpret_cast<Bytef *>(&inputBuffer[0]);
+			stream.avail_in = static_cast<uInt>(size);
+		}
+
+		const int result = inflate(&stream, Z_NO_FLUSH);
+		if (result == Z_STREAM_END) {
+			//Another gzip member may follow.
+			memberComplete = true;
+			inflateReset(&stream);
+		}
+		else if (result == Z_OK) {
+			memberComplete = false;
+		}
+		else if (result != Z_BUF_ERROR) {
+			throw ios::failure("The compressed file is damaged!");
+		}
+	}
+
+	const size_t size = outputBuffer.size() - stream.avail_out;
+	setg(&outputBuffer[0], &outputBuffer[0], &outputBuffer[0] + size);
+	if (size == 0) {
+		return (traits_type::eof());
+	}
+	return (traits_type::to_int_type(*gptr()));
+}
+
+void GzipInputStreambuf::close() {
+	if (!isOpen()) {
+		return;
+	}
+	inflateEnd(&stream);
+	if (file != 0) {
+		fclose(file);
+	}
+	file = 0;
+	source = 0;
+	setg(0, 0, 0);
+}
+
+
+InputFileStream::InputFileStream() : std::istream(0) {
+	//Like std::ifstream, a closed stream is in a good state.
+	rdbuf(&fileBuffer);
+}
+
+void InputFileStream::open(const std::string &fileName) {
+	bool opened;
+	if (isGzipFileName(fileName)) {
+		opened = gzipBuffer.open(fileName);
+		rdbuf(&gzipBuffer);
+	}
+	else {
+		opened = (fileBuffer.open(fileName.c_str(), ios::in) != 0);
+		rdbuf(&fileBuffer);
+	}
+	if (!opened) {
+		setstate(ios::failbit);
+	}
+}
+
+bool InputFileStream::is_open() const {
+	return ((fileBuffer.is_open()) || (gzipBuffer.isOpen()));
+}
+
+void InputFileStream::close() {
+	if (fileBuffer.is_open()) {
+		fileBuffer.close();
+	}
+	gzipBuffer.close();
+}
+
+
+OutputFileStream::OutputFileStream() : std::ostream(0) {
+	//Like std::ofstream, a closed stream is in a good state.
+	rdbuf(&fileBuffer);
+}
+
+void OutputFileStream::open(const std::string &fileName, const bool binary) {
+	bool opened;
+	if (isGzipFileName(fileName)) {
+		opened = gzipBuffer.open(fileName);
+		rdbuf(&gzipBuffer);
+	}
+	else {
+		ios::openmode mode = ios::out | ios::trunc;
+		if (binary) {
+			mode |= ios::binary;
+		}
+		opened = (fileBuffer.open(fileName.c_str(), mode) != 0);
+		rdbuf(&fileBuffer);
+	}
+	if (!opened) {
+		setstate(ios::failbit);
+	}
+}
+
+bool OutputFileStream::is_open() const {
+	return ((fileBuffer.is_open()) || (gzipBuffer.isOpen()));
+}
+
+void OutputFileStream::close() {
+	bool succeeded = true;
+	if (fileBuffer.is_open()) {
+		succeeded = (fileBuffer.close() != 0);
+	}
+	else if (gzipBuffer.isOpen()) {
+		succeeded = gzipBuffer.close();
+	}
+	if (!succeeded) {
+		setstate(ios::badbit);
+	}
+}
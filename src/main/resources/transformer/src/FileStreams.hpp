@@ -0,0 +1,424 @@
+/**
+ * @file FileStreams.hpp
+ * Defines file streams which compress and decompress files with the
+ * filename extension ".gz" transparently (gzip, via zlib). Other files
+ * are read and written unchanged. The data are compressed and
+ * decompressed in blocks while they are streamed, so the whole file
+ * is never held in memory.
+ *
+ * @brief Defines file streams with transparent gzip compression.
+ */
+
+#ifndef _FileStreams_HPP_
+#define _FileStreams_HPP_
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+
+/**
+ * Filename extension for gzip-compressed files.
+ */
+const std::string GZIP_FILENAME_EXTENSION = ".gz";
+
+/**
+ * Compression level of written gzip files (1 = fastest, 9 = smallest).
+ */
+const int GZIP_COMPRESSION_LEVEL = 6;
+
+/**
+ * Size of the buffers of the compressed and the decompressed data in bytes.
+ */
+const std::size_t GZIP_BUFFER_SIZE = 1 << 16;
+
+
+/**
+ * Returns true if the name of a file ends with the filename extension
+ * ".gz" (case insensitive).
+ * @param fileName Name of the file.
+ * @return
+ *   <ul>
+ *     <li>true if the file is gzip-compressed,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool isGzipFileName(const std::string &fileName);
+
+/**
+ * Returns the name of a file without the filename extension ".gz".
+ * @param fileName Name of the file.
+ * @return Name of the file without the filename extension ".gz".
+ */
+std::string removeGzipFilenameExtension(const std::string &fileName);
+
+
+/**
+ * Stream buffer which compresses the written data to a gzip file.
+ * The data are passed to zlib whenever the buffer is full or the
+ * stream is flushed (without a zlib flush, which would cost
+ * compression); everything is written to the file by close.
+ */
+class GzipOutputStreambuf : public std::streambuf {
+private:
+	/**
+	 * The compressed file (0 if it is not open or read from a source).
+	 */
+	std::FILE *file;
+
+	/**
+	 * Stream buffer the compressed data are read from instead of a file
+	 * (0 if it is not open or read from a file, not owned).
+	 */
+	std::streambuf *source;
+
+	/**
+	 * State of the compression.
+	 */
+	z_stream stream;
+
+	/**
+	 * Buffer of the data to be compressed.
+	 */
+	std::vector<char> inputBuffer;
+
+	/**
+	 * Buffer of the compressed data.
+	 */
+	std::vector<char> outputBuffer;
+
+	/**
+	 * Compresses the data in the buffer.
+	 * @param flush Flush mode of zlib (Z_NO_FLUSH or Z_FINISH).
+	 * @return
+	 *   <ul>
+	 *     <li>true if succeeded,</li>
+	 *     <li>false otherwise.</li>
+	 *   </ul>
+	 */
+	bool compress(const int flush);
+
+	/**
+	 * Not implemented copy constructor for the class GzipOutputStreambuf.
+	 * @param gzipOutputStreambuf Instance to be copied.
+	 */
+	GzipOutputStreambuf(const GzipOutputStreambuf &gzipOutputStreambuf);
+
+	/**
+	 * Not implemented operator "=".
+	 * @param gzipOutputStreambuf Right side of the operator.
+	 * @return Left side of the operator.
+	 */
+	GzipOutputStreambuf &operator=(const GzipOutputStreambuf &gzipOutputStreambuf);
+
+protected:
+	/**
+	 * Compresses the full buffer and stores the character.
+	 * @param c The character.
+	 * @return The character or EOF if the compression failed.
+	 */
+	virtual int_type overflow(int_type c);
+
+	/**
+	 * Compresses the data in the buffer.
+	 * @return 0 if succeeded, -1 otherwise.
+	 */
+	virtual int sync();
+
+public:
+	/**
+	 * Constructor for the class GzipOutputStreambuf.
+	 */
+	GzipOutputStreambuf();
+
+	/**
+	 * Destructor for the class GzipOutputStreambuf. Closes the file.
+	 */
+	virtual ~GzipOutputStreambuf();
+
+	/**
+	 * Opens a file.
+	 * @param fileName Name of the file.
+	 * @return
+	 *   <ul>
+	 *     <li>true if succeeded,</li>
+	 *     <li>false otherwise.</li>
+	 *   </ul>
+	 */
+	bool open(const std::string &fileName);
+
+	/**
+	 * Returns true if the file is open.
+	 * @return
+	 *   <ul>
+	 *     <li>true if the file is open,</li>
+	 *     <li>false otherwise.</li>
+	 *   </ul>
+	 */
+	inline bool isOpen() const {
+		return (file != 0);
+	}
+
+	/**
+	 * Compresses the rest of the data and closes the file.
+	 * @return
+	 *   <ul>
+	 *     <li>true if succeeded,</li>
+	 *     <li>false otherwise.</li>
+	 *   </ul>
+	 */
+	bool close();
+};
+
+
+/**
+ * Stream buffer which decompresses a gzip file. Concatenated gzip
+ * members are read one after the other, as by gunzip.
+ */
+class GzipInputStreambuf : public std::streambuf {
+private:
+	/**
+	 * The compressed file (0 if it is not open or read from a source).
+	 */
+	std::FILE *file;
+
+	/**
+	 * Stream buffer the compressed data are read from instead of a file
+	 * (0 if it is not open or read from a file, not owned).
+	 */
+	std::streambuf *source;
+
+	/**
+	 * State of the decompression.
+	 */
+	z_stream stream;
+
+	/**
+	 * Buffer of the compressed data.
+	 */
+	std::vector<char> inputBuffer;
+
+	/**
+	 * Buffer of the decompressed data.
+	 */
+	std::vector<char> outputBuffer;
+
+	/**
+	 * Number of the bytes already decompressed before the current buffer.
+	 */
+	std::streamoff position;
+
+	/**
+	 * True if the last gzip member has been decompressed completely.
+	 */
+	bool memberComplete;
+
+	/**
+	 * Not implemented copy constructor for the class GzipInputStreambuf.
+	 * @param gzipInputStreambuf Instance to be copied.
+	 */
+	GzipInputStreambuf(const GzipInputStreambuf &gzipInputStreambuf);
+
+	/**
+	 * Not implemented operator "=".
+	 * @param gzipInputStreambuf Right side of the operator.
+	 * @return Left side of the operator.
+	 */
+	GzipInputStreambuf &operator=(const GzipInputStreambuf &gzipInputStreambuf);
+
+protected:
+	/**
+	 * Decompresses the next block of the file.
+	 * @return The next character or EOF at the end of the file.
+	 * @throws std::ios::failure if the file is damaged or truncated.
+	 */
+	virtual int_type underflow();
+
+public:
+	/**
+	 * Constructor for the class GzipInputStreambuf.
+	 */
+	GzipInputStreambuf();
+
+	/**
+	 * Destructor for the class GzipInputStreambuf. Closes the file.
+	 */
+	virtual ~GzipInputStreambuf();
+
+	/**
+	 * Opens a file.
+	 * @param fileName Name of the file.
+	 * @return
+	 *   <ul>
+	 *     <li>true if succeeded,</li>
+	 *     <li>false otherwise.</li>
+	 *   </ul>
+	 */
+	bool open(const std::string &fileName);
+
+	/**
+	 * Opens a stream buffer the compressed data are read from. The
+	 * stream buffer is not closed by the method close.
+	 * @param source The compressed data.
+	 * @return
+	 *   <ul>
+	 *     <li>true if succeeded,</li>
+	 *     <li>false otherwise.</li>
+	 *   </ul>
+	 */
+	bool open(std::streambuf *source);
+
+	/**
+	 * Returns true if the file is open.
+	 * @return
+	 *   <ul>
+	 *     <li>true if the file is open,</li>
+	 *     <li>false otherwise.</li>
+	 *   </ul>
+	 */
+	inline bool isOpen() const {
+		return ((file != 0) || (source != 0));
+	}
+
+	/**
+	 * Returns the number of the decompressed bytes read from the buffer.
+	 * @return Number of the read decompressed bytes.
+	 */
+	inline std::streamoff getPosition() const {
+		return (position + (gptr() - eback()));
+	}
+
+	/**
+	 * Closes the file.
+	 */
+	void close();
+};
+
+
+/**
+ * Input file stream which decompresses files with the filename
+ * extension ".gz". The interface follows std::ifstream.
+ */
+class InputFileStream : public std::istream {
+private:
+	/**
+	 * Buffer of uncompressed files.
+	 */
+	std::filebuf fileBuffer;
+
+	/**
+	 * Buffer of compressed files.
+	 */
+	GzipInputStreambuf gzipBuffer;
+
+	/**
+	 * Not implemented copy constructor for the class InputFileStream.
+	 * @param inputFileStream Instance to be copied.
+	 */
+	InputFileStream(const InputFileStream &inputFileStream);
+
+	/**
+	 * Not implemented operator "=".
+	 * @param inputFileStream Right side of the operator.
+	 * @return Left side of the operator.
+	 */
+	InputFileStream &operator=(const InputFileStream &inputFileStream);
+
+public:
+	/**
+	 * Constructor for the class InputFileStream.
+	 */
+	InputFileStream();
+
+	/**
+	 * Opens a file. The failbit is set if the file cannot be opened.
+	 * @param fileName Name of the file.
+	 */
+	void open(const std::string &fileName);
+
+	/**
+	 * Returns true if the file is open.
+	 * @return
+	 *   <ul>
+	 *     <li>true if the file is open,</li>
+	 *     <li>false otherwise.</li>
+	 *   </ul>
+	 */
+	bool is_open() const;
+
+	/**
+	 * Closes the file.
+	 */
+	void close();
+};
+
+
+/**
+ * Output file stream which compresses files with the filename
+ * extension ".gz". The interface follows std::ofstream.
+ */
+class OutputFileStream : public std::ostream {
+private:
+	/**
+	 * Buffer of uncompressed files.
+	 */
+	std::filebuf fileBuffer;
+
+	/**
+	 * Buffer of compressed files.
+	 */
+	GzipOutputStreambuf gzipBuffer;
+
+	/**
+	 * Not implemented copy constructor for the class OutputFileStream.
+	 * @param outputFileStream Instance to be copied.
+	 */
+	OutputFileStream(const OutputFileStream &outputFileStream);
+
+	/**
+	 * Not implemented operator "=".
+	 * @param outputFileStream Right side of the operator.
+	 * @return Left side of the operator.
+	 */
+	OutputFileStream &operator=(const OutputFileStream &outputFileStream);
+
+public:
+	/**
+	 * Constructor for the class OutputFileStream.
+	 */
+	OutputFileStream();
+
+	/**
+	 * Opens a file. The failbit is set if the file cannot be opened.
+	 * @param fileName Name of the file.
+	 * @param binary True if an uncompressed file should be opened in the
+	 *   binary mode (compressed files are always binary).
+	 */
+	void open(const std::string &fileName, const bool binary = false);
+
+	/**
+	 * Returns true if the file is open.
+	 * @return
+	 *   <ul>
+	 *     <li>true if the file is open,</li>
+	 *     <li>false otherwise.</li>
+	 *   </ul>
+	 */
+	bool is_open() const;
+
+	/**
+	 * Closes the file. The badbit is set if the rest of the data
+	 * cannot be written.
+	 */
+	void close();
+};
+
+
+#endif
@@ -0,0 +1,705 @@
+/**
+ * @file GenerateTSPLIB.cpp
+ * Generates large synthetic instances of the symmetric travelling
+ * salesman problem in the style of the DIMACS TSP challenge:
+ * <ul>
+ *   <li>"uniform": the cities are uniformly distributed in the square
+ *     [0, 1000000) x [0, 1000000) (instances E1k, ..., E10M),</li>
+ *   <li>"clustered": n / 10 centers are uniformly distributed in the
+ *     square, every city is normally distributed around a random center
+ *     with the standard deviation 1000000 / sqrt(n) (instances C1k, ...),</li>
+ *   <li>"grid": the cities form a regular grid in the square
+ *     (instances G1k, ...).</li>
+ * </ul>
+ * All coordinates are integers and the metric is "EUC_2D". The
+ * instance is determined by the kind, n and the seed. The format of the
+ * output is determined by the filename extension of the output file:
+ * <ul>
+ *   <li>".tsp": TSPLIB file readable by TransformTSPLIB,</li>
+ *   <li>".tspb": binary instance (see BinaryInstanceFormat.hpp),</li>
+ *   <li>".cand": sparse file with the k nearest neighbours of every
+ *     city (see CandidateFormat.hpp).</li>
+ * </ul>
+ * The ".tsp" and ".tspb" files are streamed city by city in O(1)
+ * memory. The ".cand" files need the coordinates of all cities and a
+ * bucket grid, i.e. O(n) memory.
+ *
+ * @brief Generates large synthetic instances of the travelling
+ *   salesman problem.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "BinaryInstanceFormat.hpp"
+#include "CandidateFormat.hpp"
+
+using namespace std;
+
+
+/**
+ * Filename extension for the symmetric travelling salesman problem files from the TSPLIB.
+ */
+const string OUTPUT_FILE_FILENAME_EXTENSION_TSP = ".tsp";
+
+/**
+ * Command-line option: Kind of the instance.
+ */
+const string COMMAND_LINE_OPTION_KIND = "--kind=";
+
+/**
+ * Command-line option: Seed of the random number generator.
+ */
+const string COMMAND_LINE_OPTION_SEED = "--seed=";
+
+/**
+ * Command-line option: Number of neighbours per city in candidate files.
+ */
+const string COMMAND_LINE_OPTION_KNN = "--knn=";
+
+/**
+ * Kind of the instance: uniformly distributed cities.
+ */
+const string KIND_UNIFORM = "uniform";
+
+/**
+ * Kind of the instance: clustered cities.
+ */
+const string KIND_CLUSTERED = "clustered";
+
+/**
+ * Kind of the instance: cities on a grid.
+ */
+const string KIND_GRID = "grid";
+
+/**
+ * Edge length of the square containing the cities.
+ */
+const double SQUARE_SIZE = 1000000.0;
+
+/**
+ * Number of cities per cluster of clustered instances.
+ */
+const unsigned long long CITIES_PER_CLUSTER = 10;
+
+/**
+ * The number pi (M_PI is not available in the strict ANSI mode).
+ */
+const double PI = 3.14159265358979323846;
+
+/**
+ * Default seed of the random number generator.
+ */
+const unsigned long long DEFAULT_SEED = 0;
+
+
+/**
+ * Exception class used if the command-line arguments are invalid.
+ */
+class CommandLineArgumentsInvalid : public std::exception {
+public:
+	/**
+	 * Constructor for the class CommandLineArgumentsInvalid.
+	 */
+	inline CommandLineArgumentsInvalid() {
+	}
+};
+
+
+/**
+ * Mixes a 64-bit number (the finalizer of the SplitMix64 generator).
+ * @param x The number.
+ * @return The mixed number.
+ */
+inline unsigned long long mix(unsigned long long x) {
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return (x ^ (x >> 31));
+}
+
+/**
+ * Pseudorandom number generator SplitMix64. The generator is fully
+ * determined by its seed, so every instance can be reproduced.
+ */
+class RandomNumberGenerator {
+private:
+	/**
+	 * State of the generator.
+	 */
+	unsigned long long state;
+
+public:
+	/**
+	 * Constructor for the class RandomNumberGenerator.
+	 * @param seed Seed of the generator.
+	 */
+	inline RandomNumberGenerator(const unsigned long long seed) {
+		state = seed;
+	}
+
+	/**
+	 * Returns the next pseudorandom number.
+	 * @return Pseudorandom number from [0, 2^64).
+	 */
+	inline unsigned long long next() {
+		state += 0x9e3779b97f4a7c15ULL;
+		return (mix(state));
+	}
+
+	/**
+	 * Returns the next pseudorandom double.
+	 * @return Pseudorandom double from [0, 1).
+	 */
+	inline double nextDouble() {
+		return (static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0));
+	}
+
+	/**
+	 * Returns the next pseudorandom integer.
+	 * @param bound Upper bound.
+	 * @return Pseudorandom integer from [0, bound).
+	 */
+	inline unsigned long long nextInteger(const unsigned long long bound) {
+		return (static_cast<unsigned long long>(nextDouble() * static_cast<double>(bound)));
+	}
+
+	/**
+	 * Returns the next normally distributed pseudorandom double (Box-Muller).
+	 * @return Normally distributed pseudorandom double (mean 0, standard deviation 1).
+	 */
+	inline double nextGaussian() {
+		double u = nextDouble();
+		while (u <= 0.0) {
+			u = nextDouble();
+		}
+		const double v = nextDouble();
+		return (sqrt(-2.0 * log(u)) * cos(2.0 * PI * v));
+	}
+};
+
+
+/**
+ * Generates the cities of one instance one after the other.
+ */
+class CityGenerator {
+private:
+	/**
+	 * Kind of the instance.
+	 */
+	string kind;
+
+	/**
+	 * Number of cities.
+	 */
+	unsigned long long n;
+
+	/**
+	 * Seed of the instance.
+	 */
+	unsigned long long seed;
+
+	/**
+	 * Generator of the cities.
+	 */
+	RandomNumberGenerator random;
+
+	/**
+	 * Number of the cluster centers (clustered instances only).
+	 */
+	unsigned long long numberOfCenters;
+
+	/**
+	 * Number of the columns of the grid (grid instances only).
+	 */
+	unsigned long long gridColumns;
+
+	/**
+	 * Distance of two neighbouring grid points (grid instances only).
+	 */
+	double gridSpacing;
+
+	/**
+	 * Index of the next city.
+	 */
+	unsigned long long nextCity;
+
+	/**
+	 * Returns one coordinate of a cluster center. The centers are not
+	 * saved; they are derived from the seed, so the memory stays O(1).
+	 * @param center Index of the center.
+	 * @param coordinate 0 for x, 1 for y.
+	 * @return The coordinate.
+	 */
+	inline double getCenterCoordinate(
+			const unsigned long long center,
+			const unsigned long long coordinate) const {
+		const unsigned long long hash = mix(mix(seed ^ 0x636c757374657273ULL) + 2 * center + coordinate);
+		return (floor(static_cast<double>(hash >> 11) * (1.0 / 9007199254740992.0) * SQUARE_SIZE));
+	}
+
+public:
+	/**
+	 * Constructor for the class CityGenerator.
+	 * @param kind Kind of the instance.
+	 * @param n Number of cities.
+	 * @param seed Seed of the instance.
+	 */
+	inline CityGenerator(
+			const string &kind,
+			const unsigned long long n,
+			const unsigned long long seed) : random(mix(seed)) {
+		this->kind = kind;
+		this->n = n;
+		this->seed = seed;
+		numberOfCenters = max(1ULL, n / CITIES_PER_CLUSTER);
+		gridColumns = static_cast<unsigned long long>(ceil(sqrt(static_cast<double>(n))));
+		gridSpacing = SQUARE_SIZE / static_cast<double>(gridColumns);
+		nextCity = 0;
+	}
+
+	/**
+	 * Generates the next city.
+	 * @param x x-coordinate of the city.
+	 * @param y y-coordinate of the city.
+	 */
+	inline void next(double &x, double &y) {
+		if (kind == KIND_UNIFORM) {
+			x = floor(random.nextDouble() * SQUARE_SIZE);
+			y = floor(random.nextDouble() * SQUARE_SIZE);
+		}
+		else if (kind == KIND_CLUSTERED) {
+			const unsigned long long center = random.nextInteger(numberOfCenters);
+			const double standardDeviation = SQUARE_SIZE / sqrt(static_cast<double>(n));
+			x = floor(getCenterCoordinate(center, 0) + standardDeviation * random.nextGaussian() + 0.5);
+			y = floor(getCenterCoordinate(center, 1) + standardDeviation * random.nextGaussian() + 0.5);
+		}
+		else {  //if (kind == KIND_GRID)
+			x = floor(static_cast<double>(nextCity % gridColumns) * gridSpacing);
+			y = floor(static_cast<double>(nextCity / gridColumns) * gridSpacing);
+		}
+		nextCity++;
+	}
+};
+
+
+/**
+ * Returns the name of an instance in the DIMACS style, e.g. "E1k.0",
+ * "C10k.1" or "G1M.0".
+ * @param kind Kind of the instance.
+ * @param n Number of cities.
+ * @param seed Seed of the instance.
+ * @return Name of the instance.
+ */
+string getInstanceName(const string &kind, const unsigned long long n, const unsigned long long seed) {
+	ostringstream name;
+	if (kind == KIND_UNIFORM) {
+		name << "E";
+	}
+	else if (kind == KIND_CLUSTERED) {
+		name << "C";
+	}
+	else {  //if (kind == KIND_GRID)
+		name << "G";
+	}
+
+	if ((n >= 1000000) && (n % 1000000 == 0)) {
+		name << n / 1000000 << "M";
+	}
+	else if ((n >= 1000) && (n % 1000 == 0)) {
+		name << n / 1000 << "k";
+	}
+	else {
+		name << n;
+	}
+	name << "." << seed;
+	return (name.str());
+}
+
+/**
+ * Parses a number of cities, optionally with the suffix "k" (thousand)
+ * or "M" (million).
+ * @param s The string.
+ * @return The number of cities.
+ * @throws CommandLineArgumentsInvalid if the string is not valid or
+ *   the number does not fit into an unsigned long long.
+ */
+unsigned long long parseNumberOfCities(string s) {
+	unsigned long long multiplier = 1;
+	if ((!s.empty()) && ((s[s.size() - 1] == 'k') || (s[s.size() - 1] == 'K'))) {
+		multiplier = 1000;
+		s.erase(s.size() - 1);
+	}
+	else if ((!s.empty()) && (s[s.size() - 1] == 'M')) {
+		multiplier = 1000000;
+		s.erase(s.size() - 1);
+	}
+
+	istringstream nIStringstream(s);
+	unsigned long long n;
+	if ((s.empty()) || (s[0] == '-') || (!(nIStringstream >> n)) || (!nIStringstream.eof())) {
+		throw CommandLineArgumentsInvalid();
+	}
+	if (n > numeric_limits<unsigned long long>::max() / multiplier) {
+		throw CommandLineArgumentsInvalid();
+	}
+	n *= multiplier;
+	if (n < 2) {
+		throw CommandLineArgumentsInvalid();
+	}
+	return (n);
+}
+
+/**
+ * Parses an unsigned number given as the value of a command-line option.
+ * @param s The string.
+ * @return The number.
+ * @throws CommandLineArgumentsInvalid if the string is not valid.
+ */
+unsigned long long parseUnsignedNumber(const string &s) {
+	istringstream valueIStringstream(s);
+	unsigned long long value;
+	if ((s.empty()) || (s[0] == '-') || (!(valueIStringstream >> value)) || (!valueIStringstream.eof())) {
+		throw CommandLineArgumentsInvalid();
+	}
+	return (value);
+}
+
+/**
+ * Returns true if the string ends with the given filename extension
+ * (case insensitive).
+ * @param fileName Name of the file.
+ * @param extension Filename extension.
+ * @return
+ *   <ul>
+ *     <li>true if the name of the file ends with the extension,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool hasFilenameExtension(const string &fileName, const string &extension) {
+	if (fileName.size() < extension.size() + 1) {
+		return (false);
+	}
+	string fileNameExtension = fileName.substr(fileName.size() - extension.size());
+	transform(
+			fileNameExtension.begin(),
+			fileNameExtension.end(),
+			fileNameExtension.begin(), ::tolower);
+	return (fileNameExtension == extension);
+}
+
+/**
+ * Writes the instance as a TSPLIB file (streamed, O(1) memory).
+ * @param outputFile Output file.
+ * @param generator Generator of the cities.
+ * @param name Name of the instance.
+ * @param comment Comment of the instance.
+ * @param n Number of cities.
+ */
+void writeTSPLIB(
+		ofstream &outputFile,
+		CityGenerator &generator,
+		const string &name,
+		const string &comment,
+		const unsigned long long n) {
+	outputFile << "NAME: " << name << "\n";
+	outputFile << "TYPE: TSP\n";
+	outputFile << "COMMENT: " << comment << "\n";
+	outputFile << "DIMENSION: " << n << "\n";
+	outputFile << "EDGE_WEIGHT_TYPE: EUC_2D\n";
+	outputFile << "NODE_COORD_SECTION\n";
+	outputFile.setf(ios::fixed, ios::floatfield);
+	outputFile.precision(0);
+	for (unsigned long long i = 0; i < n; i++) {
+		double x;
+		double y;
+		generator.next(x, y);
+		outputFile << i + 1 << " " << x << " " << y << "\n";
+	}
+	outputFile << "EOF\n";
+}
+
+/**
+ * Writes the instance as a binary instance (streamed, O(1) memory).
+ * @param outputFile Output file.
+ * @param generator Generator of the cities.
+ * @param n Number of cities.
+ */
+void writeBinary(ofstream &outputFile, CityGenerator &generator, const unsigned long long n) {
+	writeBinaryInstanceHeader(
+			outputFile,
+			BinaryInstanceHeader(BINARY_INSTANCE_KIND_COORDINATES, BINARY_INSTANCE_METRIC_EUC_2D, n));
+	for (unsigned long long i = 0; i < n; i++) {
+		double x;
+		double y;
+		generator.next(x, y);
+		char buffer[16];
+		encodeBinaryDouble(x, buffer);
+		encodeBinaryDouble(y, buffer + 8);
+		outputFile.write(buffer, 16);
+	}
+}
+
+/**
+ * Writes the k nearest neighbours of every city. The cities are
+ * sorted into a bucket grid with about two cities per bucket; the
+ * neighbours of a city are searched ring by ring around its bucket.
+ * The costs are the TSPLIB "EUC_2D" costs (rounded to the nearest
+ * integer).
+ * @param outputFile Output file.
+ * @param generator Generator of the cities.
+ * @param name Name of the instance.
+ * @param n Number of cities.
+ * @param k Number of neighbours per city.
+ */
+void writeCandidates(
+		ofstream &outputFile,
+		CityGenerator &generator,
+		const string &name,
+		const unsigned long long n,
+		const unsigned long long k) {
+	vector<double> x(n);
+	vector<double> y(n);
+	double minX = numeric_limits<double>::max();
+	double minY = numeric_limits<double>::max();
+	double maxX = -numeric_limits<double>::max();
+	double maxY = -numeric_limits<double>::max();
+	for (unsigned long long i = 0; i < n; i++) {
+		generator.next(x[i], y[i]);
+		minX = min(minX, x[i]);
+		minY = min(minY, y[i]);
+		maxX = max(maxX, x[i]);
+		maxY = max(maxY, y[i]);
+	}
+
+	//Bucket grid (counting sort of the cities by their buckets).
+	const unsigned long long columns =
+			max(1ULL, static_cast<unsigned long long>(sqrt(static_cast<double>(n) / 2.0)));
+	const double bucketWidth = max((maxX - minX) / static_cast<double>(columns), 1.0) * (1.0 + 1e-12);
+	const double bucketHeight = max((maxY - minY) / static_cast<double>(columns), 1.0) * (1.0 + 1e-12);
+	vector<unsigned long long> bucketOfCity(n);
+	vector<unsigned long long> bucketStart(columns * columns + 1, 0);
+	for (unsigned long long i = 0; i < n; i++) {
+		const unsigned long long column =
+				min(columns - 1, static_cast<unsigned long long>((x[i] - minX) / bucketWidth));
+		const unsigned long long row =
+				min(columns - 1, static_cast<unsigned long long>((y[i] - minY) / bucketHeight));
+		bucketOfCity[i] = row * columns + column;
+		bucketStart[bucketOfCity[i] + 1]++;
+	}
+	for (unsigned long long b = 0; b < columns * columns; b++) {
+		bucketStart[b + 1] += bucketStart[b];
+	}
+	vector<unsigned long long> citiesInBuckets(n);
+	{
+		vector<unsigned long long> position(bucketStart.begin(), bucketStart.end() - 1);
+		for (unsigned long long i = 0; i < n; i++) {
+			citiesInBuckets[position[bucketOfCity[i]]++] = i;
+		}
+	}
+
+	const unsigned long long numberOfNeighbours = min(k, n - 1);
+	outputFile << "NAME: " << name << "\n";
+	outputFile << "TYPE: " << CANDIDATE_VALUE_TYPE << "\n";
+	outputFile << "DIMENSION: " << n << "\n";
+	outputFile << CANDIDATE_TAG_CANDIDATES << " " << numberOfNeighbours << "\n";
+	outputFile << CANDIDATE_TAG_CANDIDATE_SECTION << "\n";
+
+	//Max-heap of the best neighbours found so far: (squared distance, city).
+	vector<pair<double, unsigned long long> > best;
+	best.reserve(numberOfNeighbours + 1);
+	const double minimumBucketSize = min(bucketWidth, bucketHeight);
+	for (unsigned long long i = 0; i < n; i++) {
+		best.clear();
+		const long long column = static_cast<long long>(bucketOfCity[i] % columns);
+		const long long row = static_cast<long long>(bucketOfCity[i] / columns);
+		for (long long ring = 0; ring <= static_cast<long long>(columns); ring++) {
+			//All buckets in a distance larger than ring - 1 buckets are farther
+			//than the worst neighbour found so far.
+			if (best.size() == numberOfNeighbours) {
+				const double bound = static_cast<double>(ring - 1) * minimumBucketSize;
+				if ((ring > 0) && (bound * bound > best.front().first)) {
+					break;
+				}
+			}
+			for (long long r = row - ring; r <= row + ring; r++) {
+				if ((r < 0) || (r >= static_cast<long long>(columns))) {
+					continue;
+				}
+				const bool borderRow = ((r == row - ring) || (r == row + ring));
+				for (long long c = column - ring; c <= column + ring; c += (borderRow ? 1 : 2 * ring)) {
+					if ((c >= 0) && (c < static_cast<long long>(columns))) {
+						const unsigned long long b =
+								static_cast<unsigned long long>(r) * columns + static_cast<unsigned long long>(c);
+						for (unsigned long long p = bucketStart[b]; p < bucketStart[b + 1]; p++) {
+							const unsigned long long j = citiesInBuckets[p];
+							if (j == i) {
+								continue;
+							}
+							const double deltaX = x[i] - x[j];
+							const double deltaY = y[i] - y[j];
+							const pair<double, unsigned long long> candidate(
+									deltaX * deltaX + deltaY * deltaY,
+									j);
+							if (best.size() < numberOfNeighbours) {
+								best.push_back(candidate);
+								push_heap(best.begin(), best.end());
+							}
+							else if (candidate < best.front()) {
+								pop_heap(best.begin(), best.end());
+								best.back() = candidate;
+								push_heap(best.begin(), best.end());
+							}
+						}
+					}
+					if (ring == 0) {
+						break;
+					}
+				}
+			}
+		}
+
+		sort_heap(best.begin(), best.end());
+		outputFile << i + 1;
+		for (vector<pair<double, unsigned long long> >::size_type l = 0; l < best.size(); l++) {
+			//The rounded cost is written as an integer (a double of at least 10^6
+			//would be written in the scientific notation).
+			outputFile << " " << best[l].second + 1 << " " <<
+					static_cast<unsigned long long>(floor(sqrt(best[l].first) + 0.5));
+		}
+		outputFile << "\n";
+	}
+	outputFile << "EOF\n";
+}
+
+
+/**
+ * The main function.
+ * @param argc Number of elements in the array argv.
+ * @param argv Name of the running program, options ("--kind=uniform|clustered|grid",
+ *   "--seed=S", "--knn=K"), the number of cities (optionally with the suffix "k"
+ *   or "M") and the name of the output file.
+ * @return
+ *   <ul>
+ *     <li>0 if succeeded,</li>
+ *     <li>1 otherwise.</li>
+ *   </ul>
+ */
+int main(int argc, char* argv[]) {
+	/*
+	 * Initialling.
+	 */
+	cout << "GenerateTSPLIB.cpp:" << endl;
+	cout << "----------------------------------------------------------------" << endl;
+
+	string kind = KIND_UNIFORM;
+	unsigned long long seed = DEFAULT_SEED;
+	unsigned long long k = CANDIDATE_DEFAULT_K;
+	unsigned long long n = 0;
+	string outputFileName = "";
+	try {
+		vector<string> arguments;
+		for (int i = 1; i < argc; i++) {
+			const string argument = argv[i];
+			//The options have to precede the number of cities and the name of the file.
+			if ((!arguments.empty()) || (argument.compare(0, 2, "--") != 0)) {
+				arguments.push_back(argument);
+			}
+			else if (argument.compare(0, COMMAND_LINE_OPTION_KIND.size(), COMMAND_LINE_OPTION_KIND) == 0) {
+				kind = argument.substr(COMMAND_LINE_OPTION_KIND.size());
+				if ((kind != KIND_UNIFORM) && (kind != KIND_CLUSTERED) && (kind != KIND_GRID)) {
+					throw CommandLineArgumentsInvalid();
+				}
+			}
+			else if (argument.compare(0, COMMAND_LINE_OPTION_SEED.size(), COMMAND_LINE_OPTION_SEED) == 0) {
+				seed = parseUnsignedNumber(argument.substr(COMMAND_LINE_OPTION_SEED.size()));
+			}
+			else if (argument.compare(0, COMMAND_LINE_OPTION_KNN.size(), COMMAND_LINE_OPTION_KNN) == 0) {
+				k = parseUnsignedNumber(argument.substr(COMMAND_LINE_OPTION_KNN.size()));
+				if (k < 1) {
+					throw CommandLineArgumentsInvalid();
+				}
+			}
+			else {
+				throw CommandLineArgumentsInvalid();
+			}
+		}
+		if (arguments.size() != 2) {
+			throw CommandLineArgumentsInvalid();
+		}
+		n = parseNumberOfCities(arguments[0]);
+		outputFileName = arguments[1];
+	}
+	catch (CommandLineArgumentsInvalid &e) {
+		cerr << "The command-line arguments are invalid!" << endl;
+		cerr << "Usage: GenerateTSPLIB [--kind=uniform|clustered|grid] [--seed=S] [--knn=K] N OUTPUT" << endl;
+		return (1);
+	}
+
+	const bool tsplib = hasFilenameExtension(outputFileName, OUTPUT_FILE_FILENAME_EXTENSION_TSP);
+	const bool binary = hasFilenameExtension(outputFileName, BINARY_INSTANCE_FILENAME_EXTENSION);
+	const bool candidates = hasFilenameExtension(outputFileName, CANDIDATE_FILENAME_EXTENSION);
+	if ((!tsplib) && (!binary) && (!candidates)) {
+		cerr <<
+				"The filename extension of the output file has to be \"tsp\", \"tspb\" or \"cand\"!" <<
+				endl;
+		return (1);
+	}
+
+	const string name = getInstanceName(kind, n, seed);
+	ostringstream comment;
+	comment << "Synthetic " << kind << " instance with " << n << " cities, seed " << seed;
+
+	//Writing the used parameters on the standard output
+	cout << "Instance: " << name << " (" << comment.str() << ")" << endl;
+	cout << "Output file: " << outputFileName << endl;
+
+	cout << endl;
+
+
+	/*
+	 * Writing of the output file.
+	 */
+	cout << "Writing to the file \"" << outputFileName << "\" ... " << flush;
+
+	ofstream outputFile;
+	outputFile.exceptions(ofstream::failbit | ofstream::badbit);
+	try {
+		if (binary) {
+			outputFile.open(outputFileName.c_str(), ios::out | ios::binary);
+		}
+		else {
+			outputFile.open(outputFileName.c_str());
+		}
+
+		CityGenerator generator(kind, n, seed);
+		if (tsplib) {
+			writeTSPLIB(outputFile, generator, name, comment.str(), n);
+		}
+		else if (binary) {
+			writeBinary(outputFile, generator, n);
+		}
+		else {  //if (candidates)
+			writeCandidates(outputFile, generator, name, n, k);
+		}
+
+		outputFile.close();
+	}
+	catch (ofstream::failure &e) {
+		cerr << "the file \"" << outputFileName << "\" cannot be written!" << endl;
+		return (1);
+	}
+	catch (bad_alloc &e) {
+		cerr << "the instance is too large!" << endl;
+		return (1);
+	}
+
+	cout << "OK" << endl;
+
+	return (0);
+}
@@ -0,0 +1,155 @@
+/**
+ * @file MetricKernels.cpp
+ * Defines the metric kernels.
+ *
+ * @brief Defines the metric kernels.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "MetricKernels.hpp"
+
+using namespace std;
+
+
+/**
+ * Idealized sphere radius of the earth used by the metric "GEO".
+ */
+const double GEO_RADIUS = 6378.388;
+
+
+Metric getMetric(const std::string &edgeWeightType) {
+	if (edgeWeightType == "EUC_2D") {
+		return (METRIC_EUC_2D);
+	}
+	if (edgeWeightType == "CEIL_2D") {
+		return (METRIC_CEIL_2D);
+	}
+	if (edgeWeightType == "ATT") {
+		return (METRIC_ATT);
+	}
+	if (edgeWeightType == "GEO") {
+		return (METRIC_GEO);
+	}
+	throw MetricNotSupported();
+}
+
+
+/**
+ * Converts a "GEO" coordinate (degrees.minutes) to radians.
+ * @param coordinate The coordinate.
+ * @return The coordinate in radians.
+ */
+inline double convertToRadians(const double coordinate) {
+	const double degrees = static_cast<double>(static_cast<long long>(coordinate));
+	const double minutes = coordinate - degrees;
+	return (GEO_PI * (degrees + 5.0 * minutes / 3.0) / 180.0);
+}
+
+double computeBlockCost(
+		const Metric metric,
+		const bool rounded,
+		const double *x1,
+		const double *y1,
+		const double *x2,
+		const double *y2,
+		const std::size_t size) {
+	double sum = 0.0;
+	switch (metric) {
+	case METRIC_EUC_2D:
+		if (rounded) {
+			for (std::size_t k = 0; k < size; k++) {
+				const double deltaX = x1[k] - x2[k];
+				const double deltaY = y1[k] - y2[k];
+				//Truncation equals floor for nonnegative numbers.
+				sum += static_cast<double>(static_cast<long long>(sqrt(deltaX * deltaX + deltaY * deltaY) + 0.5));
+			}
+			return (sum);
+		}
+		break;
+	case METRIC_CEIL_2D:
+		if (rounded) {
+			for (std::size_t k = 0; k < size; k++) {
+				const double deltaX = x1[k] - x2[k];
+				const double deltaY = y1[k] - y2[k];
+				const double distance = sqrt(deltaX * deltaX + deltaY * deltaY);
+				const double truncated = static_cast<double>(static_cast<long long>(distance));
+				sum += truncated + ((truncated < distance) ? 1.0 : 0.0);
+			}
+			return (sum);
+		}
+		break;
+	case METRIC_ATT:
+		for (std::size_t k = 0; k < size; k++) {
+			const double deltaX = x1[k] - x2[k];
+			const double deltaY = y1[k] - y2[k];
+			const double distance = sqrt((deltaX * deltaX + deltaY * deltaY) / 10.0);
+			if (rounded) {
+				const double nearest = static_cast<double>(static_cast<long long>(distance + 0.5));
+				sum += nearest + ((nearest < distance) ? 1.0 : 0.0);
+			}
+			else {
+				sum += distance;
+			}
+		}
+		return (sum);
+	case METRIC_GEO:
+		for (std::size_t k = 0; k < size; k++) {
+			const double q1 = cos(y1[k] - y2[k]);
+			const double q2 = cos(x1[k] - x2[k]);
+			const double q3 = cos(x1[k] + x2[k]);
+			const double distance = GEO_RADIUS * acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3));
+			sum += (rounded ? static_cast<double>(static_cast<long long>(distance + 1.0)) : distance);
+		}
+		return (sum);
+	}
+
+	//Exact Euclidean distance ("EUC_2D" and "CEIL_2D" without rounding).
+	for (std::size_t k = 0; k < size; k++) {
+		const double deltaX = x1[k] - x2[k];
+		const double deltaY = y1[k] - y2[k];
+		sum += sqrt(deltaX * deltaX + deltaY * deltaY);
+	}
+	return (sum);
+}
+
+
+void Coordinates::addVertex(const double x, const double y) {
+	if (metric == METRIC_GEO) {
+		this->x.push_back(convertToRadians(x));
+		this->y.push_back(convertToRadians(y));
+	}
+	else {
+		this->x.push_back(x);
+		this->y.push_back(y);
+	}
+}
+
+double Coordinates::getCost(const std::size_t i, const std::size_t j, const bool rounded) const {
+	return (computeBlockCost(metric, rounded, &x[i], &y[i], &x[j], &y[j], 1));
+}
+
+double Coordinates::getTourLength(const std::vector<unsigned int> &tour, const bool rounded) const {
+	double x1[METRIC_KERNEL_BLOCK_SIZE];
+	double y1[METRIC_KERNEL_BLOCK_SIZE];
+	double x2[METRIC_KERNEL_BLOCK_SIZE];
+	double y2[METRIC_KERNEL_BLOCK_SIZE];
+
+	const std::size_t n = tour.size();
+	double length = 0.0;
+	for (std::size_t start = 0; start < n; start += METRIC_KERNEL_BLOCK_SIZE) {
+		const std::size_t size = min(METRIC_KERNEL_BLOCK_SIZE, n - start);
+		//Gathers the edges {tour[k], tour[k + 1]} of the block (the last edge closes the tour).
+		for (std::size_t k = 0; k < size; k++) {
+			const unsigned int from = tour[start + k];
+			const unsigned int to = tour[(start + k + 1 < n) ? (start + k + 1) : 0];
+			x1[k] = x[from];
+			y1[k] = y[from];
+			x2[k] = x[to];
+			y2[k] = y[to];
+		}
+		length += computeBlockCost(metric, rounded, x1, y1, x2, y2, size);
+	}
+	return (length);
+}
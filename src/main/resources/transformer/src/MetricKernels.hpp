@@ -0,0 +1,200 @@
+/**
+ * @file MetricKernels.hpp
+ * Defines the metric kernels: the costs of the TSPLIB metrics "EUC_2D",
+ * "CEIL_2D", "ATT" and "GEO" computed directly from the coordinates,
+ * without a matrix of the costs. The coordinates are kept as two
+ * separate arrays (structure of arrays). The length of a tour is
+ * computed in blocks: the coordinates of the consecutive vertices of
+ * the tour are gathered into small contiguous buffers and the costs of
+ * a whole block are computed by a branch-free loop the compiler can
+ * vectorize.
+ *
+ * @brief Defines the metric kernels.
+ */
+
+#ifndef _MetricKernels_HPP_
+#define _MetricKernels_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+/**
+ * Number of edges of a tour processed by one call of a kernel.
+ */
+const std::size_t METRIC_KERNEL_BLOCK_SIZE = 256;
+
+/**
+ * The number pi as defined by the TSPLIB for the metric "GEO" (the
+ * published optima are computed with this value). The converter
+ * (TransformReader.cpp) uses the same value, so a "GEO" instance has the
+ * same costs in the XML file, the binary file and the tour evaluation.
+ */
+const double GEO_PI = 3.141592;
+
+
+/**
+ * Metric of the coordinates.
+ */
+enum Metric {
+	/**
+	 * Euclidean distance rounded to the nearest integer ("EUC_2D").
+	 */
+	METRIC_EUC_2D,
+
+	/**
+	 * Euclidean distance rounded up ("CEIL_2D").
+	 */
+	METRIC_CEIL_2D,
+
+	/**
+	 * Pseudo-Euclidean distance ("ATT").
+	 */
+	METRIC_ATT,
+
+	/**
+	 * Geographical distance ("GEO").
+	 */
+	METRIC_GEO
+};
+
+
+/**
+ * Exception class used if a metric is not supported.
+ */
+class MetricNotSupported : public std::exception {
+public:
+	/**
+	 * Constructor for the class MetricNotSupported.
+	 */
+	inline MetricNotSupported() {
+	}
+};
+
+
+/**
+ * Returns the metric for the value of the TSPLIB tag "EDGE_WEIGHT_TYPE:".
+ * @param edgeWeightType Value of the tag "EDGE_WEIGHT_TYPE:".
+ * @return The metric.
+ * @throws MetricNotSupported if the costs cannot be computed from the
+ *   coordinates.
+ */
+Metric getMetric(const std::string &edgeWeightType);
+
+/**
+ * Computes the costs of a block of edges {(x1[k], y1[k]), (x2[k], y2[k])}.
+ * Every metric is a separate loop without branches, so it can be vectorized.
+ * @param metric Metric of the coordinates.
+ * @param rounded True if the costs should be rounded as defined by the TSPLIB.
+ * @param x1 x-coordinates of the first vertices.
+ * @param y1 y-coordinates of the first vertices.
+ * @param x2 x-coordinates of the second vertices.
+ * @param y2 y-coordinates of the second vertices.
+ * @param size Number of edges.
+ * @return Sum of the costs of the edges.
+ */
+double computeBlockCost(
+		const Metric metric,
+		const bool rounded,
+		const double *x1,
+		const double *y1,
+		const double *x2,
+		const double *y2,
+		const std::size_t size);
+
+
+/**
+ * Coordinates of the vertices of an instance (structure of arrays).
+ * The coordinates of "GEO" instances are converted to the latitude and
+ * the longitude in radians when they are added, so the conversion is
+ * done once per vertex instead of once per edge.
+ */
+class Coordinates {
+private:
+	/**
+	 * Metric of the coordinates.
+	 */
+	Metric metric;
+
+	/**
+	 * x-coordinates (latitudes for "GEO").
+	 */
+	std::vector<double> x;
+
+	/**
+	 * y-coordinates (longitudes for "GEO").
+	 */
+	std::vector<double> y;
+
+public:
+	/**
+	 * Constructor for the class Coordinates.
+	 * @param metric Metric of the coordinates.
+	 */
+	inline Coordinates(const Metric metric = METRIC_EUC_2D) {
+		this->metric = metric;
+	}
+
+	/**
+	 * Sets the metric. The coordinates have to be added afterwards.
+	 * @param metric Metric of the coordinates.
+	 */
+	inline void setMetric(const Metric metric) {
+		this->metric = metric;
+	}
+
+	/**
+	 * Returns the metric.
+	 * @return Metric of the coordinates.
+	 */
+	inline Metric getMetric() const {
+		return (metric);
+	}
+
+	/**
+	 * Reserves the memory for n vertices.
+	 * @param n Number of vertices.
+	 */
+	inline void reserve(const std::size_t n) {
+		x.reserve(n);
+		y.reserve(n);
+	}
+
+	/**
+	 * Adds a vertex.
+	 * @param x x-coordinate of the vertex as given in the TSPLIB.
+	 * @param y y-coordinate of the vertex as given in the TSPLIB.
+	 */
+	void addVertex(const double x, const double y);
+
+	/**
+	 * Returns the number of vertices.
+	 * @return Number of vertices.
+	 */
+	inline std::size_t getN() const {
+		return (x.size());
+	}
+
+	/**
+	 * Returns the cost of an edge.
+	 * @param i First vertex (0-based).
+	 * @param j Second vertex (0-based).
+	 * @param rounded True if the cost should be rounded as defined by
+	 *   the TSPLIB, false if the exact distance should be returned.
+	 * @return The cost of the edge {i, j}.
+	 */
+	double getCost(const std::size_t i, const std::size_t j, const bool rounded) const;
+
+	/**
+	 * Returns the length of a tour.
+	 * @param tour The tour: a permutation of the vertices (0-based).
+	 * @param rounded True if the costs should be rounded as defined by
+	 *   the TSPLIB, false if the exact distances should be used.
+	 * @return Length of the tour.
+	 */
+	double getTourLength(const std::vector<unsigned int> &tour, const bool rounded) const;
+};
+
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * @file PermutationFormat.hpp
+ * Defines the permutation format: a text file which maps the vertices
+ * of a renumbered instance back to the vertices of the original
+ * instance. The keywords follow the TSPLIB style:
+ * "NAME:", "TYPE:" (= "PERMUTATION"), "COMMENT:", "DIMENSION:",
+ * "PERMUTATION_SECTION", n lines where the i-th line is the original
+ * number of the vertex i (both 1-based), "EOF". A tour of the
+ * renumbered instance is translated back by replacing every vertex i
+ * by the i-th number of the section.
+ * Subinstances use the same layout with "TYPE:" (= "SELECTION"): the
+ * i-th line is the original number of the vertex i of the subinstance,
+ * so the numbers are distinct but do not cover all original vertices.
+ *
+ * @brief Defines the permutation format.
+ */
+
+#ifndef _PermutationFormat_HPP_
+#define _PermutationFormat_HPP_
+
+#include <string>
+
+
+/**
+ * Filename extension for permutation files.
+ */
+const std::string PERMUTATION_FILENAME_EXTENSION = ".perm";
+
+/**
+ * Value for the tag "TYPE:" for permutation files.
+ */
+const std::string PERMUTATION_VALUE_TYPE = "PERMUTATION";
+
+/**
+ * Filename extension for selection files (the vertices of a subinstance).
+ */
+const std::string SELECTION_FILENAME_EXTENSION = ".sel";
+
+/**
+ * Value for the tag "TYPE:" for selection files.
+ */
+const std::string SELECTION_VALUE_TYPE = "SELECTION";
+
+/**
+ * Tag for permutation files: "PERMUTATION_SECTION".
+ */
+const std::string PERMUTATION_TAG_PERMUTATION_SECTION = "PERMUTATION_SECTION";
+
+
+#endif
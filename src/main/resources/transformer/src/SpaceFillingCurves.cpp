@@ -0,0 +1,115 @@
+/**
+ * @file SpaceFillingCurves.cpp
+ * Defines the renumbering of vertices along a space-filling curve.
+ *
+ * @brief Defines the renumbering of vertices along a space-filling curve.
+ */
+
+#include <algorithm>
+#include <utility>
+
+#include "SpaceFillingCurves.hpp"
+
+using namespace std;
+
+
+SpaceFillingCurve getSpaceFillingCurve(const std::string &name) {
+	if (name == SPACE_FILLING_CURVE_HILBERT) {
+		return (CURVE_HILBERT);
+	}
+	if (name == SPACE_FILLING_CURVE_MORTON) {
+		return (CURVE_MORTON);
+	}
+	throw SpaceFillingCurveNotSupported();
+}
+
+std::string getSpaceFillingCurveName(const SpaceFillingCurve curve) {
+	return ((curve == CURVE_HILBERT) ? SPACE_FILLING_CURVE_HILBERT : SPACE_FILLING_CURVE_MORTON);
+}
+
+unsigned long long getHilbertIndex(unsigned int x, unsigned int y) {
+	unsigned long long index = 0;
+	for (unsigned int s = 1U << (SPACE_FILLING_CURVE_BITS - 1); s > 0; s >>= 1) {
+		const unsigned int rx = ((x & s) != 0) ? 1 : 0;
+		const unsigned int ry = ((y & s) != 0) ? 1 : 0;
+		index += static_cast<unsigned long long>(s) * s * ((3 * rx) ^ ry);
+		//Rotates the quadrant, so the curve is continuous.
+		if (ry == 0) {
+			if (rx == 1) {
+				x = s - 1 - (x & (s - 1));
+				y = s - 1 - (y & (s - 1));
+			}
+			swap(x, y);
+		}
+	}
+	return (index);
+}
+
+/**
+ * Spreads the lower 16 bits of a number to the even bits.
+ * @param v The number.
+ * @return The spread bits.
+ */
+unsigned long long spreadBits(const unsigned int v) {
+	unsigned long long b = v & 0xFFFFULL;
+	b = (b | (b << 8)) & 0x00FF00FFULL;
+	b = (b | (b << 4)) & 0x0F0F0F0FULL;
+	b = (b | (b << 2)) & 0x33333333ULL;
+	b = (b | (b << 1)) & 0x55555555ULL;
+	return (b);
+}
+
+unsigned long long getMortonIndex(const unsigned int x, const unsigned int y) {
+	return (spreadBits(x) | (spreadBits(y) << 1));
+}
+
+std::vector<std::size_t> getSpaceFillingCurveOrder(
+		const std::vector<double> &x,
+		const std::vector<double> &y,
+		const SpaceFillingCurve curve) {
+	const size_t n = x.size();
+	vector<size_t> order(n);
+	if (n == 0) {
+		return (order);
+	}
+
+	//The same scale for both axes keeps the shape of the instance.
+	const double minX = *min_element(x.begin(), x.end());
+	const double minY = *min_element(y.begin(), y.end());
+	const double span = max(
+			*max_element(x.begin(), x.end()) - minX,
+			*max_element(y.begin(), y.end()) - minY);
+	const double maxCell = static_cast<double>((1U << SPACE_FILLING_CURVE_BITS) - 1);
+	const double scale = (span > 0.0) ? maxCell / span : 0.0;
+
+	vector<pair<unsigned long long, size_t> > keys(n);
+	for (size_t i = 0; i < n; i++) {
+		const unsigned int cellX = static_cast<unsigned int>(min(maxCell, (x[i] - minX) * scale));
+		const unsigned int cellY = static_cast<unsigned int>(min(maxCell, (y[i] - minY) * scale));
+		keys[i].first = (curve == CURVE_HILBERT) ?
+				getHilbertIndex(cellX, cellY) :
+				getMortonIndex(cellX, cellY);
+		keys[i].second = i;
+	}
+	//Ties are broken by the old number.
+	sort(keys.begin(), keys.end());
+	for (size_t i = 0; i < n; i++) {
+		order[i] = keys[i].second;
+	}
+	return (order);
+}
+
+std::vector<std::size_t> getSpaceFillingCurveSample(
+		const std::vector<double> &x,
+		const std::vector<double> &y,
+		const std::size_t m,
+		const SpaceFillingCurve curve) {
+	const vector<size_t> order = getSpaceFillingCurveOrder(x, y, curve);
+	const unsigned long long n = order.size();
+	vector<size_t> sample(m);
+	for (size_t s = 0; s < m; s++) {
+		//The stratum s contains the positions [s * n / m, (s + 1) * n / m).
+		sample[s] = order[static_cast<size_t>((2 * static_cast<unsigned long long>(s) + 1) * n / (2 * m))];
+	}
+	return (sample);
+}
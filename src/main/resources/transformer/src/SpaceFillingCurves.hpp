@@ -0,0 +1,136 @@
+/**
+ * @file SpaceFillingCurves.hpp
+ * Defines the renumbering of vertices along a space-filling curve. The
+ * coordinates are mapped to a grid of 2^16 x 2^16 cells (with the same
+ * scale for both axes) and the vertices are sorted by the index of their
+ * cell on the Hilbert or the Morton (Z-order) curve. Vertices which are
+ * close in the plane get close numbers, so walking spatial
+ * neighbourhoods touches close rows of a matrix or close entries of an
+ * array of coordinates. The Hilbert curve has no jumps and thus a better
+ * locality; the Morton curve is cheaper to compute.
+ * The same order yields spatially stratified samples: the curve is cut
+ * into m pieces with the same number of vertices and one vertex is taken
+ * from every piece, so dense regions keep their share of the vertices.
+ *
+ * @brief Defines the renumbering of vertices along a space-filling curve.
+ */
+
+#ifndef _SpaceFillingCurves_HPP_
+#define _SpaceFillingCurves_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+/**
+ * Number of bits of a grid coordinate (the grid has 2^16 x 2^16 cells).
+ */
+const unsigned int SPACE_FILLING_CURVE_BITS = 16;
+
+/**
+ * Name of the Hilbert curve (command line).
+ */
+const std::string SPACE_FILLING_CURVE_HILBERT = "hilbert";
+
+/**
+ * Name of the Morton curve (command line).
+ */
+const std::string SPACE_FILLING_CURVE_MORTON = "morton";
+
+
+/**
+ * Space-filling curve.
+ */
+enum SpaceFillingCurve {
+	/**
+	 * Hilbert curve.
+	 */
+	CURVE_HILBERT,
+
+	/**
+	 * Morton curve (Z-order).
+	 */
+	CURVE_MORTON
+};
+
+
+/**
+ * Exception class used if a space-filling curve is not supported.
+ */
+class SpaceFillingCurveNotSupported : public std::exception {
+public:
+	/**
+	 * Constructor for the class SpaceFillingCurveNotSupported.
+	 */
+	inline SpaceFillingCurveNotSupported() {
+	}
+};
+
+
+/**
+ * Returns the space-filling curve with a name ("hilbert" or "morton").
+ * @param name Name of the curve.
+ * @return The curve.
+ * @throws SpaceFillingCurveNotSupported if the curve is not supported.
+ */
+SpaceFillingCurve getSpaceFillingCurve(const std::string &name);
+
+/**
+ * Returns the name of a space-filling curve.
+ * @param curve The curve.
+ * @return Name of the curve.
+ */
+std::string getSpaceFillingCurveName(const SpaceFillingCurve curve);
+
+/**
+ * Returns the index of a cell on the Hilbert curve.
+ * @param x Column of the cell (less than 2^SPACE_FILLING_CURVE_BITS).
+ * @param y Row of the cell (less than 2^SPACE_FILLING_CURVE_BITS).
+ * @return Index of the cell.
+ */
+unsigned long long getHilbertIndex(unsigned int x, unsigned int y);
+
+/**
+ * Returns the index of a cell on the Morton curve (the interleaved bits
+ * of the row and the column).
+ * @param x Column of the cell (less than 2^SPACE_FILLING_CURVE_BITS).
+ * @param y Row of the cell (less than 2^SPACE_FILLING_CURVE_BITS).
+ * @return Index of the cell.
+ */
+unsigned long long getMortonIndex(const unsigned int x, const unsigned int y);
+
+/**
+ * Returns the order of the vertices along a space-filling curve.
+ * Vertices in the same cell keep their relative order.
+ * @param x The x-coordinates of the vertices.
+ * @param y The y-coordinates of the vertices.
+ * @param curve The curve.
+ * @return The order: the i-th element is the old number of the vertex
+ *   which gets the new number i.
+ */
+std::vector<std::size_t> getSpaceFillingCurveOrder(
+		const std::vector<double> &x,
+		const std::vector<double> &y,
+		const SpaceFillingCurve curve);
+
+/**
+ * Returns a spatially stratified sample of m vertices. The vertices are
+ * ordered along the space-filling curve, the order is cut into m
+ * strata with the same number of vertices (up to one) and the middle
+ * vertex of every stratum is taken. The sample is deterministic. The
+ * parameters are not checked (1 <= m <= n).
+ * @param x The x-coordinates of the vertices.
+ * @param y The y-coordinates of the vertices.
+ * @param m Size of the sample.
+ * @param curve The curve.
+ * @return The sample: the numbers of the m vertices in the order along the curve.
+ */
+std::vector<std::size_t> getSpaceFillingCurveSample(
+		const std::vector<double> &x,
+		const std::vector<double> &y,
+		const std::size_t m,
+		const SpaceFillingCurve curve);
+
+
+#endif
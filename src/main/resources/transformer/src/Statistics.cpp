@@ -0,0 +1,207 @@
+/**
+ * @file Statistics.cpp
+ * Defines the instrumentation shared by the transform and validate
+ * programs.
+ *
+ * @brief Defines the instrumentation of the programs.
+ */
+
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include "Statistics.hpp"
+
+using namespace std;
+
+
+double getMonotonicTime() {
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (static_cast<double>(time.tv_sec) + 1e-9 * static_cast<double>(time.tv_nsec));
+}
+
+unsigned long long getFileSize(const std::string &fileName) {
+	struct stat status;
+	if (stat(fileName.c_str(), &status) != 0) {
+		return (0);
+	}
+	return (static_cast<unsigned long long>(status.st_size));
+}
+
+bool parseStatisticsOption(const std::string &argument, StatisticsFormat &format) {
+	if (argument == COMMAND_LINE_OPTION_STATISTICS) {
+		format = STATISTICS_TABLE;
+		return (true);
+	}
+	if (argument == COMMAND_LINE_OPTION_STATISTICS_JSON) {
+		format = STATISTICS_JSON;
+		return (true);
+	}
+	return (false);
+}
+
+/**
+ * Writes a string as a JSON string literal.
+ * @param out Output stream.
+ * @param s The string.
+ */
+inline void writeJSONString(std::ostream &out, const std::string &s) {
+	out << '"';
+	for (string::size_type i = 0; i < s.size(); i++) {
+		const unsigned char c = static_cast<unsigned char>(s[i]);
+		if ((c == '"') || (c == '\\')) {
+			out << '\\' << s[i];
+		}
+		else if (c < 0x20) {
+			out << "\\u" << hex << setw(4) << setfill('0') << static_cast<unsigned int>(c) <<
+					dec << setfill(' ');
+		}
+		else {
+			out << s[i];
+		}
+	}
+	out << '"';
+}
+
+
+Statistics::Statistics(const std::string &program) {
+	this->program = program;
+	bytesRead = 0;
+	bytesWritten = 0;
+	edges = 0;
+	startTime = getMonotonicTime();
+	activeTimer = 0;
+}
+
+void Statistics::addPhaseTime(const std::string &phase, const double seconds) {
+	for (vector<string>::size_type i = 0; i < phaseNames.size(); i++) {
+		if (phaseNames[i] == phase) {
+			phaseSeconds[i] += seconds;
+			return;
+		}
+	}
+	phaseNames.push_back(phase);
+	phaseSeconds.push_back(seconds);
+}
+
+double Statistics::getElapsedTime() const {
+	return (getMonotonicTime() - startTime);
+}
+
+long Statistics::getPeakResidentSetSize() {
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return (0);
+	}
+	//Linux reports the maximum resident set size in kilobytes.
+	return (usage.ru_maxrss);
+}
+
+void Statistics::printTable(std::ostream &out) const {
+	const double total = getElapsedTime();
+
+	ostringstream table;
+	table.setf(ios::fixed, ios::floatfield);
+	table << "Statistics (" << program << "):" << endl;
+	for (vector<string>::size_type i = 0; i < phaseNames.size(); i++) {
+		table <<
+				"\t" << left << setw(24) << phaseNames[i] << right <<
+				setw(12) << setprecision(3) << phaseSeconds[i] << " s" <<
+				setw(8) << setprecision(1) <<
+				((total > 0.0) ? (100.0 * phaseSeconds[i] / total) : 0.0) << " %" << endl;
+	}
+	table << "\t" << left << setw(24) << "total" << right <<
+			setw(12) << setprecision(3) << total << " s" << endl;
+	table << "\t" << left << setw(24) << "bytes read" << right << setw(12) << bytesRead << endl;
+	table << "\t" << left << setw(24) << "bytes written" << right << setw(12) << bytesWritten << endl;
+	table << "\t" << left << setw(24) << "edges" << right << setw(12) << edges << endl;
+	table << "\t" << left << setw(24) << "edges per second" << right <<
+			setw(12) << setprecision(0) <<
+			((total > 0.0) ? (static_cast<double>(edges) / total) : 0.0) << endl;
+	table << "\t" << left << setw(24) << "peak resident set size" << right <<
+			setw(12) << getPeakResidentSetSize() << " kB" << endl;
+
+	out << table.str() << flush;
+}
+
+void Statistics::printJSON(std::ostream &out) const {
+	const double total = getElapsedTime();
+
+	ostringstream json;
+	json << setprecision(6);
+	json << "{\"program\":";
+	writeJSONString(json, program);
+	json << ",\"phases\":{";
+	for (vector<string>::size_type i = 0; i < phaseNames.size(); i++) {
+		if (i > 0) {
+			json << ",";
+		}
+		writeJSONString(json, phaseNames[i]);
+		json << ":" << phaseSeconds[i];
+	}
+	json << "}";
+	json << ",\"totalSeconds\":" << total;
+	json << ",\"bytesRead\":" << bytesRead;
+	json << ",\"bytesWritten\":" << bytesWritten;
+	json << ",\"edges\":" << edges;
+	json << ",\"edgesPerSecond\":" <<
+			((total > 0.0) ? (static_cast<double>(edges) / total) : 0.0);
+	json << ",\"peakResidentSetSizeKilobytes\":" << getPeakResidentSetSize();
+	json << "}";
+
+	out << json.str() << endl;
+}
+
+void Statistics::print(std::ostream &out, const StatisticsFormat format) const {
+	switch (format) {
+	case STATISTICS_TABLE:
+		printTable(out);
+		break;
+	case STATISTICS_JSON:
+		printJSON(out);
+		break;
+	case STATISTICS_NONE:
+		break;
+	}
+}
+
+
+ScopedPhaseTimer::ScopedPhaseTimer(Statistics *statistics, const std::string &phase) {
+	this->statistics = statistics;
+	this->phase = phase;
+	nestedTime = 0.0;
+	enclosingTimer = 0;
+	running = (statistics != 0);
+	startTime = 0.0;
+	if (running) {
+		//Registers the phase, so the phases are printed in the order they start.
+		statistics->addPhaseTime(phase, 0.0);
+		enclosingTimer = statistics->activeTimer;
+		statistics->activeTimer = this;
+		startTime = getMonotonicTime();
+	}
+}
+
+ScopedPhaseTimer::~ScopedPhaseTimer() {
+	stop();
+}
+
+void ScopedPhaseTimer::stop() {
+	if (!running) {
+		return;
+	}
+	running = false;
+
+	const double elapsedTime = getMonotonicTime() - startTime;
+	statistics->addPhaseTime(phase, elapsedTime - nestedTime);
+	if (enclosingTimer != 0) {
+		enclosingTimer->nestedTime += elapsedTime;
+	}
+	statistics->activeTimer = enclosingTimer;
+}
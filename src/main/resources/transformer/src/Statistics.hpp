@@ -0,0 +1,340 @@
+/**
+ * @file Statistics.hpp
+ * Defines the instrumentation shared by the transform and validate
+ * programs: the time spent in the individual phases, the number of
+ * read and written bytes, the number of processed edges and the peak
+ * memory usage. The statistics can be printed as a table or as one
+ * line of JSON.
+ *
+ * @brief Defines the instrumentation of the programs.
+ */
+
+#ifndef _Statistics_HPP_
+#define _Statistics_HPP_
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+/**
+ * Command-line option: The statistics are printed as a table.
+ */
+const std::string COMMAND_LINE_OPTION_STATISTICS = "--stats";
+
+/**
+ * Command-line option: The statistics are printed as one line of JSON.
+ */
+const std::string COMMAND_LINE_OPTION_STATISTICS_JSON = "--stats=json";
+
+/**
+ * Phase: Reading and parsing the input file.
+ */
+const std::string PHASE_PARSING = "parsing";
+
+/**
+ * Phase: Computing the costs from the coordinates.
+ */
+const std::string PHASE_DISTANCES = "distances";
+
+/**
+ * Phase: Rounding the costs to the precision written to the output.
+ */
+const std::string PHASE_ROUNDING = "rounding";
+
+/**
+ * Phase: Creating the DOM structure.
+ */
+const std::string PHASE_DOM_CONSTRUCTION = "DOM construction";
+
+/**
+ * Phase: Writing the output file.
+ */
+const std::string PHASE_SERIALIZATION = "serialization";
+
+/**
+ * Phase: Deciding if the parsed graph is undirected.
+ */
+const std::string PHASE_SYMMETRY_DETECTION = "symmetry detection";
+
+/**
+ * Phase: Creating the graph from the parsed adjacency matrix.
+ */
+const std::string PHASE_GRAPH_CONSTRUCTION = "graph construction";
+
+/**
+ * Phase: Looking up the validation record.
+ */
+const std::string PHASE_CACHE_LOOKUP = "cache lookup";
+
+/**
+ * Phase: Checking the tours and computing their lengths.
+ */
+const std::string PHASE_TOUR_EVALUATION = "tour evaluation";
+
+/**
+ * Phase: Renumbering the vertices along a space-filling curve.
+ */
+const std::string PHASE_RENUMBERING = "renumbering";
+
+/**
+ * Phase: Extracting a subinstance.
+ */
+const std::string PHASE_SUBSAMPLING = "subsampling";
+
+
+/**
+ * Format of the printed statistics.
+ */
+enum StatisticsFormat {
+	/**
+	 * The statistics are not printed.
+	 */
+	STATISTICS_NONE,
+
+	/**
+	 * The statistics are printed as a table.
+	 */
+	STATISTICS_TABLE,
+
+	/**
+	 * The statistics are printed as one line of JSON.
+	 */
+	STATISTICS_JSON
+};
+
+
+/**
+ * Returns the time of a monotonic clock.
+ * @return Time of a monotonic clock in seconds.
+ */
+double getMonotonicTime();
+
+/**
+ * Returns the size of a file.
+ * @param fileName Name of the file.
+ * @return Size of the file in bytes or 0 if the file does not exist.
+ */
+unsigned long long getFileSize(const std::string &fileName);
+
+/**
+ * Recognizes the command-line options of the statistics.
+ * @param argument Command-line argument.
+ * @param format Format given by the argument (set only if the
+ *   argument is an option of the statistics).
+ * @return
+ *   <ul>
+ *     <li>true if the argument is an option of the statistics,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool parseStatisticsOption(const std::string &argument, StatisticsFormat &format);
+
+
+class ScopedPhaseTimer;
+
+/**
+ * Collects the statistics of one run of a program.
+ */
+class Statistics {
+private:
+	/**
+	 * Name of the program.
+	 */
+	std::string program;
+
+	/**
+	 * Names of the phases in the order of their first occurrence.
+	 */
+	std::vector<std::string> phaseNames;
+
+	/**
+	 * Time spent in the phases in seconds (exclusive of nested phases).
+	 */
+	std::vector<double> phaseSeconds;
+
+	/**
+	 * Number of read bytes.
+	 */
+	unsigned long long bytesRead;
+
+	/**
+	 * Number of written bytes.
+	 */
+	unsigned long long bytesWritten;
+
+	/**
+	 * Number of processed edges.
+	 */
+	unsigned long long edges;
+
+	/**
+	 * Time of the creation of the statistics.
+	 */
+	double startTime;
+
+	/**
+	 * The innermost running phase timer (0 if there is none).
+	 */
+	ScopedPhaseTimer *activeTimer;
+
+	/**
+	 * Not implemented copy constructor for the class Statistics.
+	 * @param statistics Instance to be copied.
+	 */
+	Statistics(const Statistics &statistics);
+
+	/**
+	 * Not implemented operator "=".
+	 * @param statistics Right side of the operator.
+	 * @return Left side of the operator.
+	 */
+	Statistics &operator=(const Statistics &statistics);
+
+	friend class ScopedPhaseTimer;
+
+public:
+	/**
+	 * Constructor for the class Statistics. The total time is
+	 * measured from the call of the constructor.
+	 * @param program Name of the program.
+	 */
+	Statistics(const std::string &program);
+
+	/**
+	 * Adds time to a phase.
+	 * @param phase Name of the phase.
+	 * @param seconds Time in seconds.
+	 */
+	void addPhaseTime(const std::string &phase, const double seconds);
+
+	/**
+	 * Adds read bytes.
+	 * @param bytes Number of bytes.
+	 */
+	inline void addBytesRead(const unsigned long long bytes) {
+		bytesRead += bytes;
+	}
+
+	/**
+	 * Adds written bytes.
+	 * @param bytes Number of bytes.
+	 */
+	inline void addBytesWritten(const unsigned long long bytes) {
+		bytesWritten += bytes;
+	}
+
+	/**
+	 * Adds processed edges.
+	 * @param edges Number of edges.
+	 */
+	inline void addEdges(const unsigned long long edges) {
+		this->edges += edges;
+	}
+
+	/**
+	 * Returns the time elapsed since the creation of the statistics.
+	 * @return Time elapsed since the creation of the statistics in seconds.
+	 */
+	double getElapsedTime() const;
+
+	/**
+	 * Returns the peak resident set size of the process.
+	 * @return Peak resident set size of the process in kilobytes.
+	 */
+	static long getPeakResidentSetSize();
+
+	/**
+	 * Prints the statistics as a table.
+	 * @param out Output stream.
+	 */
+	void printTable(std::ostream &out) const;
+
+	/**
+	 * Prints the statistics as one line of JSON.
+	 * @param out Output stream.
+	 */
+	void printJSON(std::ostream &out) const;
+
+	/**
+	 * Prints the statistics in the given format.
+	 * @param out Output stream.
+	 * @param format Format of the statistics.
+	 */
+	void print(std::ostream &out, const StatisticsFormat format) const;
+};
+
+
+/**
+ * Measures the time of one phase from its construction until its
+ * destruction (or until the method stop is called). The timers can
+ * be nested; the time of a nested phase is not counted to the
+ * enclosing phase. If the statistics are 0, the timer does nothing.
+ */
+class ScopedPhaseTimer {
+private:
+	/**
+	 * Statistics the time is added to (can be 0).
+	 */
+	Statistics *statistics;
+
+	/**
+	 * Name of the phase.
+	 */
+	std::string phase;
+
+	/**
+	 * Time of the start of the phase.
+	 */
+	double startTime;
+
+	/**
+	 * Time spent in the nested phases.
+	 */
+	double nestedTime;
+
+	/**
+	 * The enclosing timer (0 if there is none).
+	 */
+	ScopedPhaseTimer *enclosingTimer;
+
+	/**
+	 * True until the timer is stopped.
+	 */
+	bool running;
+
+	/**
+	 * Not implemented copy constructor for the class ScopedPhaseTimer.
+	 * @param scopedPhaseTimer Instance to be copied.
+	 */
+	ScopedPhaseTimer(const ScopedPhaseTimer &scopedPhaseTimer);
+
+	/**
+	 * Not implemented operator "=".
+	 * @param scopedPhaseTimer Right side of the operator.
+	 * @return Left side of the operator.
+	 */
+	ScopedPhaseTimer &operator=(const ScopedPhaseTimer &scopedPhaseTimer);
+
+public:
+	/**
+	 * Constructor for the class ScopedPhaseTimer. Starts the phase.
+	 * @param statistics Statistics the time is added to (can be 0).
+	 * @param phase Name of the phase.
+	 */
+	ScopedPhaseTimer(Statistics *statistics, const std::string &phase);
+
+	/**
+	 * Destructor for the class ScopedPhaseTimer. Stops the phase.
+	 */
+	~ScopedPhaseTimer();
+
+	/**
+	 * Stops the phase before the timer is destroyed. Nested timers
+	 * have to be stopped before the enclosing ones.
+	 */
+	void stop();
+};
+
+
+#endif
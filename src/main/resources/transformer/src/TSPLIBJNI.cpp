@@ -0,0 +1,203 @@
+/**
+ * @file TSPLIBJNI.cpp
+ * Defines the Java Native Interface binding of the shared library
+ * libtsplib.so for the class jo.ju.edu.tsp.core.tsplib.NativeTSPLIB.
+ * Errors are thrown as java.io.IOException or
+ * java.lang.IllegalArgumentException.
+ *
+ * @brief Defines the Java Native Interface binding of libtsplib.so.
+ */
+
+#include <cstdint>
+
+#include <jni.h>
+
+#include "TSPLIBLibrary.hpp"
+
+
+/**
+ * Throws a Java exception.
+ * @param env The JNI environment.
+ * @param className Name of the class of the exception.
+ * @param message Message of the exception.
+ */
+void throwJavaException(JNIEnv *env, const char *className, const char *message) {
+	jclass exceptionClass = env->FindClass(className);
+	if (exceptionClass != 0) {
+		env->ThrowNew(exceptionClass, message);
+	}
+}
+
+/**
+ * Throws a Java exception for a status of the library if it is not TSPLIB_OK.
+ * @param env The JNI environment.
+ * @param status The status.
+ * @return
+ *   <ul>
+ *     <li>true if an exception was thrown,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool throwJavaExceptionForStatus(JNIEnv *env, const int status) {
+	if (status == TSPLIB_OK) {
+		return (false);
+	}
+	throwJavaException(
+			env,
+			(status == TSPLIB_ERROR_ARGUMENT) ? "java/lang/IllegalArgumentException" : "java/io/IOException",
+			tsplibGetStatusMessage(status));
+	return (true);
+}
+
+/**
+ * Converts a handle of the Java class to an instance.
+ * @param handle The handle.
+ * @return The instance.
+ */
+inline TSPLIBInstance *getInstance(const jlong handle) {
+	return (reinterpret_cast<TSPLIBInstance *>(static_cast<intptr_t>(handle)));
+}
+
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL Java_jo_ju_edu_tsp_core_tsplib_NativeTSPLIB_open(
+		JNIEnv *env,
+		jclass,
+		jstring fileName) {
+	if (fileName == 0) {
+		throwJavaExceptionForStatus(env, TSPLIB_ERROR_ARGUMENT);
+		return (0);
+	}
+	const char *fileNameUTF = env->GetStringUTFChars(fileName, 0);
+	if (fileNameUTF == 0) {
+		return (0);  //OutOfMemoryError is pending.
+	}
+	TSPLIBInstance *instance = 0;
+	const int status = tsplibOpen(fileNameUTF, &instance);
+	env->ReleaseStringUTFChars(fileName, fileNameUTF);
+	if (throwJavaExceptionForStatus(env, status)) {
+		return (0);
+	}
+	return (static_cast<jlong>(reinterpret_cast<intptr_t>(instance)));
+}
+
+JNIEXPORT void JNICALL Java_jo_ju_edu_tsp_core_tsplib_NativeTSPLIB_close(
+		JNIEnv *,
+		jclass,
+		jlong handle) {
+	tsplibClose(getInstance(handle));
+}
+
+JNIEXPORT jstring JNICALL Java_jo_ju_edu_tsp_core_tsplib_NativeTSPLIB_getName(
+		JNIEnv *env,
+		jclass,
+		jlong handle) {
+	return (env->NewStringUTF(tsplibGetName(getInstance(handle))));
+}
+
+JNIEXPORT jstring JNICALL Java_jo_ju_edu_tsp_core_tsplib_NativeTSPLIB_getDescription(
+		JNIEnv *env,
+		jclass,
+		jlong handle) {
+	return (env->NewStringUTF(tsplibGetDescription(getInstance(handle))));
+}
+
+JNIEXPORT jboolean JNICALL Java_jo_ju_edu_tsp_core_tsplib_NativeTSPLIB_isSymmetric(
+		JNIEnv *,
+		jclass,
+		jlong handle) {
+	return ((tsplibIsSymmetric(getInstance(handle)) != 0) ? JNI_TRUE : JNI_FALSE);
+}
+
+JNIEXPORT jlong JNICALL Java_jo_ju_edu_tsp_core_tsplib_NativeTSPLIB_getDimension(
+		JNIEnv *,
+		jclass,
+		jlong handle) {
+	return (static_cast<jlong>(tsplibGetDimension(getInstance(handle))));
+}
+
+JNIEXPORT jboolean JNICALL Java_jo_ju_edu_tsp_core_tsplib_NativeTSPLIB_hasCoordinates(
+		JNIEnv *,
+		jclass,
+		jlong handle) {
+	return ((tsplibHasCoordinates(getInstance(handle)) != 0) ? JNI_TRUE : JNI_FALSE);
+}
+
+JNIEXPORT void JNICALL Java_jo_ju_edu_tsp_core_tsplib_NativeTSPLIB_copyCosts(
+		JNIEnv *env,
+		jclass,
+		jlong handle,
+		jdoubleArray costs,
+		jboolean lower) {
+	if (costs == 0) {
+		throwJavaExceptionForStatus(env, TSPLIB_ERROR_ARGUMENT);
+		return;
+	}
+	const unsigned long long size = static_cast<unsigned long long>(env->GetArrayLength(costs));
+	//The costs are written directly into the Java array.
+	double *elements = static_cast<double *>(env->GetPrimitiveArrayCritical(costs, 0));
+	if (elements == 0) {
+		return;  //OutOfMemoryError is pending.
+	}
+	const int status = (lower == JNI_TRUE) ?
+			tsplibCopyLowerCosts(getInstance(handle), elements, size) :
+			tsplibCopyCosts(getInstance(handle), elements, size);
+	env->ReleasePrimitiveArrayCritical(costs, elements, 0);
+	throwJavaExceptionForStatus(env, status);
+}
+
+JNIEXPORT void JNICALL Java_jo_ju_edu_tsp_core_tsplib_NativeTSPLIB_copyCostsToBuffer(
+		JNIEnv *env,
+		jclass,
+		jlong handle,
+		jobject costs,
+		jboolean lower) {
+	double *address = (costs != 0) ? static_cast<double *>(env->GetDirectBufferAddress(costs)) : 0;
+	if (address == 0) {
+		throwJavaExceptionForStatus(env, TSPLIB_ERROR_ARGUMENT);
+		return;
+	}
+	const unsigned long long size =
+			static_cast<unsigned long long>(env->GetDirectBufferCapacity(costs)) / sizeof(double);
+	const int status = (lower == JNI_TRUE) ?
+			tsplibCopyLowerCosts(getInstance(handle), address, size) :
+			tsplibCopyCosts(getInstance(handle), address, size);
+	throwJavaExceptionForStatus(env, status);
+}
+
+JNIEXPORT void JNICALL Java_jo_ju_edu_tsp_core_tsplib_NativeTSPLIB_copyCoordinates(
+		JNIEnv *env,
+		jclass,
+		jlong handle,
+		jdoubleArray x,
+		jdoubleArray y) {
+	if ((x == 0) || (y == 0)) {
+		throwJavaExceptionForStatus(env, TSPLIB_ERROR_ARGUMENT);
+		return;
+	}
+	const jsize size = env->GetArrayLength(x);
+	if (env->GetArrayLength(y) != size) {
+		throwJavaExceptionForStatus(env, TSPLIB_ERROR_ARGUMENT);
+		return;
+	}
+	jdouble *xElements = env->GetDoubleArrayElements(x, 0);
+	jdouble *yElements = env->GetDoubleArrayElements(y, 0);
+	if ((xElements == 0) || (yElements == 0)) {
+		//OutOfMemoryError is pending.
+		if (xElements != 0) {
+			env->ReleaseDoubleArrayElements(x, xElements, JNI_ABORT);
+		}
+		return;
+	}
+	const int status = tsplibCopyCoordinates(
+			getInstance(handle),
+			xElements,
+			yElements,
+			static_cast<unsigned long long>(size));
+	env->ReleaseDoubleArrayElements(x, xElements, 0);
+	env->ReleaseDoubleArrayElements(y, yElements, 0);
+	throwJavaExceptionForStatus(env, status);
+}
+
+}
@@ -0,0 +1,203 @@
+/**
+ * @file TSPLIBLibrary.cpp
+ * Defines the C interface of the shared library libtsplib.so.
+ *
+ * @brief Defines the C interface of the shared library libtsplib.so.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "TransformConstantsClassesAndFunctions.hpp"
+#include "FileStreams.hpp"
+
+#include "TSPLIBLibrary.hpp"
+
+using namespace std;
+
+
+/**
+ * An instance read from a TSPLIB file.
+ */
+struct TSPLIBInstance {
+	/**
+	 * The instance.
+	 */
+	TransformInstance *transformInstance;
+
+	/**
+	 * Name of the instance (kept for tsplibGetName).
+	 */
+	string name;
+
+	/**
+	 * Description of the instance (kept for tsplibGetDescription).
+	 */
+	string description;
+};
+
+
+/**
+ * Returns true if the name of a file ends with the filename extension
+ * ".tsp" or ".atsp" (case insensitive, optionally followed by ".gz").
+ * @param fileName Name of the file.
+ * @return
+ *   <ul>
+ *     <li>true if the file is a TSPLIB file,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool hasTSPLIBFilenameExtension(const string &fileName) {
+	string uncompressedFileName = removeGzipFilenameExtension(fileName);
+	transform(
+			uncompressedFileName.begin(),
+			uncompressedFileName.end(),
+			uncompressedFileName.begin(), ::tolower);
+	const string::size_type dot = uncompressedFileName.find_last_of('.');
+	if ((dot == string::npos) || (dot == 0)) {
+		return (false);
+	}
+	const string extension = uncompressedFileName.substr(dot);
+	return ((extension == INPUT_FILE_FILENAME_EXTENSION_TSP) || (extension == INPUT_FILE_FILENAME_EXTENSION_ATSP));
+}
+
+
+int tsplibOpen(const char *fileName, TSPLIBInstance **instance) {
+	if ((fileName == 0) || (instance == 0)) {
+		return (TSPLIB_ERROR_ARGUMENT);
+	}
+	if (!hasTSPLIBFilenameExtension(fileName)) {
+		return (TSPLIB_ERROR_FORMAT);
+	}
+
+	TransformInstance *transformInstance = 0;
+	try {
+		transformInstance = readInputFileTSPLIB(fileName);
+		TSPLIBInstance *tsplibInstance = new TSPLIBInstance();
+		tsplibInstance->transformInstance = transformInstance;
+		tsplibInstance->name = transformInstance->getName();
+		tsplibInstance->description = transformInstance->getDescription();
+		*instance = tsplibInstance;
+	}
+	catch (InputFileFormatNotSupported &e) {
+		return (TSPLIB_ERROR_FORMAT);
+	}
+	catch (ios::failure &e) {
+		return (TSPLIB_ERROR_FILE);
+	}
+	catch (bad_alloc &e) {
+		delete transformInstance;
+		return (TSPLIB_ERROR_MEMORY);
+	}
+	catch ( ... ) {
+		//Range and overflow errors of the values.
+		delete transformInstance;
+		return (TSPLIB_ERROR_FILE);
+	}
+	return (TSPLIB_OK);
+}
+
+void tsplibClose(TSPLIBInstance *instance) {
+	if (instance == 0) {
+		return;
+	}
+	delete instance->transformInstance;
+	delete instance;
+}
+
+const char *tsplibGetName(const TSPLIBInstance *instance) {
+	return (instance->name.c_str());
+}
+
+const char *tsplibGetDescription(const TSPLIBInstance *instance) {
+	return (instance->description.c_str());
+}
+
+int tsplibIsSymmetric(const TSPLIBInstance *instance) {
+	return ((instance->transformInstance->getType() == VALUE_TYPE_TSP) ? 1 : 0);
+}
+
+unsigned long long tsplibGetDimension(const TSPLIBInstance *instance) {
+	return (static_cast<unsigned long long>(instance->transformInstance->getN()));
+}
+
+int tsplibHasCoordinates(const TSPLIBInstance *instance) {
+	return ((instance->transformInstance->hasCoordinates()) ? 1 : 0);
+}
+
+int tsplibCopyCosts(const TSPLIBInstance *instance, double *costs, unsigned long long size) {
+	if ((instance == 0) || (costs == 0)) {
+		return (TSPLIB_ERROR_ARGUMENT);
+	}
+	const TransformInstance *transformInstance = instance->transformInstance;
+	const vector<double>::size_type n = transformInstance->getN();
+	if (size < static_cast<unsigned long long>(n) * n) {
+		return (TSPLIB_ERROR_ARGUMENT);
+	}
+
+	const bool symmetric = (transformInstance->getType() == VALUE_TYPE_TSP);
+	for (vector<vector<double> >::size_type i = 0; i < n; i++) {
+		double *row = costs + i * n;
+		for (vector<double>::size_type j = 0; j < n; j++) {
+			row[j] = ((symmetric) && (j == i)) ? 0.0 : transformInstance->getAdjacencyMatrixElement(i, j);
+		}
+	}
+	return (TSPLIB_OK);
+}
+
+int tsplibCopyLowerCosts(const TSPLIBInstance *instance, double *costs, unsigned long long size) {
+	if ((instance == 0) || (costs == 0) || (tsplibIsSymmetric(instance) == 0)) {
+		return (TSPLIB_ERROR_ARGUMENT);
+	}
+	const TransformInstance *transformInstance = instance->transformInstance;
+	const vector<double>::size_type n = transformInstance->getN();
+	if ((n > 0) && (size < static_cast<unsigned long long>(n) * (n - 1) / 2)) {
+		return (TSPLIB_ERROR_ARGUMENT);
+	}
+
+	for (vector<vector<double> >::size_type i = 1; i < n; i++) {
+		double *row = costs + i * (i - 1) / 2;
+		for (vector<double>::size_type j = 0; j < i; j++) {
+			row[j] = transformInstance->getAdjacencyMatrixElement(i, j);
+		}
+	}
+	return (TSPLIB_OK);
+}
+
+int tsplibCopyCoordinates(const TSPLIBInstance *instance, double *x, double *y, unsigned long long size) {
+	if ((instance == 0) || (x == 0) || (y == 0) || (!instance->transformInstance->hasCoordinates())) {
+		return (TSPLIB_ERROR_ARGUMENT);
+	}
+	const vector<double> &xCoordinates = instance->transformInstance->getXCoordinates();
+	const vector<double> &yCoordinates = instance->transformInstance->getYCoordinates();
+	if (size < xCoordinates.size()) {
+		return (TSPLIB_ERROR_ARGUMENT);
+	}
+
+	for (vector<double>::size_type i = 0; i < xCoordinates.size(); i++) {
+		x[i] = xCoordinates[i];
+		y[i] = yCoordinates[i];
+	}
+	return (TSPLIB_OK);
+}
+
+const char *tsplibGetStatusMessage(int status) {
+	switch (status) {
+	case TSPLIB_OK:
+		return ("succeeded");
+	case TSPLIB_ERROR_ARGUMENT:
+		return ("an argument is not valid");
+	case TSPLIB_ERROR_FILE:
+		return ("the file does not exist, is not valid or is damaged");
+	case TSPLIB_ERROR_FORMAT:
+		return ("the file format is not supported");
+	case TSPLIB_ERROR_MEMORY:
+		return ("the instance is too large");
+	default:
+		return ("unknown status");
+	}
+}
@@ -0,0 +1,157 @@
+/**
+ * @file TSPLIBLibrary.hpp
+ * Defines the C interface of the shared library libtsplib.so. The
+ * library reads the TSPLIB files with the same code as TransformTSPLIB
+ * (including the rounding of the costs), so programs can load an
+ * instance in process without converting it to the xml structure first.
+ * The interface uses only C types and can be included by C99 programs.
+ * No function throws an exception; errors are reported by status codes.
+ *
+ * A typical use:
+ *   TSPLIBInstance *instance;
+ *   if (tsplibOpen("pr2392.tsp", &instance) == TSPLIB_OK) {
+ *     unsigned long long n = tsplibGetDimension(instance);
+ *     double *costs = malloc(n * n * sizeof(double));
+ *     tsplibCopyCosts(instance, costs, n * n);
+ *     tsplibClose(instance);
+ *   }
+ *
+ * @brief Defines the C interface of the shared library libtsplib.so.
+ */
+
+#ifndef _TSPLIBLibrary_HPP_
+#define _TSPLIBLibrary_HPP_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Status: Succeeded.
+ */
+#define TSPLIB_OK 0
+
+/**
+ * Status: An argument is not valid (e.g. a null pointer or a too small array).
+ */
+#define TSPLIB_ERROR_ARGUMENT 1
+
+/**
+ * Status: The file does not exist, cannot be read or is damaged.
+ */
+#define TSPLIB_ERROR_FILE 2
+
+/**
+ * Status: The file format is not supported.
+ */
+#define TSPLIB_ERROR_FORMAT 3
+
+/**
+ * Status: The instance is too large.
+ */
+#define TSPLIB_ERROR_MEMORY 4
+
+
+/**
+ * An instance read from a TSPLIB file (opaque).
+ */
+typedef struct TSPLIBInstance TSPLIBInstance;
+
+
+/**
+ * Reads a TSPLIB file (".tsp" or ".atsp", optionally compressed: ".gz").
+ * @param fileName Name of the file.
+ * @param instance The read instance (only set if succeeded; has to be
+ *   released by tsplibClose).
+ * @return Status (TSPLIB_OK if succeeded).
+ */
+int tsplibOpen(const char *fileName, TSPLIBInstance **instance);
+
+/**
+ * Releases an instance.
+ * @param instance The instance (can be 0).
+ */
+void tsplibClose(TSPLIBInstance *instance);
+
+/**
+ * Returns the name of an instance.
+ * @param instance The instance.
+ * @return Name of the instance (valid until the instance is released).
+ */
+const char *tsplibGetName(const TSPLIBInstance *instance);
+
+/**
+ * Returns the description of an instance.
+ * @param instance The instance.
+ * @return Description of the instance (valid until the instance is released).
+ */
+const char *tsplibGetDescription(const TSPLIBInstance *instance);
+
+/**
+ * Returns true if an instance is symmetric ("TSP").
+ * @param instance The instance.
+ * @return 1 if the instance is symmetric, 0 if it is asymmetric ("ATSP").
+ */
+int tsplibIsSymmetric(const TSPLIBInstance *instance);
+
+/**
+ * Returns the number of vertices of an instance.
+ * @param instance The instance.
+ * @return Number of vertices.
+ */
+unsigned long long tsplibGetDimension(const TSPLIBInstance *instance);
+
+/**
+ * Returns true if the vertices of an instance are given by coordinates.
+ * @param instance The instance.
+ * @return 1 if the coordinates are known, 0 otherwise.
+ */
+int tsplibHasCoordinates(const TSPLIBInstance *instance);
+
+/**
+ * Copies the full matrix of the costs row by row: the cost of the edge
+ * (i, j) is costs[i * n + j]. The main diagonal of symmetric instances
+ * is not defined and is copied as 0.
+ * @param instance The instance.
+ * @param costs Array of at least n * n doubles.
+ * @param size Size of the array.
+ * @return Status (TSPLIB_OK if succeeded).
+ */
+int tsplibCopyCosts(const TSPLIBInstance *instance, double *costs, unsigned long long size);
+
+/**
+ * Copies the strictly lower triangular matrix of the costs of a
+ * symmetric instance row by row: the cost of the edge (i, j) with j < i
+ * is costs[i * (i - 1) / 2 + j] (the layout of the binary instance format).
+ * @param instance The instance.
+ * @param costs Array of at least n * (n - 1) / 2 doubles.
+ * @param size Size of the array.
+ * @return Status (TSPLIB_OK if succeeded, TSPLIB_ERROR_ARGUMENT for asymmetric instances).
+ */
+int tsplibCopyLowerCosts(const TSPLIBInstance *instance, double *costs, unsigned long long size);
+
+/**
+ * Copies the coordinates of the vertices.
+ * @param instance The instance.
+ * @param x Array of at least n doubles for the x-coordinates.
+ * @param y Array of at least n doubles for the y-coordinates.
+ * @param size Size of the arrays.
+ * @return Status (TSPLIB_OK if succeeded, TSPLIB_ERROR_ARGUMENT if the
+ *   instance is not given by coordinates).
+ */
+int tsplibCopyCoordinates(const TSPLIBInstance *instance, double *x, double *y, unsigned long long size);
+
+/**
+ * Returns the message of a status.
+ * @param status The status.
+ * @return The message.
+ */
+const char *tsplibGetStatusMessage(int status);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @file TourKernels.cpp
+ * Defines the tour kernels.
+ *
+ * @brief Defines the tour kernels.
+ */
+
+#include <algorithm>
+
+#include "TourKernels.hpp"
+
+using namespace std;
+
+
+double TourCosts::getTourLength(const int *tour, const std::size_t size) const {
+	double length = 0.0;
+	if (layout != COST_LAYOUT_COORDINATES) {
+		for (std::size_t k = 0; k < size; k++) {
+			const std::size_t from = static_cast<std::size_t>(tour[k]);
+			const std::size_t to = static_cast<std::size_t>(tour[(k + 1 < size) ? (k + 1) : 0]);
+			length += getCost(from, to);
+		}
+		return (length);
+	}
+
+	double x1[METRIC_KERNEL_BLOCK_SIZE];
+	double y1[METRIC_KERNEL_BLOCK_SIZE];
+	double x2[METRIC_KERNEL_BLOCK_SIZE];
+	double y2[METRIC_KERNEL_BLOCK_SIZE];
+
+	for (std::size_t start = 0; start < size; start += METRIC_KERNEL_BLOCK_SIZE) {
+		const std::size_t blockSize = min(METRIC_KERNEL_BLOCK_SIZE, size - start);
+		//Gathers the edges {tour[k], tour[k + 1]} of the block (the last edge closes the tour).
+		for (std::size_t k = 0; k < blockSize; k++) {
+			const std::size_t from = static_cast<std::size_t>(tour[start + k]);
+			const std::size_t to = static_cast<std::size_t>(tour[(start + k + 1 < size) ? (start + k + 1) : 0]);
+			x1[k] = costs[from];
+			y1[k] = y[from];
+			x2[k] = costs[to];
+			y2[k] = y[to];
+		}
+		length += computeBlockCost(metric, rounded, x1, y1, x2, y2, blockSize);
+	}
+	return (length);
+}
+
+double TourCosts::findTwoOptMove(
+		const int *tour,
+		const int *position,
+		const int *neighbours,
+		const std::size_t k,
+		std::size_t move[2]) const {
+	double bestGain = 0.0;
+	for (std::size_t i = 0; i < n; i++) {
+		const std::size_t a = static_cast<std::size_t>(tour[i]);
+		const std::size_t b = static_cast<std::size_t>(tour[(i + 1 < n) ? (i + 1) : 0]);
+		const double costAB = getCost(a, b);
+		const int *neighboursOfA = neighbours + a * k;
+		for (std::size_t l = 0; l < k; l++) {
+			const std::size_t c = static_cast<std::size_t>(neighboursOfA[l]);
+			const double costAC = getCost(a, c);
+			if (costAC >= costAB) {
+				//The lists are sorted: no further neighbour can give a gain.
+				break;
+			}
+			const std::size_t j = static_cast<std::size_t>(position[c]);
+			const std::size_t d = static_cast<std::size_t>(tour[(j + 1 < n) ? (j + 1) : 0]);
+			if ((c == b) || (d == a)) {
+				continue;
+			}
+			const double gain = costAB + getCost(c, d) - costAC - getCost(b, d);
+			if (gain > bestGain) {
+				bestGain = gain;
+				move[0] = i;
+				move[1] = j;
+			}
+		}
+	}
+	return (bestGain);
+}
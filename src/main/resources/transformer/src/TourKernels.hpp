@@ -0,0 +1,168 @@
+/**
+ * @file TourKernels.hpp
+ * Defines the tour kernels of the shared library libtspkernels.so: the
+ * length of a tour and the scan of the 2-opt moves along the neighbour
+ * lists. The kernels work on buffers owned by the caller (e.g. direct
+ * buffers of the Java solvers): a full or a strictly lower triangular
+ * matrix of the costs, or the coordinates of the vertices with a metric
+ * of the metric kernels. Nothing is copied.
+ *
+ * @brief Defines the tour kernels.
+ */
+
+#ifndef _TourKernels_HPP_
+#define _TourKernels_HPP_
+
+#include <cstddef>
+
+#include "MetricKernels.hpp"
+
+
+/**
+ * Layout of the costs.
+ */
+enum CostLayout {
+	/**
+	 * Full matrix row by row: the cost of (i, j) is costs[i * n + j].
+	 */
+	COST_LAYOUT_FULL_MATRIX,
+
+	/**
+	 * Strictly lower triangular matrix row by row: the cost of {i, j}
+	 * with j < i is costs[i * (i - 1) / 2 + j] (the layout of the binary
+	 * instance format).
+	 */
+	COST_LAYOUT_LOWER_MATRIX,
+
+	/**
+	 * Coordinates of the vertices ("GEO": latitudes and longitudes in
+	 * radians); the costs are computed by the metric kernels.
+	 */
+	COST_LAYOUT_COORDINATES
+};
+
+
+/**
+ * View of the costs of an instance in buffers owned by the caller.
+ */
+class TourCosts {
+private:
+	/**
+	 * Layout of the costs.
+	 */
+	CostLayout layout;
+
+	/**
+	 * Metric of the coordinates (only COST_LAYOUT_COORDINATES).
+	 */
+	Metric metric;
+
+	/**
+	 * True if the costs of the coordinates are rounded as defined by the
+	 * TSPLIB (only COST_LAYOUT_COORDINATES).
+	 */
+	bool rounded;
+
+	/**
+	 * Number of vertices.
+	 */
+	std::size_t n;
+
+	/**
+	 * The matrix or the x-coordinates.
+	 */
+	const double *costs;
+
+	/**
+	 * The y-coordinates (only COST_LAYOUT_COORDINATES).
+	 */
+	const double *y;
+
+public:
+	/**
+	 * Constructor for the class TourCosts.
+	 * @param layout Layout of the costs.
+	 * @param metric Metric of the coordinates.
+	 * @param rounded True if the costs of the coordinates are rounded.
+	 * @param n Number of vertices.
+	 * @param costs The matrix or the x-coordinates.
+	 * @param y The y-coordinates (0 for the matrices).
+	 */
+	inline TourCosts(
+			const CostLayout layout,
+			const Metric metric,
+			const bool rounded,
+			const std::size_t n,
+			const double *costs,
+			const double *y) {
+		this->layout = layout;
+		this->metric = metric;
+		this->rounded = rounded;
+		this->n = n;
+		this->costs = costs;
+		this->y = y;
+	}
+
+	/**
+	 * Returns the number of vertices.
+	 * @return Number of vertices.
+	 */
+	inline std::size_t getN() const {
+		return (n);
+	}
+
+	/**
+	 * Returns the cost of an edge.
+	 * @param i First vertex (0-based).
+	 * @param j Second vertex (0-based, j != i).
+	 * @return The cost of the edge (i, j).
+	 */
+	inline double getCost(const std::size_t i, const std::size_t j) const {
+		switch (layout) {
+		case COST_LAYOUT_FULL_MATRIX:
+			return (costs[i * n + j]);
+		case COST_LAYOUT_LOWER_MATRIX:
+			return ((j < i) ? costs[i * (i - 1) / 2 + j] : costs[j * (j - 1) / 2 + i]);
+		case COST_LAYOUT_COORDINATES:
+			break;
+		}
+		return (computeBlockCost(metric, rounded, &costs[i], &y[i], &costs[j], &y[j], 1));
+	}
+
+	/**
+	 * Returns the length of a tour. The coordinates of a block of
+	 * consecutive vertices are gathered and their costs are computed by
+	 * the (vectorizable) metric kernels; the matrices are read directly.
+	 * @param tour The tour: a permutation of the vertices (0-based).
+	 * @param size Number of vertices of the tour.
+	 * @return Length of the tour (including the edge back to tour[0]).
+	 */
+	double getTourLength(const int *tour, const std::size_t size) const;
+
+	/**
+	 * Finds the best improving 2-opt move among the candidate edges:
+	 * for every edge (a, b) of the tour, the neighbours c of a that are
+	 * closer to a than b are tried, replacing (a, b) and (c, d) by (a, c)
+	 * and (b, d), where d is the successor of c. The neighbour lists have
+	 * to be sorted by increasing cost. The costs have to be symmetric.
+	 * @param tour The tour: a permutation of the vertices (0-based).
+	 * @param position Positions of the vertices in the tour.
+	 * @param neighbours Neighbour lists: the neighbours of the vertex v
+	 *   are neighbours[v * k] to neighbours[v * k + k - 1].
+	 * @param k Number of neighbours of every vertex.
+	 * @param move The best move: the positions i and j of a and c (only
+	 *   set if an improving move was found); reversing the tour between
+	 *   the positions i + 1 and j applies it.
+	 * @return The gain of the best move (0 if the tour is 2-optimal with
+	 *   respect to the neighbour lists).
+	 */
+	double findTwoOptMove(
+			const int *tour,
+			const int *position,
+			const int *neighbours,
+			const std::size_t k,
+			std::size_t move[2]) const;
+};
+
+
+#endif
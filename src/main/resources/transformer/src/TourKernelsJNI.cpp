@@ -0,0 +1,242 @@
+/**
+ * @file TourKernelsJNI.cpp
+ * Defines the Java Native Interface binding of the shared library
+ * libtspkernels.so for the class jo.ju.edu.tsp.core.kernels.NativeTourKernels.
+ * The costs are read from direct buffers in place; the arrays of the
+ * tours and of the neighbour lists are accessed as critical arrays, so
+ * nothing is copied. Invalid arguments are thrown as
+ * java.lang.IllegalArgumentException.
+ *
+ * @brief Defines the Java Native Interface binding of libtspkernels.so.
+ */
+
+#include <cstddef>
+
+#include <jni.h>
+
+#include "TourKernels.hpp"
+
+
+/**
+ * Throws java.lang.IllegalArgumentException.
+ * @param env The JNI environment.
+ * @param message Message of the exception.
+ */
+void throwIllegalArgumentException(JNIEnv *env, const char *message) {
+	jclass exceptionClass = env->FindClass("java/lang/IllegalArgumentException");
+	if (exceptionClass != 0) {
+		env->ThrowNew(exceptionClass, message);
+	}
+}
+
+/**
+ * Returns the address of a direct buffer of doubles if it holds at
+ * least a given number of doubles.
+ * @param env The JNI environment.
+ * @param buffer The buffer (can be 0).
+ * @param size Number of doubles.
+ * @return The address or 0 if the buffer is not valid.
+ */
+const double *getDirectBufferOfDoubles(JNIEnv *env, jobject buffer, const std::size_t size) {
+	if (buffer == 0) {
+		return (0);
+	}
+	const jlong capacity = env->GetDirectBufferCapacity(buffer);
+	if ((capacity < 0) || (static_cast<std::size_t>(capacity) / sizeof(double) < size)) {
+		return (0);
+	}
+	return (static_cast<const double *>(env->GetDirectBufferAddress(buffer)));
+}
+
+/**
+ * Returns the view of the costs given by the arguments of a native
+ * method, or throws java.lang.IllegalArgumentException.
+ * @param env The JNI environment.
+ * @param layout Layout of the costs (CostLayout).
+ * @param metric Metric of the coordinates (Metric).
+ * @param rounded True if the costs of the coordinates are rounded.
+ * @param n Number of vertices.
+ * @param costs Direct buffer with the matrix or the x-coordinates.
+ * @param y Direct buffer with the y-coordinates (can be 0 for the matrices).
+ * @param tourCosts The view (only set if valid).
+ * @return
+ *   <ul>
+ *     <li>true if the arguments are valid,</li>
+ *     <li>false if an exception was thrown.</li>
+ *   </ul>
+ */
+bool getTourCosts(
+		JNIEnv *env,
+		const jint layout,
+		const jint metric,
+		const jboolean rounded,
+		const jint n,
+		jobject costs,
+		jobject y,
+		TourCosts &tourCosts) {
+	if ((n < 0) || (metric < METRIC_EUC_2D) || (metric > METRIC_GEO)) {
+		throwIllegalArgumentException(env, "invalid number of vertices or metric");
+		return (false);
+	}
+	const std::size_t vertices = static_cast<std::size_t>(n);
+	std::size_t size = 0;
+	switch (layout) {
+	case COST_LAYOUT_FULL_MATRIX:
+		size = vertices * vertices;
+		break;
+	case COST_LAYOUT_LOWER_MATRIX:
+		size = (vertices > 0) ? vertices * (vertices - 1) / 2 : 0;
+		break;
+	case COST_LAYOUT_COORDINATES:
+		size = vertices;
+		break;
+	default:
+		throwIllegalArgumentException(env, "invalid layout of the costs");
+		return (false);
+	}
+
+	const double *costsAddress = getDirectBufferOfDoubles(env, costs, size);
+	const double *yAddress = (layout == COST_LAYOUT_COORDINATES) ? getDirectBufferOfDoubles(env, y, size) : 0;
+	if ((costsAddress == 0) || ((layout == COST_LAYOUT_COORDINATES) && (yAddress == 0))) {
+		throwIllegalArgumentException(env, "the costs are not a direct buffer of the expected size");
+		return (false);
+	}
+	tourCosts = TourCosts(
+			static_cast<CostLayout>(layout),
+			static_cast<Metric>(metric),
+			rounded == JNI_TRUE,
+			vertices,
+			costsAddress,
+			yAddress);
+	return (true);
+}
+
+/**
+ * Returns true if all elements of an array are vertices.
+ * @param elements The elements.
+ * @param size Number of elements.
+ * @param n Number of vertices.
+ * @return
+ *   <ul>
+ *     <li>true if 0 <= elements[i] < n for all i,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool areVertices(const jint *elements, const std::size_t size, const jint n) {
+	for (std::size_t i = 0; i < size; i++) {
+		if ((elements[i] < 0) || (elements[i] >= n)) {
+			return (false);
+		}
+	}
+	return (true);
+}
+
+
+extern "C" {
+
+JNIEXPORT jdouble JNICALL Java_jo_ju_edu_tsp_core_kernels_NativeTourKernels_getTourLength(
+		JNIEnv *env,
+		jclass,
+		jint layout,
+		jint metric,
+		jboolean rounded,
+		jint n,
+		jobject costs,
+		jobject y,
+		jintArray tour) {
+	TourCosts tourCosts(COST_LAYOUT_FULL_MATRIX, METRIC_EUC_2D, false, 0, 0, 0);
+	if (!getTourCosts(env, layout, metric, rounded, n, costs, y, tourCosts)) {
+		return (0.0);
+	}
+	if (tour == 0) {
+		throwIllegalArgumentException(env, "the tour is null");
+		return (0.0);
+	}
+	const std::size_t size = static_cast<std::size_t>(env->GetArrayLength(tour));
+	jint *tourElements = static_cast<jint *>(env->GetPrimitiveArrayCritical(tour, 0));
+	if (tourElements == 0) {
+		return (0.0);  //OutOfMemoryError is pending.
+	}
+	const bool valid = areVertices(tourElements, size, n);
+	const double length = (valid) ? tourCosts.getTourLength(tourElements, size) : 0.0;
+	env->ReleasePrimitiveArrayCritical(tour, tourElements, JNI_ABORT);
+	if (!valid) {
+		throwIllegalArgumentException(env, "the tour contains an invalid vertex");
+	}
+	return (length);
+}
+
+JNIEXPORT jdouble JNICALL Java_jo_ju_edu_tsp_core_kernels_NativeTourKernels_findTwoOptMove(
+		JNIEnv *env,
+		jclass,
+		jint layout,
+		jint metric,
+		jboolean rounded,
+		jint n,
+		jobject costs,
+		jobject y,
+		jintArray tour,
+		jintArray position,
+		jintArray neighbours,
+		jint k,
+		jintArray move) {
+	TourCosts tourCosts(COST_LAYOUT_FULL_MATRIX, METRIC_EUC_2D, false, 0, 0, 0);
+	if (!getTourCosts(env, layout, metric, rounded, n, costs, y, tourCosts)) {
+		return (0.0);
+	}
+	if ((tour == 0) || (position == 0) || (neighbours == 0) || (move == 0) || (k < 0) ||
+			(env->GetArrayLength(tour) != n) ||
+			(env->GetArrayLength(position) != n) ||
+			(static_cast<jlong>(env->GetArrayLength(neighbours)) < static_cast<jlong>(n) * k) ||
+			(env->GetArrayLength(move) < 2)) {
+		throwIllegalArgumentException(env, "the tour, the positions, the neighbour lists or the move are not valid");
+		return (0.0);
+	}
+
+	const std::size_t vertices = static_cast<std::size_t>(n);
+	const std::size_t neighbourListsSize = vertices * static_cast<std::size_t>(k);
+	jint *tourElements = static_cast<jint *>(env->GetPrimitiveArrayCritical(tour, 0));
+	jint *positionElements = static_cast<jint *>(env->GetPrimitiveArrayCritical(position, 0));
+	jint *neighbourElements = static_cast<jint *>(env->GetPrimitiveArrayCritical(neighbours, 0));
+	double gain = 0.0;
+	std::size_t bestMove[2] = {0, 0};
+	bool valid = false;
+	if ((tourElements != 0) && (positionElements != 0) && (neighbourElements != 0)) {
+		valid =
+				(areVertices(tourElements, vertices, n)) &&
+				(areVertices(positionElements, vertices, n)) &&
+				(areVertices(neighbourElements, neighbourListsSize, n));
+		if (valid) {
+			gain = tourCosts.findTwoOptMove(
+					tourElements,
+					positionElements,
+					neighbourElements,
+					static_cast<std::size_t>(k),
+					bestMove);
+		}
+	}
+	if (neighbourElements != 0) {
+		env->ReleasePrimitiveArrayCritical(neighbours, neighbourElements, JNI_ABORT);
+	}
+	if (positionElements != 0) {
+		env->ReleasePrimitiveArrayCritical(position, positionElements, JNI_ABORT);
+	}
+	if (tourElements != 0) {
+		env->ReleasePrimitiveArrayCritical(tour, tourElements, JNI_ABORT);
+	}
+	if ((tourElements == 0) || (positionElements == 0) || (neighbourElements == 0)) {
+		return (0.0);  //OutOfMemoryError is pending.
+	}
+	if (!valid) {
+		throwIllegalArgumentException(env, "the tour, the positions or the neighbour lists contain an invalid vertex");
+		return (0.0);
+	}
+
+	if (gain > 0.0) {
+		const jint moveElements[2] = {static_cast<jint>(bestMove[0]), static_cast<jint>(bestMove[1])};
+		env->SetIntArrayRegion(move, 0, 2, moveElements);
+	}
+	return (gain);
+}
+
+}
@@ -14,11 +14,15 @@
 #define _TransformConstantsClassesAndFunctions_HPP_
 
 #include <cmath>
+#include <cstddef>
+#include <limits>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <iomanip>
 
-#include <xercesc/util/PlatformUtils.hpp>
+#include "PermutationFormat.hpp"
+#include "Statistics.hpp"
 
 
 /**
@@ -223,6 +227,53 @@ const std::string XML_EDGE = "edge";
  */
 const std::string XML_EDGE_ATTRIBUTE_COST = "cost";
 
+/**
+ * Xml tag - attribute: Costs of all edges of the vertex in the order of
+ * the columns (compact encoding).
+ */
+const std::string XML_VERTEX_ATTRIBUTE_COSTS = "costs";
+
+/**
+ * Entry of the attribute "costs" for an edge which does not exist (the
+ * main diagonal of symmetric instances).
+ */
+const std::string XML_VALUE_ABSENT_COST = "-";
+
+/**
+ * Command-line option: The rows are written in the compact encoding.
+ */
+const std::string COMMAND_LINE_OPTION_COMPACT = "--compact";
+
+/**
+ * Command-line option: The vertices are renumbered along a space-filling curve
+ * ("--renumber=hilbert" or "--renumber=morton").
+ */
+const std::string COMMAND_LINE_OPTION_RENUMBER = "--renumber=";
+
+/**
+ * Command-line option: An additional output file ("--emit=FILE"; the
+ * format is given by the filename extension, see TransformWriters.hpp).
+ */
+const std::string COMMAND_LINE_OPTION_EMIT = "--emit=";
+
+/**
+ * Command-line option: The number of the neighbours per vertex written
+ * to candidate files ("--knn=K").
+ */
+const std::string COMMAND_LINE_OPTION_KNN = "--knn=";
+
+/**
+ * Command-line option: Only a subinstance with M vertices is written
+ * ("--subsample=M").
+ */
+const std::string COMMAND_LINE_OPTION_SUBSAMPLE = "--subsample=";
+
+/**
+ * Command-line option: The subinstance is the window of the vertices
+ * O, ..., O + M - 1 ("--offset=O").
+ */
+const std::string COMMAND_LINE_OPTION_OFFSET = "--offset=";
+
 /**
  * Encoding of the xml file
  */
@@ -310,6 +361,15 @@ inline double roundToDoublePrecisionAndDoubleFloatField(double d) {
 }
 
 
+/**
+ * Appends a cost in the compact encoding to a string: integers are
+ * written as plain digits, other numbers with the least number of
+ * significant digits (15, 16 or 17) which is read back as the same double.
+ * @param d The cost.
+ * @param s The string.
+ */
+void appendCompactCost(const double d, std::string &s);
+
 /**
  * Exception class used if the input format of the tsp file is not supported.
  */
@@ -362,6 +422,18 @@ private:
 	 */
 	std::vector<std::vector<double> > adjacencyMatrix;
 
+	/**
+	 * The x-coordinates of the vertices (empty if the instance is not
+	 * given by coordinates).
+	 */
+	std::vector<double> xCoordinates;
+
+	/**
+	 * The y-coordinates of the vertices (empty if the instance is not
+	 * given by coordinates).
+	 */
+	std::vector<double> yCoordinates;
+
 	/**
 	 * Initializes the name, the source, the description and n
 	 * @param type Type of the instance.
@@ -448,8 +520,8 @@ public:
 
 	/**
 	 * Sets one element in the adjacency matrix. The parameters are not checked.
-	 * The new value will be rounded according to the constants DOUBLE_PRECISION
-	 * and IGNORED_DIGITS.
+	 * The value is saved as it is; the method roundAdjacencyMatrix rounds all
+	 * elements according to the constants DOUBLE_PRECISION and IGNORED_DIGITS.
 	 * @param i Row.
 	 * @param j Column.
 	 * @param value New value of the element on the i-th row and j-th column.
@@ -458,22 +530,85 @@ public:
 			const std::vector<std::vector<double> >::size_type i,
 			const std::vector<double>::size_type j,
 			const double value) {
-		double roundedValue = roundToDoublePrecisionAndDoubleFloatField(value);
 		if (type == VALUE_TYPE_TSP) {
 			if (i < j) {
 				adjacencyMatrix.at(
 						static_cast<std::vector<std::vector<double> >::size_type>(j)).at(
-								static_cast<std::vector<double>::size_type>(i)) = roundedValue;
+								static_cast<std::vector<double>::size_type>(i)) = value;
 			}
 			else {
-				adjacencyMatrix.at(i).at(j) = roundedValue;
+				adjacencyMatrix.at(i).at(j) = value;
 			}
 		}
 		else {  //if (type == VALUE_TYPE_ATSP)
-			adjacencyMatrix.at(i).at(j) = roundedValue;
+			adjacencyMatrix.at(i).at(j) = value;
 		}
 	}
 
+	/**
+	 * Rounds all elements of the adjacency matrix according to the
+	 * constants DOUBLE_PRECISION and IGNORED_DIGITS.
+	 */
+	void roundAdjacencyMatrix();
+
+	/**
+	 * Sets the coordinates of one vertex. The parameters are not checked.
+	 * @param i The vertex.
+	 * @param x The x-coordinate.
+	 * @param y The y-coordinate.
+	 */
+	void setCoordinates(const std::vector<double>::size_type i, const double x, const double y);
+
+	/**
+	 * Returns true if the instance is given by coordinates.
+	 * @return
+	 *   <ul>
+	 *     <li>true if the coordinates of the vertices are known,</li>
+	 *     <li>false otherwise.</li>
+	 *   </ul>
+	 */
+	inline bool hasCoordinates() const {
+		return (!xCoordinates.empty());
+	}
+
+	/**
+	 * Returns the x-coordinates of the vertices.
+	 * @return The x-coordinates (empty if the instance is not given by coordinates).
+	 */
+	inline const std::vector<double> &getXCoordinates() const {
+		return (xCoordinates);
+	}
+
+	/**
+	 * Returns the y-coordinates of the vertices.
+	 * @return The y-coordinates (empty if the instance is not given by coordinates).
+	 */
+	inline const std::vector<double> &getYCoordinates() const {
+		return (yCoordinates);
+	}
+
+	/**
+	 * Renumbers the vertices: the vertex order[i] gets the number i. The
+	 * adjacency matrix is copied, so the memory is needed twice for a
+	 * while. The parameter is not checked.
+	 * @param order The order of the vertices (a permutation of 0, ..., n - 1).
+	 */
+	void renumberVertices(const std::vector<std::size_t> &order);
+
+	/**
+	 * Restricts the instance to some of its vertices: the vertex
+	 * vertices[i] gets the number i, all other vertices are removed. The
+	 * adjacency matrix is copied, so the memory is needed for both
+	 * matrices for a while. The parameters are not checked.
+	 * @param vertices The kept vertices (distinct numbers less than n).
+	 * @param name New name of the instance.
+	 * @param description New description of the instance.
+	 */
+	void selectVertices(
+			const std::vector<std::size_t> &vertices,
+			const std::string &name,
+			const std::string &description);
+
 	/**
 	 * Returns one element in the adjacency matrix. The parameters are not checked.
 	 * @param i Row.
@@ -545,17 +680,45 @@ public:
  *   "EDGE_WEIGHT_TYPE:" (= "EXPLICIT"), "EDGE_WEIGHT_FORMAT:"
  *   (= "FULL_MATRIX"), "NODE_COORD_SECTION", matrix entries, "EOF".
  * @param inputFileName Name of the input file.
+ * @param statistics Statistics of the run (can be 0).
  * @return Instance of the class TransformInstance.
  */
-TransformInstance *readInputFileTSPLIB(const std::string &inputFileName);
+TransformInstance *readInputFileTSPLIB(
+		const std::string &inputFileName,
+		Statistics *statistics = 0);
+
+/**
+ * Writes a permutation file (see PermutationFormat.hpp) which maps the
+ * renumbered or the selected vertices back to the original vertices.
+ * @param fileName Name of the permutation file.
+ * @param transformInstance The renumbered instance.
+ * @param order The order of the vertices: the i-th element is the
+ *   original number of the vertex i (0-based).
+ * @param comment Comment of the file.
+ * @param type Value of the tag "TYPE:" (PERMUTATION_VALUE_TYPE or SELECTION_VALUE_TYPE).
+ * @throws std::ios::failure if the file cannot be written.
+ */
+void writePermutationFile(
+		const std::string &fileName,
+		const TransformInstance *transformInstance,
+		const std::vector<std::size_t> &order,
+		const std::string &comment,
+		const std::string &type = PERMUTATION_VALUE_TYPE);
 
 /**
  * Writes one instance of the class TransformInstance to an output file. The parameters are
  * not checked.
  * @param outputFileName Name of the output file.
  * @param transformInstance Instance of the class TransformInstance.
+ * @param compact True if every vertex should be written as one element
+ *   with the attribute "costs" instead of one element per edge.
+ * @param statistics Statistics of the run (can be 0).
  */
-void writeOutputFile(const std::string &outputFileName, const TransformInstance *transformInstance);
+void writeOutputFile(
+		const std::string &outputFileName,
+		const TransformInstance *transformInstance,
+		const bool compact = false,
+		Statistics *statistics = 0);
 
 /**
  * Writes one instance of the class TransformInstance to an output file without using a parser.
@@ -563,10 +726,15 @@ void writeOutputFile(const std::string &outputFileName, const TransformInstance
  * file is a valid xml file. The parameters are not checked.
  * @param outputFileName Name of the output file.
  * @param transformInstance Instance of the class TransformInstance.
+ * @param compact True if every vertex should be written as one element
+ *   with the attribute "costs" instead of one element per edge.
+ * @param statistics Statistics of the run (can be 0).
  */
 void writeOutputFileWithoutUsingAParser(
 		const std::string &outputFileName,
-		const TransformInstance *transformInstance);
+		const TransformInstance *transformInstance,
+		const bool compact = false,
+		Statistics *statistics = 0);
 
 
 #endif
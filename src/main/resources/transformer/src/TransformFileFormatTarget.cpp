@@ -0,0 +1,35 @@
+/**
+ * @file TransformFileFormatTarget.cpp
+ * Defines the format target writing compressed files.
+ *
+ * @brief Defines the format target writing compressed files.
+ */
+
+#include "TransformFileFormatTarget.hpp"
+
+using namespace std;
+
+
+TransformFileFormatTarget::TransformFileFormatTarget(const std::string &outputFileName) : XMLFormatTarget() {
+	outputFile.exceptions(ios::failbit | ios::badbit);
+	outputFile.open(outputFileName);
+}
+
+TransformFileFormatTarget::~TransformFileFormatTarget() {
+	if (outputFile.is_open()) {
+		//No exceptions can leave the destructor.
+		outputFile.exceptions(ios::goodbit);
+		outputFile.close();
+	}
+}
+
+void TransformFileFormatTarget::writeChars(
+		const XMLByte* const toWrite,
+		const XMLSize_t count,
+		XMLFormatter* const) {
+	outputFile.write(reinterpret_cast<const char *>(toWrite), static_cast<streamsize>(count));
+}
+
+void TransformFileFormatTarget::close() {
+	outputFile.close();
+}
@@ -0,0 +1,77 @@
+/**
+ * @file TransformFileFormatTarget.hpp
+ * Defines the format target of the DOM serializer which writes the
+ * output file through an OutputFileStream, so a file with the filename
+ * extension ".gz" is compressed while it is written.
+ *
+ * @brief Defines the format target writing compressed files.
+ */
+
+#ifndef _TransformFileFormatTarget_HPP_
+#define _TransformFileFormatTarget_HPP_
+
+#include <string>
+
+#include <xercesc/framework/XMLFormatter.hpp>
+
+#include "FileStreams.hpp"
+
+using namespace xercesc;
+
+XERCES_CPP_NAMESPACE_USE
+
+
+/**
+ * Implements an XMLFormatTarget writing to an OutputFileStream.
+ */
+class TransformFileFormatTarget : public XMLFormatTarget {
+private:
+	/**
+	 * The output file.
+	 */
+	OutputFileStream outputFile;
+
+	/**
+	 * Not implemented copy constructor for the class TransformFileFormatTarget.
+	 * @param transformFileFormatTarget Instance to be copied.
+	 */
+	TransformFileFormatTarget(const TransformFileFormatTarget &transformFileFormatTarget);
+
+	/**
+	 * Not implemented operator "=".
+	 * @param transformFileFormatTarget Right side of the operator.
+	 * @return Left side of the operator.
+	 */
+	TransformFileFormatTarget &operator=(const TransformFileFormatTarget &transformFileFormatTarget);
+
+public:
+	/**
+	 * Constructor for the class TransformFileFormatTarget. Opens the file.
+	 * @param outputFileName Name of the output file.
+	 * @throws std::ios::failure if the file cannot be opened.
+	 */
+	TransformFileFormatTarget(const std::string &outputFileName);
+
+	/**
+	 * Destructor for the class TransformFileFormatTarget.
+	 */
+	~TransformFileFormatTarget();
+
+	/**
+	 * Writes the serialized data.
+	 * @param toWrite The data.
+	 * @param count Number of the bytes.
+	 * @param formatter The formatter (not used).
+	 * @throws std::ios::failure if the data cannot be written.
+	 */
+	void writeChars(const XMLByte* const toWrite, const XMLSize_t count, XMLFormatter* const formatter);
+
+	/**
+	 * Writes the rest of the data and closes the file.
+	 * @throws std::ios::failure if the data cannot be written.
+	 */
+	void close();
+};
+
+
+#endif
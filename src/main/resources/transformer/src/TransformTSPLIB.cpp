@@ -46,7 +46,32 @@
  *   (= "FULL_MATRIX"), "NODE_COORD_SECTION", matrix entries, "EOF".
  * The program uses 2 different strategies to create the XML file.
  * The choice which one will be used is determined by the value
- * of the N_THRESHOLD constant.
+ * of the N_THRESHOLD constant. With the option "--compact" every
+ * vertex is written as one element whose attribute "costs" lists the
+ * costs of all columns; integral costs are written as plain digits.
+ * Files with the additional filename extension ".gz" (e.g.
+ * "pr2392.tsp.gz", "pr2392.xml.gz") are decompressed and compressed
+ * while they are read and written.
+ * With the option "--renumber=hilbert" or "--renumber=morton" the
+ * vertices of an instance given by coordinates are renumbered along the
+ * space-filling curve before they are written, so vertices close in the
+ * plane get close numbers. The original numbers are written to the
+ * permutation file next to the output file ("NAME.perm").
+ * With the option "--emit=FILE" (repeatable) the instance is written to
+ * further output files in the same run. The format of every file is given
+ * by its filename extension: ".xml", ".tspb" (binary matrix) or ".cand"
+ * (the k nearest neighbours of every vertex, "--knn=K", default 10). The
+ * input file is read only once and every row of the adjacency matrix is
+ * gathered once for all output files; the output file on the command
+ * line can be omitted if there is at least one "--emit" option.
+ * With the option "--subsample=M" only a subinstance with M vertices is
+ * written. The vertices of an instance given by coordinates are sampled
+ * along the Hilbert curve (one vertex of every M-th part of the curve),
+ * so the subinstance keeps the spatial distribution of the instance;
+ * otherwise, or with the option "--offset=O", the subinstance is the
+ * window of the vertices O + 1, ..., O + M (1-based). The original
+ * numbers of the vertices are written to the selection file next to the
+ * output file ("NAME.sel").
  *
  * @brief Transforms the instances of the TSPLIB to the xml structure.
  *
@@ -60,12 +85,18 @@
 #include <algorithm>
 #include <fstream>
 #include <sstream>
+#include <vector>
 
 #include <xercesc/util/XMLException.hpp>
 #include <xercesc/dom/DOMException.hpp>
 #include <xercesc/util/OutOfMemoryException.hpp>
 
 #include "TransformConstantsClassesAndFunctions.hpp"
+#include "FileStreams.hpp"
+#include "PermutationFormat.hpp"
+#include "SpaceFillingCurves.hpp"
+#include "CandidateFormat.hpp"
+#include "TransformWriters.hpp"
 
 using namespace std;
 using namespace xercesc;
@@ -81,11 +112,52 @@ XERCES_CPP_NAMESPACE_USE
 const vector<vector<double> >::size_type N_THRESHOLD = 4000;
 
 
+/**
+ * Returns the name of a file next to the output file with another
+ * filename extension ("pla7397.xml.gz", ".perm" -> "pla7397.perm").
+ * @param outputFileName Name of the output file.
+ * @param extension The filename extension of the file.
+ * @return Name of the file.
+ */
+string getSideFileName(const string &outputFileName, const string &extension) {
+	const string uncompressedOutputFileName = removeGzipFilenameExtension(outputFileName);
+	const string::size_type dot = uncompressedOutputFileName.find_last_of('.');
+	return (uncompressedOutputFileName.substr(0, dot) + extension);
+}
+
+/**
+ * Parses the number of an option (e.g. "--knn=K").
+ * @param s The number.
+ * @param value The parsed number (only set if succeeded).
+ * @return
+ *   <ul>
+ *     <li>true if the number is valid,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool parseUnsignedNumber(const string &s, vector<double>::size_type &value) {
+	if ((s.empty()) || (s.find_first_not_of("0123456789") != string::npos)) {
+		return (false);
+	}
+	istringstream in(s);
+	vector<double>::size_type parsedValue;
+	if (!(in >> parsedValue)) {
+		return (false);
+	}
+	value = parsedValue;
+	return (true);
+}
+
+
 /**
  * The main function.
- * @param argc Number of elements in the array argv, in particular 1 or 4.
+ * @param argc Number of elements in the array argv.
  * @param argv Name of the running program or name of the running program,
- *   the name of the input file and the name of the output file.
+ *   options ("--compact", "--renumber=hilbert", "--renumber=morton",
+ *   "--emit=FILE", "--knn=K", "--subsample=M", "--offset=O", "--stats" or
+ *   "--stats=json"), the name of
+ *   the input file and the name of the output file (optional if there is
+ *   an option "--emit").
  * @return
  *   <ul>
  *     <li>0 if succeeded,</li>
@@ -101,8 +173,66 @@ int main(int argc, char* argv[]) {
 
 	string inputFileName = "";
 	string outputFileName = "";
-	switch (argc) {
-	case 1:
+	StatisticsFormat statisticsFormat = STATISTICS_NONE;
+	bool compact = false;
+	bool renumber = false;
+	SpaceFillingCurve curve = CURVE_HILBERT;
+	vector<string> emittedFileNames;
+	vector<double>::size_type k = CANDIDATE_DEFAULT_K;
+	bool subsample = false;
+	vector<double>::size_type m = 0;
+	bool window = false;
+	vector<double>::size_type offset = 0;
+	vector<string> fileNames;
+	for (int i = 1; i < argc; i++) {
+		const string argument = argv[i];
+		//The options have to precede the names of the files.
+		if ((!fileNames.empty()) || (argument.compare(0, 2, "--") != 0)) {
+			fileNames.push_back(argument);
+		}
+		else if (argument == COMMAND_LINE_OPTION_COMPACT) {
+			compact = true;
+		}
+		else if (argument.compare(0, COMMAND_LINE_OPTION_RENUMBER.size(), COMMAND_LINE_OPTION_RENUMBER) == 0) {
+			try {
+				curve = getSpaceFillingCurve(argument.substr(COMMAND_LINE_OPTION_RENUMBER.size()));
+			}
+			catch (SpaceFillingCurveNotSupported &e) {
+				cerr << "The command-line arguments are invalid!" << endl;
+				return (1);
+			}
+			renumber = true;
+		}
+		else if (argument.compare(0, COMMAND_LINE_OPTION_EMIT.size(), COMMAND_LINE_OPTION_EMIT) == 0) {
+			emittedFileNames.push_back(argument.substr(COMMAND_LINE_OPTION_EMIT.size()));
+		}
+		else if (argument.compare(0, COMMAND_LINE_OPTION_KNN.size(), COMMAND_LINE_OPTION_KNN) == 0) {
+			if ((!parseUnsignedNumber(argument.substr(COMMAND_LINE_OPTION_KNN.size()), k)) || (k < 1)) {
+				cerr << "The command-line arguments are invalid!" << endl;
+				return (1);
+			}
+		}
+		else if (argument.compare(0, COMMAND_LINE_OPTION_SUBSAMPLE.size(), COMMAND_LINE_OPTION_SUBSAMPLE) == 0) {
+			if ((!parseUnsignedNumber(argument.substr(COMMAND_LINE_OPTION_SUBSAMPLE.size()), m)) || (m < 1)) {
+				cerr << "The command-line arguments are invalid!" << endl;
+				return (1);
+			}
+			subsample = true;
+		}
+		else if (argument.compare(0, COMMAND_LINE_OPTION_OFFSET.size(), COMMAND_LINE_OPTION_OFFSET) == 0) {
+			if (!parseUnsignedNumber(argument.substr(COMMAND_LINE_OPTION_OFFSET.size()), offset)) {
+				cerr << "The command-line arguments are invalid!" << endl;
+				return (1);
+			}
+			window = true;
+		}
+		else if (!parseStatisticsOption(argument, statisticsFormat)) {
+			cerr << "The command-line arguments are invalid!" << endl;
+			return (1);
+		}
+	}
+	switch (fileNames.size()) {
+	case 0:
 	{
 		try {
 			cout <<
@@ -119,11 +249,21 @@ int main(int argc, char* argv[]) {
 	    }
 	}
 	break;
-	case 3:
+	case 1:
+	{
+		//The output file can be omitted if there are other output files.
+		if (emittedFileNames.empty()) {
+			cerr << "The command-line arguments are invalid!" << endl;
+			return (1);
+		}
+		inputFileName = fileNames[0];
+	}
+	break;
+	case 2:
 	{
-		inputFileName = argv[1];
+		inputFileName = fileNames[0];
 
-		outputFileName = argv[2];
+		outputFileName = fileNames[1];
 	}
 	break;
 	default:
@@ -133,12 +273,19 @@ int main(int argc, char* argv[]) {
 	}
 	}
 
-	//Checking of validity of the inputFileName and the ouptuFileName
+	Statistics *statistics = 0;
+	if (statisticsFormat != STATISTICS_NONE) {
+		statistics = new Statistics("TransformTSPLIB");
+	}
+
+	//Checking of validity of the inputFileName and the ouptuFileName (both can be compressed)
+	const string uncompressedInputFileName = removeGzipFilenameExtension(inputFileName);
+	const string uncompressedOutputFileName = removeGzipFilenameExtension(outputFileName);
 	string inputFileFilenameExtensionTSP;
-	if (inputFileName.size() >= INPUT_FILE_FILENAME_EXTENSION_TSP.size() + 1) {
+	if (uncompressedInputFileName.size() >= INPUT_FILE_FILENAME_EXTENSION_TSP.size() + 1) {
 		inputFileFilenameExtensionTSP =
-				inputFileName.substr(
-						inputFileName.size() - INPUT_FILE_FILENAME_EXTENSION_TSP.size(),
+				uncompressedInputFileName.substr(
+						uncompressedInputFileName.size() - INPUT_FILE_FILENAME_EXTENSION_TSP.size(),
 						INPUT_FILE_FILENAME_EXTENSION_TSP.size());
 	}
 	else {
@@ -146,25 +293,28 @@ int main(int argc, char* argv[]) {
 	}
 
 	string inputFileFilenameExtensionATSP;
-	if (inputFileName.size() >= INPUT_FILE_FILENAME_EXTENSION_ATSP.size() + 1) {
+	if (uncompressedInputFileName.size() >= INPUT_FILE_FILENAME_EXTENSION_ATSP.size() + 1) {
 		inputFileFilenameExtensionATSP =
-				inputFileName.substr(
-						inputFileName.size() - INPUT_FILE_FILENAME_EXTENSION_ATSP.size(),
+				uncompressedInputFileName.substr(
+						uncompressedInputFileName.size() - INPUT_FILE_FILENAME_EXTENSION_ATSP.size(),
 						INPUT_FILE_FILENAME_EXTENSION_ATSP.size());
 	}
 	else {
 		inputFileFilenameExtensionATSP = "";
 	}
 
+	//The output file can only be omitted if there are other output files.
+	const bool outputFileRequired = ((!outputFileName.empty()) || (emittedFileNames.empty()));
 	string outputFileFilenameExtension;
-	if (outputFileName.size() >= OUTPUT_FILE_FILENAME_EXTENSION.size() + 1) {
+	if (uncompressedOutputFileName.size() >= OUTPUT_FILE_FILENAME_EXTENSION.size() + 1) {
 		outputFileFilenameExtension =
-				outputFileName.substr(
-						outputFileName.size() - OUTPUT_FILE_FILENAME_EXTENSION.size(),
+				uncompressedOutputFileName.substr(
+						uncompressedOutputFileName.size() - OUTPUT_FILE_FILENAME_EXTENSION.size(),
 						OUTPUT_FILE_FILENAME_EXTENSION.size());
 	}
-	else {
+	else if (outputFileRequired) {
 		cerr << "The filename extension of the output file has to be  \"xml\"!" << endl;
+		delete statistics;
 		return (1);
 	}
 
@@ -185,16 +335,40 @@ int main(int argc, char* argv[]) {
 			(inputFileFilenameExtensionTSP != INPUT_FILE_FILENAME_EXTENSION_TSP) &&
 			(inputFileFilenameExtensionATSP != INPUT_FILE_FILENAME_EXTENSION_ATSP)) {
 		cerr << "The filename extension of the input file has to be  \"tsp\" or \"atsp\"!" << endl;
+		delete statistics;
 		return (1);
 	}
-	if (outputFileFilenameExtension != OUTPUT_FILE_FILENAME_EXTENSION) {
+	if ((outputFileRequired) && (outputFileFilenameExtension != OUTPUT_FILE_FILENAME_EXTENSION)) {
 		cerr << "The filename extension of the output file has to be  \"xml\"!" << endl;
+		delete statistics;
+		return (1);
+	}
+	if ((window) && (!subsample)) {
+		cerr << "The command-line arguments are invalid!" << endl;
+		delete statistics;
 		return (1);
 	}
 
+	vector<string> outputFileNames;
+	if (!outputFileName.empty()) {
+		outputFileNames.push_back(outputFileName);
+	}
+	for (vector<string>::size_type i = 0; i < emittedFileNames.size(); i++) {
+		if (!isOutputFileFormatSupported(emittedFileNames[i])) {
+			cerr <<
+					"The filename extension of the output file \"" << emittedFileNames[i] <<
+					"\" has to be \"xml\", \"tspb\" or \"cand\"!" << endl;
+			delete statistics;
+			return (1);
+		}
+		outputFileNames.push_back(emittedFileNames[i]);
+	}
+
 	//Writing the used filenames on the standard output
 	cout << "Input file: " << inputFileName << endl;
-	cout << "Output file: " << outputFileName << endl;
+	for (vector<string>::size_type i = 0; i < outputFileNames.size(); i++) {
+		cout << "Output file: " << outputFileNames[i] << endl;
+	}
 
 	cout << endl;
 
@@ -206,27 +380,32 @@ int main(int argc, char* argv[]) {
 
 	TransformInstance *transformInstance = 0;
 	try {
-		transformInstance = readInputFileTSPLIB(inputFileName);
+		transformInstance = readInputFileTSPLIB(inputFileName, statistics);
 	}
 	catch (InputFileFormatNotSupported &e) {
 	    cerr << "the file format of the file \"" << inputFileName << "\" is not supported!" << endl;
+	    delete statistics;
 	    return (1);
 	}
 	catch (ifstream::failure &e) {
 	    cerr << "the file \"" << inputFileName << "\" does not exists or is not valid" <<
 	    		" or is damaged!" << e.what() <<endl;
+	    delete statistics;
 	    return (1);
     }
 	catch (bad_alloc &e) {
 		cerr << "the input graph is too large!" << endl;
+	    delete statistics;
 	    return (1);
 	}
 	catch (range_error &e) {
 		cerr << "the range error occurs!" << endl;
+	    delete statistics;
 	    return (1);
 	}
 	catch ( ... ) {
 		cerr << "an exception occurs!" << endl;
+	    delete statistics;
 	    return (1);
 	}
 
@@ -234,45 +413,214 @@ int main(int argc, char* argv[]) {
 
 
 	/*
-	 * Writing of the input file.
+	 * Extracting of the subinstance.
+	 */
+	if (subsample) {
+		const string selectionFileName = getSideFileName(outputFileNames[0], SELECTION_FILENAME_EXTENSION);
+		const vector<double>::size_type n = transformInstance->getN();
+		//Instances given by coordinates are stratified, matrices are cut.
+		const bool stratified = ((transformInstance->hasCoordinates()) && (!window));
+		cout << "Extracting a subinstance with " << m << " vertices ... " << flush;
+		if ((m > n) || (offset > n - m)) {
+			cerr << "the subinstance does not fit into the " << n << " vertices of the file \"" <<
+					inputFileName << "\"!" << endl;
+			delete transformInstance;
+			delete statistics;
+			return (1);
+		}
+		try {
+			ScopedPhaseTimer subsamplingTimer(statistics, PHASE_SUBSAMPLING);
+			vector<size_t> vertices(m);
+			ostringstream name;
+			ostringstream method;
+			if (stratified) {
+				vertices = getSpaceFillingCurveSample(
+						transformInstance->getXCoordinates(),
+						transformInstance->getYCoordinates(),
+						m,
+						CURVE_HILBERT);
+				name << transformInstance->getName() << "-" << m;
+				method << "stratified along the " << getSpaceFillingCurveName(CURVE_HILBERT) << " curve";
+			}
+			else {
+				for (vector<size_t>::size_type i = 0; i < m; i++) {
+					vertices[i] = offset + i;
+				}
+				name << transformInstance->getName() << "-" << offset + 1 << "-" << offset + m;
+				method << "the vertices " << offset + 1 << " to " << offset + m;
+			}
+			ostringstream description;
+			description <<
+					"Subinstance of " << transformInstance->getName() << " with " << m << " of " << n <<
+					" vertices (" << method.str() << "): " << transformInstance->getDescription();
+			transformInstance->selectVertices(vertices, name.str(), description.str());
+			subsamplingTimer.stop();
+
+			writePermutationFile(
+					selectionFileName,
+					transformInstance,
+					vertices,
+					"Original numbers of the vertices of " + inputFileName + " (" + method.str() + ")",
+					SELECTION_VALUE_TYPE);
+		}
+		catch (bad_alloc &e) {
+			cerr << "the input graph is too large!" << endl;
+			delete transformInstance;
+			delete statistics;
+			return (1);
+		}
+		catch (ios::failure &e) {
+			cerr << "the file \"" << selectionFileName << "\" cannot be written!" << endl;
+			delete transformInstance;
+			delete statistics;
+			return (1);
+		}
+		cout << "OK" << endl;
+		cout << "Selection file: " << selectionFileName << endl;
+	}
+
+
+	/*
+	 * Renumbering of the vertices.
 	 */
-	cout << "Writing to the file \"" << outputFileName << "\" ... " << flush;
+	if (renumber) {
+		const string permutationFileName = getSideFileName(outputFileNames[0], PERMUTATION_FILENAME_EXTENSION);
+		cout << "Renumbering the vertices along the " << getSpaceFillingCurveName(curve) <<
+				" curve ... " << flush;
+		if (!transformInstance->hasCoordinates()) {
+			cerr << "the vertices of the file \"" << inputFileName <<
+					"\" can only be renumbered if they are given by coordinates!" << endl;
+			delete transformInstance;
+			delete statistics;
+			return (1);
+		}
+		try {
+			ScopedPhaseTimer renumberingTimer(statistics, PHASE_RENUMBERING);
+			const vector<size_t> order = getSpaceFillingCurveOrder(
+					transformInstance->getXCoordinates(),
+					transformInstance->getYCoordinates(),
+					curve);
+			transformInstance->renumberVertices(order);
+			renumberingTimer.stop();
+
+			writePermutationFile(
+					permutationFileName,
+					transformInstance,
+					order,
+					"Original numbers of the vertices of " + inputFileName +
+					" renumbered along the " + getSpaceFillingCurveName(curve) + " curve");
+		}
+		catch (bad_alloc &e) {
+			cerr << "the input graph is too large!" << endl;
+			delete transformInstance;
+			delete statistics;
+			return (1);
+		}
+		catch (ios::failure &e) {
+			cerr << "the file \"" << permutationFileName << "\" cannot be written!" << endl;
+			delete transformInstance;
+			delete statistics;
+			return (1);
+		}
+		cout << "OK" << endl;
+		cout << "Permutation file: " << permutationFileName << endl;
+	}
+
 
+	/*
+	 * Writing of the output files.
+	 */
+	vector<TransformRowWriter *> writers;
 	try {
-		//If the graph is small enough, use the safe method.
-		if (transformInstance->getN() <= N_THRESHOLD) {
-			writeOutputFile(outputFileName, transformInstance);
-		}  //If the graph is too big, create the XML file directly.
-		else {
-			writeOutputFileWithoutUsingAParser(outputFileName, transformInstance);
+		for (vector<string>::size_type i = 0; i < outputFileNames.size(); i++) {
+			//If the graph is small enough, use the safe method for xml files.
+			if (
+					(hasOutputFilenameExtension(outputFileNames[i], OUTPUT_FILE_FILENAME_EXTENSION)) &&
+					(transformInstance->getN() <= N_THRESHOLD)) {
+				cout << "Writing to the file \"" << outputFileNames[i] << "\" ... " << flush;
+				writeOutputFile(outputFileNames[i], transformInstance, compact, statistics);
+				cout << "OK" << endl;
+			}  //Otherwise, write the file directly in the common pass over the rows.
+			else {
+				writers.push_back(createTransformRowWriter(outputFileNames[i], compact, k));
+			}
+		}
+
+		if (!writers.empty()) {
+			cout << "Writing to the file" << ((writers.size() > 1) ? "s " : " ");
+			for (vector<TransformRowWriter *>::size_type i = 0; i < writers.size(); i++) {
+				cout << ((i > 0) ? ", " : "") << "\"" << writers[i]->getFileName() << "\"";
+			}
+			cout << " ... " << flush;
+			writeOutputFilesInOnePass(writers, transformInstance, statistics);
+			deleteTransformRowWriters(writers);
+			cout << "OK" << endl;
 		}
 	}
 	catch (bad_alloc &e) {
 		cerr << "the input graph is too large!" << endl;
+		deleteTransformRowWriters(writers);
+		delete transformInstance;
+	    delete statistics;
 	    return (1);
 	}
+	catch (ios::failure &e) {
+		cerr << "an output file cannot be written!" << endl;
+		deleteTransformRowWriters(writers);
+		delete transformInstance;
+		delete statistics;
+		return (1);
+	}
     catch (const OutOfMemoryException &e) {
 		cerr << "out of memory problem!" << endl;
+		deleteTransformRowWriters(writers);
 		delete transformInstance;
+		delete statistics;
 		return (1);
     }
     catch (const DOMException &e) {
 		cerr << "Xerces failed!" << endl;
+		deleteTransformRowWriters(writers);
 		delete transformInstance;
+		delete statistics;
 		return (1);
     }
 	catch (const XMLException &e) {
 		cerr << "Xerces failed!" << endl;
+		deleteTransformRowWriters(writers);
 		delete transformInstance;
+		delete statistics;
 		return (1);
 	}
 	catch ( ... ) {
 		cerr << "an exception occurs!" << endl;
+		deleteTransformRowWriters(writers);
 		delete transformInstance;
+		delete statistics;
 		return (1);
 	}
 
-	cout << "OK" << endl;
+
+	/*
+	 * Printing the statistics.
+	 */
+	if (statistics != 0) {
+		const unsigned long long n = static_cast<unsigned long long>(transformInstance->getN());
+		statistics->addBytesRead(getFileSize(inputFileName));
+		for (vector<string>::size_type i = 0; i < outputFileNames.size(); i++) {
+			statistics->addBytesWritten(getFileSize(outputFileNames[i]));
+		}
+		if (transformInstance->getType() == VALUE_TYPE_TSP) {
+			statistics->addEdges(n * (n - 1) / 2);
+		}
+		else {  //if (transformInstance->getType() == VALUE_TYPE_ATSP)
+			statistics->addEdges(n * n);
+		}
+
+		cout << endl;
+		statistics->print(cout, statisticsFormat);
+		delete statistics;
+	}
 
 
 	/*
@@ -0,0 +1,274 @@
+/**
+ * @file TransformWriters.cpp
+ * Defines the writers of the output formats of the transform programs.
+ *
+ * @brief Defines the writers of the output formats of the transform programs.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "BinaryInstanceFormat.hpp"
+#include "CandidateFormat.hpp"
+
+#include "TransformWriters.hpp"
+
+using namespace std;
+
+
+bool hasOutputFilenameExtension(const std::string &fileName, const std::string &extension) {
+	const string uncompressedFileName = removeGzipFilenameExtension(fileName);
+	if (uncompressedFileName.size() < extension.size() + 1) {
+		return (false);
+	}
+	string fileNameExtension = uncompressedFileName.substr(uncompressedFileName.size() - extension.size());
+	transform(
+			fileNameExtension.begin(),
+			fileNameExtension.end(),
+			fileNameExtension.begin(), ::tolower);
+	return (fileNameExtension == extension);
+}
+
+bool isOutputFileFormatSupported(const std::string &fileName) {
+	return (
+			(hasOutputFilenameExtension(fileName, OUTPUT_FILE_FILENAME_EXTENSION)) ||
+			(hasOutputFilenameExtension(fileName, BINARY_INSTANCE_FILENAME_EXTENSION)) ||
+			(hasOutputFilenameExtension(fileName, CANDIDATE_FILENAME_EXTENSION)));
+}
+
+
+TransformRowWriter::TransformRowWriter(const std::string &fileName) {
+	this->fileName = fileName;
+	outputFile.exceptions(ofstream::failbit | ofstream::badbit);
+}
+
+TransformRowWriter::~TransformRowWriter() {
+}
+
+
+TransformXMLRowWriter::TransformXMLRowWriter(const std::string &fileName, const bool compact) :
+		TransformRowWriter(fileName) {
+	this->compact = compact;
+}
+
+void TransformXMLRowWriter::begin(const TransformInstance *transformInstance) {
+	outputFile.open(fileName);
+
+	outputFile.setf(DOUBLE_FLOATFIELD, ios::floatfield);
+	outputFile <<
+			setprecision(static_cast<int>(TRANSFORM_DOUBLE_PRECISION));
+
+	outputFile << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\" ?>" << endl;
+	outputFile << "<travellingSalesmanProblemInstance>" << endl;
+	outputFile << endl;
+	outputFile << "  <name>" << transformInstance->getName() << "</name>" << endl;
+	outputFile << endl;
+	outputFile << "  <source>TSPLIB</source>" << endl;
+	outputFile << endl;
+	outputFile <<
+			"  <description>" <<
+			transformInstance->getDescription() <<
+			"</description>" <<
+			endl;
+	outputFile << endl;
+	outputFile <<
+			"  <doublePrecision>" <<
+			TRANSFORM_DOUBLE_PRECISION <<
+			"</doublePrecision>" <<
+			endl;
+	outputFile << endl;
+	outputFile << "  <ignoredDigits>" << TRANSFORM_IGNORED_DIGITS << "</ignoredDigits>" << endl;
+	outputFile << endl;
+	outputFile << "  <graph>" << endl;
+}
+
+void TransformXMLRowWriter::writeRow(
+		const TransformInstance *transformInstance,
+		const std::vector<std::vector<double> >::size_type i,
+		const std::vector<double> &costs) {
+	if (compact) {
+		compactCosts.clear();
+		for (vector<double>::size_type j = 0; j < costs.size(); j++) {
+			if (j > 0) {
+				compactCosts.append(" ");
+			}
+			if ((j == i) && (transformInstance->getType() == VALUE_TYPE_TSP)) {
+				compactCosts.append(XML_VALUE_ABSENT_COST);
+			}
+			else {
+				appendCompactCost(costs[j], compactCosts);
+			}
+		}
+		outputFile <<
+				"    <vertex " << XML_VERTEX_ATTRIBUTE_COSTS << "=\"" <<
+				compactCosts <<
+				"\"/>" <<
+				endl;
+		return;
+	}
+
+	outputFile << "    <vertex>" << endl;
+	for (vector<double>::size_type j = 0; j < costs.size(); j++) {
+		if ((j == i) && (transformInstance->getType() == VALUE_TYPE_TSP)) {
+			continue;
+		}
+		outputFile <<
+				"      <edge cost=\"" <<
+				costs[j] <<
+				"\">" <<
+				j <<
+				"</edge>"<<
+				endl;
+	}
+	outputFile << "    </vertex>" << endl;
+}
+
+void TransformXMLRowWriter::end(const TransformInstance *) {
+	outputFile << "  </graph>" << endl;
+	outputFile << endl;
+	outputFile << "</travellingSalesmanProblemInstance>" << endl;
+
+	outputFile.close();
+}
+
+
+TransformBinaryRowWriter::TransformBinaryRowWriter(const std::string &fileName) :
+		TransformRowWriter(fileName) {
+}
+
+void TransformBinaryRowWriter::begin(const TransformInstance *transformInstance) {
+	outputFile.open(fileName, true);
+
+	const unsigned int kind =
+			(transformInstance->getType() == VALUE_TYPE_TSP) ?
+					BINARY_INSTANCE_KIND_LOWER_MATRIX :
+					BINARY_INSTANCE_KIND_FULL_MATRIX;
+	writeBinaryInstanceHeader(
+			outputFile,
+			BinaryInstanceHeader(
+					kind,
+					BINARY_INSTANCE_METRIC_EXPLICIT,
+					static_cast<unsigned long long>(transformInstance->getN())));
+}
+
+void TransformBinaryRowWriter::writeRow(
+		const TransformInstance *transformInstance,
+		const std::vector<std::vector<double> >::size_type i,
+		const std::vector<double> &costs) {
+	//Symmetric instances: only the columns j < i.
+	const vector<double>::size_type columns =
+			(transformInstance->getType() == VALUE_TYPE_TSP) ? i : costs.size();
+	buffer.resize(8 * columns);
+	for (vector<double>::size_type j = 0; j < columns; j++) {
+		encodeBinaryDouble(costs[j], &buffer[8 * j]);
+	}
+	if (columns > 0) {
+		outputFile.write(&buffer[0], static_cast<streamsize>(buffer.size()));
+	}
+}
+
+void TransformBinaryRowWriter::end(const TransformInstance *) {
+	outputFile.close();
+}
+
+
+TransformCandidateRowWriter::TransformCandidateRowWriter(
+		const std::string &fileName,
+		const std::vector<double>::size_type k) : TransformRowWriter(fileName) {
+	this->k = k;
+}
+
+void TransformCandidateRowWriter::begin(const TransformInstance *transformInstance) {
+	const vector<double>::size_type n = transformInstance->getN();
+	k = min(k, (n > 0) ? n - 1 : 0);
+
+	outputFile.open(fileName);
+	outputFile << TAG_NAME << " " << transformInstance->getName() << "\n";
+	outputFile << TAG_TYPE << " " << CANDIDATE_VALUE_TYPE << "\n";
+	outputFile << TAG_DIMENSION << " " << n << "\n";
+	outputFile << CANDIDATE_TAG_CANDIDATES << " " << k << "\n";
+	outputFile << CANDIDATE_TAG_CANDIDATE_SECTION << "\n";
+}
+
+void TransformCandidateRowWriter::writeRow(
+		const TransformInstance *,
+		const std::vector<std::vector<double> >::size_type i,
+		const std::vector<double> &costs) {
+	edges.clear();
+	for (vector<double>::size_type j = 0; j < costs.size(); j++) {
+		if (j != i) {
+			edges.push_back(make_pair(costs[j], j));
+		}
+	}
+	partial_sort(edges.begin(), edges.begin() + static_cast<ptrdiff_t>(k), edges.end());
+
+	outputFile << i + 1;
+	for (vector<double>::size_type l = 0; l < k; l++) {
+		line.clear();
+		appendCompactCost(edges[l].first, line);
+		outputFile << " " << edges[l].second + 1 << " " << line;
+	}
+	outputFile << "\n";
+}
+
+void TransformCandidateRowWriter::end(const TransformInstance *) {
+	outputFile << TAG_EOF << "\n";
+	outputFile.close();
+}
+
+
+TransformRowWriter *createTransformRowWriter(
+		const std::string &fileName,
+		const bool compact,
+		const std::vector<double>::size_type k) {
+	if (hasOutputFilenameExtension(fileName, OUTPUT_FILE_FILENAME_EXTENSION)) {
+		return (new TransformXMLRowWriter(fileName, compact));
+	}
+	if (hasOutputFilenameExtension(fileName, BINARY_INSTANCE_FILENAME_EXTENSION)) {
+		return (new TransformBinaryRowWriter(fileName));
+	}
+	if (hasOutputFilenameExtension(fileName, CANDIDATE_FILENAME_EXTENSION)) {
+		return (new TransformCandidateRowWriter(fileName, k));
+	}
+	throw OutputFileFormatNotSupported();
+}
+
+void deleteTransformRowWriters(std::vector<TransformRowWriter *> &writers) {
+	for (vector<TransformRowWriter *>::size_type w = 0; w < writers.size(); w++) {
+		delete writers[w];
+	}
+	writers.clear();
+}
+
+void writeOutputFilesInOnePass(
+		const std::vector<TransformRowWriter *> &writers,
+		const TransformInstance *transformInstance,
+		Statistics *statistics) {
+	ScopedPhaseTimer serializationTimer(statistics, PHASE_SERIALIZATION);
+
+	for (vector<TransformRowWriter *>::size_type w = 0; w < writers.size(); w++) {
+		writers[w]->begin(transformInstance);
+	}
+
+	const vector<double>::size_type n = transformInstance->getN();
+	vector<double> costs(n);
+	for (vector<vector<double> >::size_type i = 0; i < n; i++) {
+		for (vector<double>::size_type j = 0; j < n; j++) {
+			if ((j == i) && (transformInstance->getType() == VALUE_TYPE_TSP)) {
+				costs[j] = 0.0;
+			}
+			else {
+				costs[j] = transformInstance->getAdjacencyMatrixElement(i, j);
+			}
+		}
+		for (vector<TransformRowWriter *>::size_type w = 0; w < writers.size(); w++) {
+			writers[w]->writeRow(transformInstance, i, costs);
+		}
+	}
+
+	for (vector<TransformRowWriter *>::size_type w = 0; w < writers.size(); w++) {
+		writers[w]->end(transformInstance);
+	}
+}
@@ -0,0 +1,291 @@
+/**
+ * @file TransformWriters.hpp
+ * Defines the writers of the output formats of the transform programs.
+ * Every writer gets the rows of the adjacency matrix one after the
+ * other, so one pass over the instance feeds all requested output
+ * files: every row is gathered from the adjacency matrix only once,
+ * whatever the number of the output files is.
+ * The format of an output file is given by its filename extension:
+ * <ul>
+ *   <li>".xml": the xml structure (see "--compact"),</li>
+ *   <li>".tspb": the binary instance format (see BinaryInstanceFormat.hpp),</li>
+ *   <li>".cand": the candidate format with the k nearest neighbours of
+ *     every vertex (see CandidateFormat.hpp).</li>
+ * </ul>
+ * All files can be compressed additionally (".gz").
+ *
+ * @brief Defines the writers of the output formats of the transform programs.
+ */
+
+#ifndef _TransformWriters_HPP_
+#define _TransformWriters_HPP_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "TransformConstantsClassesAndFunctions.hpp"
+#include "FileStreams.hpp"
+#include "Statistics.hpp"
+
+
+/**
+ * Exception class used if the filename extension of an output file is not supported.
+ */
+class OutputFileFormatNotSupported : public std::exception {
+public:
+	/**
+	 * Constructor for the class OutputFileFormatNotSupported.
+	 */
+	inline OutputFileFormatNotSupported() {
+	}
+};
+
+
+/**
+ * Returns true if the name of a file (without the filename extension
+ * ".gz") ends with the given filename extension (case insensitive).
+ * @param fileName Name of the file.
+ * @param extension Filename extension.
+ * @return
+ *   <ul>
+ *     <li>true if the name of the file ends with the extension,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool hasOutputFilenameExtension(const std::string &fileName, const std::string &extension);
+
+/**
+ * Returns true if the format of an output file is supported (".xml",
+ * ".tspb" or ".cand", all optionally followed by ".gz").
+ * @param fileName Name of the output file.
+ * @return
+ *   <ul>
+ *     <li>true if the format is supported,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool isOutputFileFormatSupported(const std::string &fileName);
+
+
+/**
+ * Writer of one output file which gets the instance row by row.
+ */
+class TransformRowWriter {
+protected:
+	/**
+	 * Name of the output file.
+	 */
+	std::string fileName;
+
+	/**
+	 * The output file.
+	 */
+	OutputFileStream outputFile;
+
+private:
+	/**
+	 * Not implemented copy constructor for the class TransformRowWriter.
+	 * @param transformRowWriter Instance to be copied.
+	 */
+	TransformRowWriter(const TransformRowWriter &transformRowWriter);
+
+	/**
+	 * Not implemented operator "=".
+	 * @param transformRowWriter Right side of the operator.
+	 * @return Left side of the operator.
+	 */
+	TransformRowWriter &operator=(const TransformRowWriter &transformRowWriter);
+
+public:
+	/**
+	 * Constructor for the class TransformRowWriter.
+	 * @param fileName Name of the output file.
+	 */
+	TransformRowWriter(const std::string &fileName);
+
+	/**
+	 * Destructor for the class TransformRowWriter.
+	 */
+	virtual ~TransformRowWriter();
+
+	/**
+	 * Returns the name of the output file.
+	 * @return Name of the output file.
+	 */
+	inline const std::string &getFileName() const {
+		return (fileName);
+	}
+
+	/**
+	 * Opens the output file and writes everything before the first row.
+	 * @param transformInstance The instance.
+	 * @throws std::ios::failure if the file cannot be written.
+	 */
+	virtual void begin(const TransformInstance *transformInstance) = 0;
+
+	/**
+	 * Writes one row of the adjacency matrix.
+	 * @param transformInstance The instance.
+	 * @param i The row.
+	 * @param costs The costs of all columns of the row (the main diagonal
+	 *   of symmetric instances is not defined).
+	 * @throws std::ios::failure if the file cannot be written.
+	 */
+	virtual void writeRow(
+			const TransformInstance *transformInstance,
+			const std::vector<std::vector<double> >::size_type i,
+			const std::vector<double> &costs) = 0;
+
+	/**
+	 * Writes everything after the last row and closes the output file.
+	 * @param transformInstance The instance.
+	 * @throws std::ios::failure if the file cannot be written.
+	 */
+	virtual void end(const TransformInstance *transformInstance) = 0;
+};
+
+
+/**
+ * Writer of the xml structure. This writer provides no parser guarantee
+ * that the output file is a valid xml file.
+ */
+class TransformXMLRowWriter : public TransformRowWriter {
+private:
+	/**
+	 * True if every vertex is written as one element with the attribute "costs".
+	 */
+	bool compact;
+
+	/**
+	 * Buffer of the attribute "costs" of the compact encoding.
+	 */
+	std::string compactCosts;
+
+public:
+	/**
+	 * Constructor for the class TransformXMLRowWriter.
+	 * @param fileName Name of the output file.
+	 * @param compact True if every vertex should be written as one element
+	 *   with the attribute "costs" instead of one element per edge.
+	 */
+	TransformXMLRowWriter(const std::string &fileName, const bool compact = false);
+
+	virtual void begin(const TransformInstance *transformInstance);
+
+	virtual void writeRow(
+			const TransformInstance *transformInstance,
+			const std::vector<std::vector<double> >::size_type i,
+			const std::vector<double> &costs);
+
+	virtual void end(const TransformInstance *transformInstance);
+};
+
+
+/**
+ * Writer of the binary instance format. Symmetric instances are written
+ * as strictly lower triangular matrices, asymmetric instances as full
+ * matrices.
+ */
+class TransformBinaryRowWriter : public TransformRowWriter {
+private:
+	/**
+	 * Buffer of the encoded costs of one row.
+	 */
+	std::vector<char> buffer;
+
+public:
+	/**
+	 * Constructor for the class TransformBinaryRowWriter.
+	 * @param fileName Name of the output file.
+	 */
+	TransformBinaryRowWriter(const std::string &fileName);
+
+	virtual void begin(const TransformInstance *transformInstance);
+
+	virtual void writeRow(
+			const TransformInstance *transformInstance,
+			const std::vector<std::vector<double> >::size_type i,
+			const std::vector<double> &costs);
+
+	virtual void end(const TransformInstance *transformInstance);
+};
+
+
+/**
+ * Writer of the candidate format: the k cheapest edges leaving every
+ * vertex. Ties are broken by the smaller number of the neighbour.
+ */
+class TransformCandidateRowWriter : public TransformRowWriter {
+private:
+	/**
+	 * Number of the neighbours per vertex.
+	 */
+	std::vector<double>::size_type k;
+
+	/**
+	 * Buffer of the edges of one row: (cost, neighbour).
+	 */
+	std::vector<std::pair<double, std::vector<double>::size_type> > edges;
+
+	/**
+	 * Buffer of one line.
+	 */
+	std::string line;
+
+public:
+	/**
+	 * Constructor for the class TransformCandidateRowWriter.
+	 * @param fileName Name of the output file.
+	 * @param k Number of the neighbours per vertex (at most n - 1 are written).
+	 */
+	TransformCandidateRowWriter(const std::string &fileName, const std::vector<double>::size_type k);
+
+	virtual void begin(const TransformInstance *transformInstance);
+
+	virtual void writeRow(
+			const TransformInstance *transformInstance,
+			const std::vector<std::vector<double> >::size_type i,
+			const std::vector<double> &costs);
+
+	virtual void end(const TransformInstance *transformInstance);
+};
+
+
+/**
+ * Creates the writer of an output file according to its filename
+ * extension (".xml", ".tspb" or ".cand", all optionally followed by
+ * ".gz").
+ * @param fileName Name of the output file.
+ * @param compact True if xml files should use the compact encoding.
+ * @param k Number of the neighbours per vertex of candidate files.
+ * @return The writer (has to be deleted by the caller).
+ * @throws OutputFileFormatNotSupported if the filename extension is not supported.
+ */
+TransformRowWriter *createTransformRowWriter(
+		const std::string &fileName,
+		const bool compact,
+		const std::vector<double>::size_type k);
+
+/**
+ * Deletes all writers and clears the vector.
+ * @param writers The writers.
+ */
+void deleteTransformRowWriters(std::vector<TransformRowWriter *> &writers);
+
+/**
+ * Writes an instance to all output files in one pass: every row of the
+ * adjacency matrix is gathered once and passed to all writers. The
+ * output files of failed writers are closed when the writers are deleted.
+ * @param writers The writers of the output files.
+ * @param transformInstance The instance.
+ * @param statistics Statistics of the run (can be 0).
+ * @throws std::ios::failure if a file cannot be written.
+ */
+void writeOutputFilesInOnePass(
+		const std::vector<TransformRowWriter *> &writers,
+		const TransformInstance *transformInstance,
+		Statistics *statistics = 0);
+
+
+#endif
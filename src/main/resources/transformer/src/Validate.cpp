@@ -13,6 +13,7 @@
 #include <xercesc/util/XMLException.hpp>
 #include <xercesc/util/OutOfMemoryException.hpp>
 
+#include "ValidateCache.hpp"
 #include "ValidateConstantsFunctionsAndClasses.hpp"
 #include "ValidateIO.hpp"
 #include "ValidateInstance.hpp"
@@ -23,10 +24,38 @@ using namespace xercesc;
 XERCES_CPP_NAMESPACE_USE
 
 
+/**
+ * Prints the results of a successful validation on the standard output.
+ * @param inputFileName Name of the validated file.
+ * @param record Validation record of the file.
+ */
+void printValidationResults(const string &inputFileName, const ValidationRecord &record) {
+	if (record.isUndirected) {
+		cout <<
+				"The file \"" <<
+				inputFileName <<
+				"\" responds to a valid instance of the symmetric travelling salesman problem." <<
+				endl;
+	}
+	else {
+		cout <<
+				"The file \"" <<
+				inputFileName <<
+				"\" responds to a valid instance of the asymmetric travelling salesman problem." <<
+				endl;
+	}
+	cout << "\tName: " << record.name << endl;
+	cout << "\tSource: " << record.source << endl;
+	cout << "\tDescription: " << record.description << endl;
+	cout << "\tNumber of vertices: " << record.n << endl;
+}
+
+
 /**
  * The main function.
- * @param argc Number of elements in the array argv, in particular 1 or 2.
+ * @param argc Number of elements in the array argv.
  * @param argv Name of the running program or name of the running program,
+ *   options (--no-cache, --cache-dir=DIRECTORY, --stats, --stats=json),
  *   name of the input file.
  * @return
  *   <ul>
@@ -42,8 +71,9 @@ int main(int argc, char* argv[]) {
 	cout << "----------------------------------------------------------------" << endl;
 
 	string inputFileName;
+	ValidateOptions options;
 	try{
-		inputFileName = parseCommandLineArguments(argc, argv);
+		inputFileName = parseCommandLineArguments(argc, argv, options);
 	}
 	catch (CommandLineArgumentsInvalid &e) {
 		cerr << "The command-line arguments are invalid!" << endl;
@@ -53,6 +83,42 @@ int main(int argc, char* argv[]) {
 	//Writing the used filename on the standard output
 	cout << "Input file: " << inputFileName << endl;
 
+	Statistics *statistics = 0;
+	if (options.statisticsFormat != STATISTICS_NONE) {
+		statistics = new Statistics("Validate");
+	}
+
+
+	/*
+	 * Looking up the validation record of the input file.
+	 */
+	ValidationRecord record;
+	string recordFileName;
+	if (options.useCache) {
+		recordFileName = getValidationRecordFileName(inputFileName, options.cacheDirectory);
+		ScopedPhaseTimer cacheLookupTimer(statistics, PHASE_CACHE_LOOKUP);
+		const bool found =
+				lookUpValidationRecord(inputFileName, recordFileName, VALIDATION_SCHEMA, record);
+		cacheLookupTimer.stop();
+		if (found) {
+			cout << "Reading the validation record \"" << recordFileName << "\" ... OK" << endl;
+			cout << "----------------------------------------------------------------" << endl;
+
+			if (!record.valid) {
+				cerr << "The validation failed (the file has not been changed since)!" << endl;
+				delete statistics;
+				return (1);
+			}
+			printValidationResults(inputFileName, record);
+			if (statistics != 0) {
+				cout << endl;
+				statistics->print(cout, options.statisticsFormat);
+				delete statistics;
+			}
+			return (0);
+		}
+	}
+
 
 	/*
 	 * Reading of the input file.
@@ -61,28 +127,37 @@ int main(int argc, char* argv[]) {
 
 	Instance *instance = 0;
 	try {
-		instance = instanceIn(inputFileName);
+		instance = instanceIn(inputFileName, record.contentHash, statistics);
 	}
 	catch (bad_alloc &e) {
 		cerr << "the input graph is too large!" << endl;
+		delete statistics;
 	    return (1);
 	}
     catch (OutOfMemoryException &e) {
 		cerr << "the input graph is too large!" << endl;
+		delete statistics;
 	    return (1);
     }
 	catch (XMLException &e) {
 		cerr << "Xerces failed!" << endl;
+		delete statistics;
 		return (1);
 	}
 	catch (ValidationSchemaDoesNotExist &e) {
 		cerr << "the validation schema does not exist!" << endl;
+		delete statistics;
 		return (1);
 	}
     catch (ValidationFailed &e) {
 		cerr << "the validation failed!" <<
 				" Note that all costs have to be \"double\" type compatible." <<
 				" The number of vertices has to be \"unsigned int\" compatible." << endl;
+		if (options.useCache) {
+			record.valid = false;
+			writeValidationRecord(recordFileName, record);
+		}
+		delete statistics;
 		return (1);
     }
 /*	catch ( ... ) {
@@ -95,31 +170,50 @@ int main(int argc, char* argv[]) {
 
 
 	/*
-	 * Printing the results.
+	 * Saving the validation record.
 	 */
-	if (instance->getGraph()->getIsUndirected()) {
-		cout <<
-				"The file \"" <<
-				inputFileName <<
-				"\" responds to a valid instance of the symmetric travelling salesman problem." <<
-				endl;
-	}
-	else {
-		cout <<
-				"The file \"" <<
-				inputFileName <<
-				"\" responds to a valid instance of the asymmetric travelling salesman problem." <<
-				endl;
+	record.valid = true;
+	record.isUndirected = instance->getGraph()->getIsUndirected();
+	record.n = instance->getGraph()->getN();
+	record.doublePrecision = instance->getDoublePrecision();
+	record.ignoredDigits = instance->getIgnoredDigits();
+	record.name = instance->getName();
+	record.source = instance->getSource();
+	record.description = instance->getDescription();
+	if (options.useCache) {
+		//A record which cannot be written only means that the next run validates again.
+		writeValidationRecord(recordFileName, record);
 	}
-	cout << "\tName: " << instance->getName() << endl;
-	cout << "\tSource: " << instance->getSource() << endl;
-	cout << "\tDescription: " << instance->getDescription() << endl;
-	cout << "\tNumber of vertices: " << instance->getGraph()->getN() << endl;
+
+
+	/*
+	 * Printing the results.
+	 */
+	printValidationResults(inputFileName, record);
 
 
 //	cout << endl << endl << *instance << endl << endl;
 
 
+	/*
+	 * Printing the statistics.
+	 */
+	if (statistics != 0) {
+		const unsigned long long n = static_cast<unsigned long long>(record.n);
+		statistics->addBytesRead(getFileSize(inputFileName));
+		if (record.isUndirected) {
+			statistics->addEdges(n * (n - 1) / 2);
+		}
+		else {
+			statistics->addEdges(n * n);
+		}
+
+		cout << endl;
+		statistics->print(cout, options.statisticsFormat);
+		delete statistics;
+	}
+
+
 	/*
 	 * Releasing of the memory and returning 0.
 	 */
@@ -0,0 +1,526 @@
+/**
+ * @file ValidateCache.cpp
+ * Defines the validation cache. For every validated file a small
+ * validation record is saved. The record contains a content hash of
+ * the file, the verdict of the validation and the metadata of the
+ * instance, so that an unchanged file does not have to be validated
+ * again.
+ *
+ * @brief Defines the validation cache.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ValidateConstantsFunctionsAndClasses.hpp"
+
+#include "ValidateCache.hpp"
+
+using namespace std;
+
+
+/**
+ * Primes of the XXH64 hash.
+ */
+const unsigned long long PRIME64_1 = 0x9E3779B185EBCA87ULL;
+const unsigned long long PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+const unsigned long long PRIME64_3 = 0x165667B19E3779F9ULL;
+const unsigned long long PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+const unsigned long long PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+/**
+ * Size of the buffer used to read the hashed files.
+ */
+const std::streamsize HASH_BUFFER_SIZE = 1 << 16;
+
+/**
+ * Rotates a 64-bit value to the left.
+ * @param x The value.
+ * @param r Number of bits.
+ * @return Rotated value.
+ */
+inline unsigned long long rotateLeft(const unsigned long long x, const int r) {
+	return ((x << r) | (x >> (64 - r)));
+}
+
+/**
+ * Reads a little-endian 64-bit value.
+ * @param data Pointer to the value.
+ * @return The value.
+ */
+inline unsigned long long read64(const unsigned char *data) {
+	unsigned long long result = 0;
+	for (int i = 7; i >= 0; i--) {
+		result = (result << 8) | data[i];
+	}
+	return (result);
+}
+
+/**
+ * Reads a little-endian 32-bit value.
+ * @param data Pointer to the value.
+ * @return The value.
+ */
+inline unsigned long long read32(const unsigned char *data) {
+	unsigned long long result = 0;
+	for (int i = 3; i >= 0; i--) {
+		result = (result << 8) | data[i];
+	}
+	return (result);
+}
+
+/**
+ * One round of the XXH64 hash.
+ * @param accumulator Accumulator.
+ * @param input Processed input.
+ * @return New value of the accumulator.
+ */
+inline unsigned long long hashRound(unsigned long long accumulator, const unsigned long long input) {
+	accumulator += input * PRIME64_2;
+	accumulator = rotateLeft(accumulator, 31);
+	accumulator *= PRIME64_1;
+	return (accumulator);
+}
+
+/**
+ * Merges one accumulator into the hash.
+ * @param hash Hash.
+ * @param accumulator Accumulator.
+ * @return New value of the hash.
+ */
+inline unsigned long long mergeRound(unsigned long long hash, const unsigned long long accumulator) {
+	hash ^= hashRound(0, accumulator);
+	hash = hash * PRIME64_1 + PRIME64_4;
+	return (hash);
+}
+
+ContentHash::ContentHash(const unsigned long long seed) {
+	this->seed = seed;
+	accumulators[0] = seed + PRIME64_1 + PRIME64_2;
+	accumulators[1] = seed + PRIME64_2;
+	accumulators[2] = seed;
+	accumulators[3] = seed - PRIME64_1;
+	stripeSize = 0;
+	totalSize = 0;
+}
+
+void ContentHash::processStripe(const unsigned char *data) {
+	accumulators[0] = hashRound(accumulators[0], read64(data));
+	accumulators[1] = hashRound(accumulators[1], read64(data + 8));
+	accumulators[2] = hashRound(accumulators[2], read64(data + 16));
+	accumulators[3] = hashRound(accumulators[3], read64(data + 24));
+}
+
+void ContentHash::update(const void *data, const std::size_t size) {
+	const unsigned char *bytes = static_cast<const unsigned char *>(data);
+	std::size_t remaining = size;
+	totalSize += size;
+
+	//Completing of the saved stripe.
+	if (stripeSize > 0) {
+		std::size_t toCopy = sizeof(stripe) - stripeSize;
+		if (toCopy > remaining) {
+			toCopy = remaining;
+		}
+		memcpy(stripe + stripeSize, bytes, toCopy);
+		stripeSize += toCopy;
+		bytes += toCopy;
+		remaining -= toCopy;
+		if (stripeSize < sizeof(stripe)) {
+			return;
+		}
+		processStripe(stripe);
+		stripeSize = 0;
+	}
+
+	//Whole stripes.
+	while (remaining >= sizeof(stripe)) {
+		processStripe(bytes);
+		bytes += sizeof(stripe);
+		remaining -= sizeof(stripe);
+	}
+
+	//The rest is saved for the next call.
+	memcpy(stripe, bytes, remaining);
+	stripeSize = remaining;
+}
+
+unsigned long long ContentHash::digest() const {
+	unsigned long long hash;
+	if (totalSize >= sizeof(stripe)) {
+		hash =
+				rotateLeft(accumulators[0], 1) +
+				rotateLeft(accumulators[1], 7) +
+				rotateLeft(accumulators[2], 12) +
+				rotateLeft(accumulators[3], 18);
+		hash = mergeRound(hash, accumulators[0]);
+		hash = mergeRound(hash, accumulators[1]);
+		hash = mergeRound(hash, accumulators[2]);
+		hash = mergeRound(hash, accumulators[3]);
+	}
+	else {
+		hash = seed + PRIME64_5;
+	}
+	hash += totalSize;
+
+	std::size_t i = 0;
+	for (; i + 8 <= stripeSize; i += 8) {
+		hash ^= hashRound(0, read64(stripe + i));
+		hash = rotateLeft(hash, 27) * PRIME64_1 + PRIME64_4;
+	}
+	if (i + 4 <= stripeSize) {
+		hash ^= read32(stripe + i) * PRIME64_1;
+		hash = rotateLeft(hash, 23) * PRIME64_2 + PRIME64_3;
+		i += 4;
+	}
+	for (; i < stripeSize; i++) {
+		hash ^= stripe[i] * PRIME64_5;
+		hash = rotateLeft(hash, 11) * PRIME64_1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= PRIME64_2;
+	hash ^= hash >> 29;
+	hash *= PRIME64_3;
+	hash ^= hash >> 32;
+
+	return (hash);
+}
+
+ValidationRecord::ValidationRecord() {
+	contentHash = 0;
+	schemaHash = 0;
+	fileSize = 0;
+	modificationTime = 0;
+	modificationTimeNanoseconds = 0;
+	valid = false;
+	isUndirected = false;
+	n = 0;
+	doublePrecision = 0;
+	ignoredDigits = 0;
+	name = "";
+	source = "";
+	description = "";
+}
+
+bool readFileStatus(const std::string &fileName, ValidationRecord &record) {
+	struct stat fileStatus;
+	if (stat(fileName.c_str(), &fileStatus) != 0) {
+		return (false);
+	}
+	record.fileSize = static_cast<unsigned long long>(fileStatus.st_size);
+	record.modificationTime = static_cast<long long>(fileStatus.st_mtim.tv_sec);
+	record.modificationTimeNanoseconds = static_cast<long long>(fileStatus.st_mtim.tv_nsec);
+	return (true);
+}
+
+HashingFileStreambuf::HashingFileStreambuf() :
+		buffer(static_cast<vector<char>::size_type>(HASH_BUFFER_SIZE)) {
+	file = 0;
+	setg(&buffer[0], &buffer[0], &buffer[0]);
+}
+
+HashingFileStreambuf::~HashingFileStreambuf() {
+	close();
+}
+
+bool HashingFileStreambuf::open(const std::string &fileName) {
+	if (file != 0) {
+		return (false);
+	}
+	file = fopen(fileName.c_str(), "rb");
+	if (file == 0) {
+		return (false);
+	}
+	contentHash = ContentHash();
+	setg(&buffer[0], &buffer[0], &buffer[0]);
+	return (true);
+}
+
+HashingFileStreambuf::int_type HashingFileStreambuf::underflow() {
+	if (gptr() < egptr()) {
+		return (traits_type::to_int_type(*gptr()));
+	}
+	if (file == 0) {
+		return (traits_type::eof());
+	}
+
+	const size_t size = fread(&buffer[0], 1, buffer.size(), file);
+	if ((size == 0) && (ferror(file))) {
+		throw ios::failure("The file cannot be read!");
+	}
+	contentHash.update(&buffer[0], size);
+	setg(&buffer[0], &buffer[0], &buffer[0] + size);
+	if (size == 0) {
+		return (traits_type::eof());
+	}
+	return (traits_type::to_int_type(*gptr()));
+}
+
+unsigned long long HashingFileStreambuf::digestWholeFile() {
+	//The bytes in the buffer are hashed already, only the unread blocks are missing.
+	setg(&buffer[0], &buffer[0], &buffer[0]);
+	while (underflow() != traits_type::eof()) {
+		setg(&buffer[0], &buffer[0], &buffer[0]);
+	}
+	return (contentHash.digest());
+}
+
+void HashingFileStreambuf::close() {
+	if (file == 0) {
+		return;
+	}
+	fclose(file);
+	file = 0;
+	setg(&buffer[0], &buffer[0], &buffer[0]);
+}
+
+unsigned long long hashFileContent(const std::string &fileName) {
+	HashingFileStreambuf inputFile;
+	if (!inputFile.open(fileName)) {
+		throw ifstream::failure("The file cannot be opened!");
+	}
+	return (inputFile.digestWholeFile());
+}
+
+std::string getValidationRecordFileName(
+		const std::string &inputFileName,
+		const std::string &cacheDirectory) {
+	if (cacheDirectory == "") {
+		return (inputFileName + VALIDATION_RECORD_FILENAME_EXTENSION);
+	}
+
+	//Files with the same name in different directories must not share
+	//one record, so the hash of the full path is a part of the name.
+	string baseName = inputFileName;
+	string::size_type slash = baseName.find_last_of('/');
+	if (slash != string::npos) {
+		baseName.erase(0, slash + 1);
+	}
+	string path = inputFileName;
+	char *realPath = realpath(inputFileName.c_str(), 0);
+	if (realPath != 0) {
+		path = realPath;
+		free(realPath);
+	}
+	ContentHash pathHash;
+	pathHash.update(path.data(), path.size());
+
+	ostringstream recordFileName;
+	recordFileName << cacheDirectory;
+	if (cacheDirectory.at(cacheDirectory.size() - 1) != '/') {
+		recordFileName << '/';
+	}
+	recordFileName <<
+			baseName << '.' <<
+			hex << setw(16) << setfill('0') << pathHash.digest() <<
+			VALIDATION_RECORD_FILENAME_EXTENSION;
+	return (recordFileName.str());
+}
+
+/**
+ * Reads the value of one "key: value" line of a validation record.
+ * @param inputFile The record.
+ * @param key Expected key.
+ * @param value Read value.
+ * @return
+ *   <ul>
+ *     <li>true if succeeded,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool readValidationRecordLine(istream &inputFile, const string &key, string &value) {
+	string inputLine;
+	if (!getline(inputFile, inputLine)) {
+		return (false);
+	}
+	if (inputLine.compare(0, key.size() + 1, key + ":") != 0) {
+		return (false);
+	}
+	value = inputLine.substr(key.size() + 1);
+	trim(value);
+	return (true);
+}
+
+/**
+ * Reads the value of one "key: value" line of a validation record
+ * and converts it.
+ * @param inputFile The record.
+ * @param key Expected key.
+ * @param value Read value.
+ * @param hexadecimal True if the value is written hexadecimal.
+ * @return
+ *   <ul>
+ *     <li>true if succeeded,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+template <class T>
+bool readValidationRecordLine(istream &inputFile, const string &key, T &value, bool hexadecimal = false) {
+	string valueString;
+	if (!readValidationRecordLine(inputFile, key, valueString)) {
+		return (false);
+	}
+	istringstream valueIStringstream(valueString);
+	if (hexadecimal) {
+		valueIStringstream >> hex;
+	}
+	valueIStringstream >> value;
+	return ((!valueIStringstream.fail()) && (valueIStringstream.eof()));
+}
+
+bool readValidationRecord(const std::string &recordFileName, ValidationRecord &record) {
+	ifstream recordFile(recordFileName.c_str());
+	if (!recordFile.is_open()) {
+		return (false);
+	}
+
+	string header;
+	if ((!getline(recordFile, header)) || (header != VALIDATION_RECORD_HEADER)) {
+		return (false);
+	}
+
+	int valid;
+	if (
+			(!readValidationRecordLine(recordFile, "contentHash", record.contentHash, true)) ||
+			(!readValidationRecordLine(recordFile, "schemaHash", record.schemaHash, true)) ||
+			(!readValidationRecordLine(recordFile, "fileSize", record.fileSize)) ||
+			(!readValidationRecordLine(recordFile, "modificationTime", record.modificationTime)) ||
+			(!readValidationRecordLine(
+					recordFile,
+					"modificationTimeNanoseconds",
+					record.modificationTimeNanoseconds)) ||
+			(!readValidationRecordLine(recordFile, "valid", valid))) {
+		return (false);
+	}
+	record.valid = (valid != 0);
+	if (!record.valid) {
+		return (true);
+	}
+
+	int isUndirected;
+	if (
+			(!readValidationRecordLine(recordFile, "isUndirected", isUndirected)) ||
+			(!readValidationRecordLine(recordFile, "n", record.n)) ||
+			(!readValidationRecordLine(recordFile, "doublePrecision", record.doublePrecision)) ||
+			(!readValidationRecordLine(recordFile, "ignoredDigits", record.ignoredDigits)) ||
+			(!readValidationRecordLine(recordFile, "name", record.name)) ||
+			(!readValidationRecordLine(recordFile, "source", record.source)) ||
+			(!readValidationRecordLine(recordFile, "description", record.description))) {
+		return (false);
+	}
+	record.isUndirected = (isUndirected != 0);
+
+	return (true);
+}
+
+bool lookUpValidationRecord(
+		const std::string &inputFileName,
+		const std::string &recordFileName,
+		const std::string &schemaFileName,
+		ValidationRecord &record) {
+	ValidationRecord current;
+	if (!readFileStatus(inputFileName, current)) {
+		record = current;
+		return (false);
+	}
+
+	try {
+		current.schemaHash = hashFileContent(schemaFileName);
+	}
+	catch (ifstream::failure &e) {
+		record = current;
+		return (false);
+	}
+
+	ValidationRecord saved;
+	const bool found =
+			readValidationRecord(recordFileName, saved) &&
+			(saved.schemaHash == current.schemaHash) &&
+			(saved.fileSize == current.fileSize);
+
+	//O(stat): the file has not been touched since the last validation.
+	if (
+			found &&
+			(saved.modificationTime == current.modificationTime) &&
+			(saved.modificationTimeNanoseconds == current.modificationTimeNanoseconds)) {
+		record = saved;
+		return (true);
+	}
+
+	//The parser hashes the file while it validates it, so the file is
+	//only read here if a record of a file of the same size exists.
+	if (!found) {
+		record = current;
+		return (false);
+	}
+
+	//O(file read): the file has been touched, the content decides.
+	try {
+		current.contentHash = hashFileContent(inputFileName);
+	}
+	catch (ifstream::failure &e) {
+		record = current;
+		return (false);
+	}
+	if (saved.contentHash == current.contentHash) {
+		saved.modificationTime = current.modificationTime;
+		saved.modificationTimeNanoseconds = current.modificationTimeNanoseconds;
+		writeValidationRecord(recordFileName, saved);
+		record = saved;
+		return (true);
+	}
+
+	record = current;
+	return (false);
+}
+
+bool writeValidationRecord(const std::string &recordFileName, const ValidationRecord &record) {
+	ostringstream temporaryFileName;
+	temporaryFileName << recordFileName << ".tmp." << getpid();
+
+	{
+		ofstream recordFile(temporaryFileName.str().c_str());
+		if (!recordFile.is_open()) {
+			return (false);
+		}
+
+		recordFile << VALIDATION_RECORD_HEADER << endl;
+		recordFile << "contentHash: " << hex << record.contentHash << dec << endl;
+		recordFile << "schemaHash: " << hex << record.schemaHash << dec << endl;
+		recordFile << "fileSize: " << record.fileSize << endl;
+		recordFile << "modificationTime: " << record.modificationTime << endl;
+		recordFile << "modificationTimeNanoseconds: " << record.modificationTimeNanoseconds << endl;
+		recordFile << "valid: " << (record.valid ? 1 : 0) << endl;
+		if (record.valid) {
+			recordFile << "isUndirected: " << (record.isUndirected ? 1 : 0) << endl;
+			recordFile << "n: " << record.n << endl;
+			recordFile << "doublePrecision: " << record.doublePrecision << endl;
+			recordFile << "ignoredDigits: " << record.ignoredDigits << endl;
+			recordFile << "name: " << record.name << endl;
+			recordFile << "source: " << record.source << endl;
+			recordFile << "description: " << record.description << endl;
+		}
+
+		recordFile.close();
+		if (recordFile.fail()) {
+			remove(temporaryFileName.str().c_str());
+			return (false);
+		}
+	}
+
+	if (rename(temporaryFileName.str().c_str(), recordFileName.c_str()) != 0) {
+		remove(temporaryFileName.str().c_str());
+		return (false);
+	}
+
+	return (true);
+}
@@ -0,0 +1,345 @@
+/**
+ * @file ValidateCache.hpp
+ * Defines the validation cache. For every validated file a small
+ * validation record is saved. The record contains a content hash of
+ * the file, the verdict of the validation and the metadata of the
+ * instance, so that an unchanged file does not have to be validated
+ * again.
+ *
+ * @brief Defines the validation cache.
+ */
+
+#ifndef _ValidateCache_HPP_
+#define _ValidateCache_HPP_
+
+#include <cstdio>
+#include <ios>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+
+/**
+ * Filename extension of the validation records.
+ */
+const std::string VALIDATION_RECORD_FILENAME_EXTENSION = ".validated";
+
+/**
+ * First line of every validation record (identifies the format and its version).
+ */
+const std::string VALIDATION_RECORD_HEADER = "TSP_VALIDATION_RECORD 1";
+
+/**
+ * Seed of the content hash.
+ */
+const unsigned long long CONTENT_HASH_SEED = 0;
+
+
+/**
+ * Computes the 64-bit content hash (XXH64) of a byte stream. The data
+ * can be passed in arbitrary pieces by the method update.
+ */
+class ContentHash {
+private:
+	/**
+	 * The four accumulators of the hash.
+	 */
+	unsigned long long accumulators[4];
+
+	/**
+	 * Bytes which do not form a complete stripe of 32 bytes yet.
+	 */
+	unsigned char stripe[32];
+
+	/**
+	 * Number of the bytes saved in stripe.
+	 */
+	std::size_t stripeSize;
+
+	/**
+	 * Total number of the hashed bytes.
+	 */
+	unsigned long long totalSize;
+
+	/**
+	 * Seed of the hash.
+	 */
+	unsigned long long seed;
+
+	/**
+	 * Processes one complete stripe of 32 bytes.
+	 * @param data Pointer to the stripe.
+	 */
+	void processStripe(const unsigned char *data);
+
+public:
+	/**
+	 * Constructor for the class ContentHash.
+	 * @param seed Seed of the hash.
+	 */
+	ContentHash(const unsigned long long seed = CONTENT_HASH_SEED);
+
+	/**
+	 * Adds data to the hash.
+	 * @param data Pointer to the data.
+	 * @param size Number of bytes.
+	 */
+	void update(const void *data, const std::size_t size);
+
+	/**
+	 * Returns the hash of all data added so far.
+	 * @return Hash of all data added so far.
+	 */
+	unsigned long long digest() const;
+};
+
+
+/**
+ * Stream buffer which reads a file unchanged and adds every read byte
+ * to a content hash. The parser reads the file through it, so the
+ * content hash of a validated file is computed from the same buffers
+ * and the file is read only once.
+ */
+class HashingFileStreambuf : public std::streambuf {
+private:
+	/**
+	 * The file (0 if it is not open).
+	 */
+	std::FILE *file;
+
+	/**
+	 * Buffer of the read data.
+	 */
+	std::vector<char> buffer;
+
+	/**
+	 * Hash of all bytes read so far.
+	 */
+	ContentHash contentHash;
+
+	/**
+	 * Not implemented copy constructor for the class HashingFileStreambuf.
+	 * @param hashingFileStreambuf Instance to be copied.
+	 */
+	HashingFileStreambuf(const HashingFileStreambuf &hashingFileStreambuf);
+
+	/**
+	 * Not implemented operator "=".
+	 * @param hashingFileStreambuf Right side of the operator.
+	 * @return Left side of the operator.
+	 */
+	HashingFileStreambuf &operator=(const HashingFileStreambuf &hashingFileStreambuf);
+
+protected:
+	/**
+	 * Reads the next block of the file and adds it to the hash.
+	 * @return The next character or EOF at the end of the file.
+	 * @throws std::ios::failure if the file cannot be read.
+	 */
+	virtual int_type underflow();
+
+public:
+	/**
+	 * Constructor for the class HashingFileStreambuf.
+	 */
+	HashingFileStreambuf();
+
+	/**
+	 * Destructor for the class HashingFileStreambuf. Closes the file.
+	 */
+	virtual ~HashingFileStreambuf();
+
+	/**
+	 * Opens a file.
+	 * @param fileName Name of the file.
+	 * @return
+	 *   <ul>
+	 *     <li>true if succeeded,</li>
+	 *     <li>false otherwise.</li>
+	 *   </ul>
+	 */
+	bool open(const std::string &fileName);
+
+	/**
+	 * Reads the rest of the file (e.g. if the parser stopped at an
+	 * error) and returns the content hash of the whole file.
+	 * @return Content hash of the file.
+	 * @throws std::ios::failure if the file cannot be read.
+	 */
+	unsigned long long digestWholeFile();
+
+	/**
+	 * Closes the file.
+	 */
+	void close();
+};
+
+
+/**
+ * Saves the verdict of one validation together with the identity of
+ * the validated file and the metadata of the instance.
+ */
+struct ValidationRecord {
+	/**
+	 * Content hash of the validated file.
+	 */
+	unsigned long long contentHash;
+
+	/**
+	 * Content hash of the validation schema used for the validation.
+	 */
+	unsigned long long schemaHash;
+
+	/**
+	 * Size of the validated file in bytes.
+	 */
+	unsigned long long fileSize;
+
+	/**
+	 * Modification time of the validated file (seconds).
+	 */
+	long long modificationTime;
+
+	/**
+	 * Modification time of the validated file (nanoseconds part).
+	 */
+	long long modificationTimeNanoseconds;
+
+	/**
+	 * Verdict of the validation.
+	 * <ul>
+	 *   <li>true The file is valid.</li>
+	 *   <li>false The validation failed.</li>
+	 * </ul>
+	 */
+	bool valid;
+
+	/**
+	 * Indicator indicating if the graph is undirected (only if the file is valid).
+	 */
+	bool isUndirected;
+
+	/**
+	 * Number of vertices (only if the file is valid).
+	 */
+	std::vector<std::vector<double> >::size_type n;
+
+	/**
+	 * Precision of doubles (only if the file is valid).
+	 */
+	std::streamsize doublePrecision;
+
+	/**
+	 * Number of ignored digits of double types (only if the file is valid).
+	 */
+	std::streamsize ignoredDigits;
+
+	/**
+	 * Name of the instance (only if the file is valid).
+	 */
+	std::string name;
+
+	/**
+	 * Source of the instance (only if the file is valid).
+	 */
+	std::string source;
+
+	/**
+	 * Description of the instance (only if the file is valid).
+	 */
+	std::string description;
+
+	/**
+	 * Constructor for the struct ValidationRecord.
+	 */
+	ValidationRecord();
+};
+
+
+/**
+ * Returns the size and the modification time of a file.
+ * @param fileName Name of the file.
+ * @param record The fields fileSize, modificationTime and
+ *   modificationTimeNanoseconds of the record are set.
+ * @return
+ *   <ul>
+ *     <li>true if succeeded,</li>
+ *     <li>false if the file does not exist.</li>
+ *   </ul>
+ */
+bool readFileStatus(const std::string &fileName, ValidationRecord &record);
+
+/**
+ * Computes the content hash of a whole file.
+ * @param fileName Name of the file.
+ * @return Content hash of the file.
+ * @throws std::ifstream::failure if the file cannot be read.
+ */
+unsigned long long hashFileContent(const std::string &fileName);
+
+/**
+ * Returns the name of the validation record of a file.
+ * @param inputFileName Name of the validated file.
+ * @param cacheDirectory Directory of the validation records. If it is
+ *   empty, the record is saved next to the validated file.
+ * @return Name of the validation record.
+ */
+std::string getValidationRecordFileName(
+		const std::string &inputFileName,
+		const std::string &cacheDirectory);
+
+/**
+ * Reads a validation record.
+ * @param recordFileName Name of the validation record.
+ * @param record Read record.
+ * @return
+ *   <ul>
+ *     <li>true if succeeded,</li>
+ *     <li>false if the record does not exist or is damaged.</li>
+ *   </ul>
+ */
+bool readValidationRecord(const std::string &recordFileName, ValidationRecord &record);
+
+/**
+ * Looks up the validation record of a file. If the size and the
+ * modification time of the file equal the recorded ones, the record
+ * is trusted without reading the file. If only the modification time
+ * differs, the content hash of the file decides (and the record is
+ * refreshed if the content is unchanged). A record is never trusted
+ * if the validation schema has changed.
+ * @param inputFileName Name of the validated file.
+ * @param recordFileName Name of the validation record.
+ * @param schemaFileName Name of the validation schema.
+ * @param record If the lookup succeeds, the found record. Otherwise
+ *   the fields identifying the file (schema hash, size and modification
+ *   time) are set, so the record can be completed and written after the
+ *   validation. The content hash is computed by the parser (see
+ *   instanceIn), the file is only hashed here if the content decides.
+ * @return
+ *   <ul>
+ *     <li>true if a record of the unchanged file was found,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool lookUpValidationRecord(
+		const std::string &inputFileName,
+		const std::string &recordFileName,
+		const std::string &schemaFileName,
+		ValidationRecord &record);
+
+/**
+ * Writes a validation record. The record is written to a temporary
+ * file first and then renamed, so a concurrently running validation
+ * never reads a half-written record.
+ * @param recordFileName Name of the validation record.
+ * @param record Record to be written.
+ * @return
+ *   <ul>
+ *     <li>true if succeeded,</li>
+ *     <li>false otherwise.</li>
+ *   </ul>
+ */
+bool writeValidationRecord(const std::string &recordFileName, const ValidationRecord &record);
+
+
+#endif
@@ -13,6 +13,7 @@
 #ifndef _ValidateConstantsFunctionsAndClasses_HPP_
 #define _ValidateConstantsFunctionsAndClasses_HPP_
 
+#include <cstddef>
 #include <limits>
 #include <fstream>
 #include <sstream>
@@ -30,6 +31,16 @@ const std::string INPUT_FILE_FILENAME_EXTENSION = ".xml";
  */
 const std::string VALIDATION_SCHEMA = "TSPConfiguration.xsd";
 
+/**
+ * Command-line option: The validation cache is not used.
+ */
+const std::string COMMAND_LINE_OPTION_NO_CACHE = "--no-cache";
+
+/**
+ * Command-line option: Directory of the validation records.
+ */
+const std::string COMMAND_LINE_OPTION_CACHE_DIRECTORY = "--cache-dir=";
+
 /**
  * Encoding of the xml file
  */
@@ -40,6 +51,13 @@ const std::string XML_ENCODING = "UTF-8";
  */
 const std::ios::fmtflags DOUBLE_FLOATFIELD = std::ios::scientific;
 
+/**
+ * Edge length of the square blocks in which the adjacency matrix is
+ * compared with its transposition during the symmetry detection.
+ * 64 rows of one block fit into the L1/L2 cache together.
+ */
+const std::size_t SYMMETRY_DETECTION_BLOCK_SIZE = 64;
+
 /**
  * Xml tag: Name of the document node.
  */
@@ -91,6 +109,18 @@ const std::string XML_EDGE = "edge";
  */
 const std::string XML_EDGE_ATTRIBUTE_COST = "cost";
 
+/**
+ * Xml tag - attribute: Costs of all edges of the vertex in the order of
+ * the columns (compact encoding).
+ */
+const std::string XML_VERTEX_ATTRIBUTE_COSTS = "costs";
+
+/**
+ * Entry of the attribute "costs" for an edge which does not exist (the
+ * main diagonal of symmetric instances).
+ */
+const std::string XML_VALUE_ABSENT_COST = "-";
+
 
 /**
  * Trims the string from left.
@@ -21,6 +21,8 @@
 #include "ValidateConstantsFunctionsAndClasses.hpp"
 #include "ValidateSAX2ErrorHandler.hpp"
 #include "ValidateSAX2ContentHandler.hpp"
+#include "ValidateInputSource.hpp"
+#include "FileStreams.hpp"
 
 #include "ValidateIO.hpp"
 
@@ -30,14 +32,12 @@ using namespace xercesc;
 XERCES_CPP_NAMESPACE_USE
 
 
-std::string parseCommandLineArguments(int argc, char* argv[]) {
+std::string parseCommandLineArguments(int argc, char* argv[], ValidateOptions &options) {
 	/*
 	 * Initialling.
 	 */
 	string inputFileName = "";
-	switch (argc) {
-	case 1:
-	{
+	if (argc == 1) {
 		try {
 			cout <<
 					"The name of input file (the filename extension has to be \"" <<
@@ -49,26 +49,46 @@ std::string parseCommandLineArguments(int argc, char* argv[]) {
 		    throw CommandLineArgumentsInvalid();
 	    }
 	}
-	break;
-	case 2:
-	{
-		inputFileName = argv[1];
-	}
-	break;
-	default:
-	{
-	    throw CommandLineArgumentsInvalid();
-	}
+	else {
+		for (int i = 1; i < argc; i++) {
+			const string argument = argv[i];
+			if (inputFileName != "") {
+				throw CommandLineArgumentsInvalid();
+			}
+
+			if (argument == COMMAND_LINE_OPTION_NO_CACHE) {
+				options.useCache = false;
+			}
+			else if (
+					argument.compare(
+							0,
+							COMMAND_LINE_OPTION_CACHE_DIRECTORY.size(),
+							COMMAND_LINE_OPTION_CACHE_DIRECTORY) == 0) {
+				options.cacheDirectory = argument.substr(COMMAND_LINE_OPTION_CACHE_DIRECTORY.size());
+				if (options.cacheDirectory == "") {
+					throw CommandLineArgumentsInvalid();
+				}
+			}
+			else if (argument.compare(0, 2, "--") == 0) {
+				if (!parseStatisticsOption(argument, options.statisticsFormat)) {
+					throw CommandLineArgumentsInvalid();
+				}
+			}
+			else {
+				inputFileName = argument;
+			}
+		}
 	}
 
-	//Checking of validity of the inputFileName
-	if (inputFileName.size() < INPUT_FILE_FILENAME_EXTENSION.size() + 1) {
+	//Checking of validity of the inputFileName (it can be compressed)
+	const string uncompressedInputFileName = removeGzipFilenameExtension(inputFileName);
+	if (uncompressedInputFileName.size() < INPUT_FILE_FILENAME_EXTENSION.size() + 1) {
 	    throw CommandLineArgumentsInvalid();
 	}
 
 	string inputFileFilenameExtension =
-			inputFileName.substr(
-					inputFileName.size() - INPUT_FILE_FILENAME_EXTENSION.size(),
+			uncompressedInputFileName.substr(
+					uncompressedInputFileName.size() - INPUT_FILE_FILENAME_EXTENSION.size(),
 					INPUT_FILE_FILENAME_EXTENSION.size());
 	transform(
 			inputFileFilenameExtension.begin(),
@@ -118,7 +138,7 @@ public:
 };
 #define unicodeForm(str) XMLStringTranscode(str).unicodeForm()
 
-Instance *instanceIn(const std::string &inputFileName) {
+Instance *instanceIn(const std::string &inputFileName, unsigned long long &contentHash, Statistics *statistics) {
 	Instance *instance = 0;
 
 	try {
@@ -159,11 +179,23 @@ Instance *instanceIn(const std::string &inputFileName) {
 
 		//DocumentHandler.
 		SAX2ContentHandler contentHandler;
+		contentHandler.setStatistics(statistics);
 	    parser->setContentHandler(&contentHandler);
 
-	    parser->parse(inputFileName.c_str());
+	    ScopedPhaseTimer parsingTimer(statistics, PHASE_PARSING);
+	    //The file is hashed (and decompressed) while it is parsed.
+	    ValidateInputSource inputSource(inputFileName);
+	    parser->parse(inputSource);
+	    bool damaged = inputSource.getDamaged();
+	    try {
+	    	contentHash = inputSource.getContentHash();
+	    }
+	    catch (ios::failure &e) {
+	    	damaged = true;
+	    }
+	    parsingTimer.stop();
 
-	    if (errorHandler.getFailed()) {
+	    if ((errorHandler.getFailed()) || (damaged)) {
 	    	throw ValidationFailed();
 	    }
 
@@ -171,6 +203,7 @@ Instance *instanceIn(const std::string &inputFileName) {
 	    	throw ValidationFailed();
 	    }
 
+	    ScopedPhaseTimer graphConstructionTimer(statistics, PHASE_GRAPH_CONSTRUCTION);
 	    instance = new Instance(
 	    		contentHandler.getName(),
 	    		contentHandler.getSource(),
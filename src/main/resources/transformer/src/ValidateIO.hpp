@@ -14,24 +14,67 @@
 #include <string>
 #include <stdexcept>
 
+#include "Statistics.hpp"
 #include "ValidateInstance.hpp"
 #include "ValidateGraph.hpp"
 
 
 /**
- * Parses the command-line arguments.
+ * Options of the validation given on the command line.
+ */
+struct ValidateOptions {
+	/**
+	 * True if the validation cache should be used.
+	 */
+	bool useCache;
+
+	/**
+	 * Directory of the validation records. If it is empty, the
+	 * record is saved next to the input file.
+	 */
+	std::string cacheDirectory;
+
+	/**
+	 * Format of the printed statistics.
+	 */
+	StatisticsFormat statisticsFormat;
+
+	/**
+	 * Constructor for the struct ValidateOptions.
+	 */
+	inline ValidateOptions() {
+		useCache = true;
+		cacheDirectory = "";
+		statisticsFormat = STATISTICS_NONE;
+	}
+};
+
+/**
+ * Parses the command-line arguments. The options have to precede
+ * the name of the input file. The recognized options are:
+ * <ul>
+ *   <li>"--no-cache" The validation cache is neither read nor written.</li>
+ *   <li>"--cache-dir=DIRECTORY" The validation records are saved in the
+ *     given directory instead of next to the input file.</li>
+ *   <li>"--stats" or "--stats=json" The statistics of the run are printed
+ *     as a table or as one line of JSON.</li>
+ * </ul>
  * @param argc Number of arguments.
  * @param argv Arguments.
+ * @param options Parsed options.
  * @return Name of the input file.
  */
-std::string parseCommandLineArguments(int argc, char* argv[]);
+std::string parseCommandLineArguments(int argc, char* argv[], ValidateOptions &options);
 
 /**
  * Reads one travelling salesman problem instance from the file inputFileName.
  * @param inputFileName Name of the input file.
+ * @param contentHash Content hash of the file, computed while it is
+ *   parsed (set before ValidationFailed is thrown).
+ * @param statistics Statistics of the run (can be 0).
  * @return Instance of the travelling salesman problem.
  */
-Instance *instanceIn(const std::string &inputFileName);
+Instance *instanceIn(const std::string &inputFileName, unsigned long long &contentHash, Statistics *statistics = 0);
 
 
 #endif
@@ -0,0 +1,69 @@
+/**
+ * @file ValidateInputSource.cpp
+ * Defines the input source of the SAX2 parser.
+ *
+ * @brief Defines the input source of the SAX2 parser.
+ */
+
+#include <ios>
+
+#include "ValidateInputSource.hpp"
+
+using namespace std;
+
+
+ValidateBinInputStream::ValidateBinInputStream(
+		HashingFileStreambuf *fileBuffer,
+		const bool decompress,
+		bool *damaged) : BinInputStream(), fileBuffer(fileBuffer), damaged(damaged) {
+	position = 0;
+	buffer = fileBuffer;
+	if (decompress) {
+		gzipBuffer.open(fileBuffer);
+		buffer = &gzipBuffer;
+	}
+}
+
+ValidateBinInputStream::~ValidateBinInputStream() {
+	gzipBuffer.close();
+}
+
+XMLFilePos ValidateBinInputStream::curPos() const {
+	return (position);
+}
+
+XMLSize_t ValidateBinInputStream::readBytes(XMLByte* const toFill, const XMLSize_t maxToRead) {
+	try {
+		const streamsize size =
+				buffer->sgetn(reinterpret_cast<char *>(toFill), static_cast<streamsize>(maxToRead));
+		position += static_cast<XMLFilePos>(size);
+		return (static_cast<XMLSize_t>(size));
+	}
+	catch (ios::failure &e) {
+		*damaged = true;
+		return (0);
+	}
+}
+
+const XMLCh* ValidateBinInputStream::getContentType() const {
+	return (0);
+}
+
+
+ValidateInputSource::ValidateInputSource(const std::string &fileName) :
+		InputSource(fileName.c_str()), fileName(fileName), damaged(false) {
+}
+
+ValidateInputSource::~ValidateInputSource() {
+}
+
+BinInputStream* ValidateInputSource::makeStream() const {
+	if (!fileBuffer.open(fileName)) {
+		return (0);
+	}
+	return (new ValidateBinInputStream(&fileBuffer, isGzipFileName(fileName), &damaged));
+}
+
+unsigned long long ValidateInputSource::getContentHash() {
+	return (fileBuffer.digestWholeFile());
+}
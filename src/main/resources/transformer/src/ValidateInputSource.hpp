@@ -0,0 +1,185 @@
+/**
+ * @file ValidateInputSource.hpp
+ * Defines the input source of the SAX2 parser. The file is read in
+ * blocks while it is parsed, files compressed with gzip (the filename
+ * extension ".gz") are decompressed on the fly. The read blocks are
+ * added to the content hash of the validation cache, so the file is
+ * read only once.
+ *
+ * @brief Defines the input source of the SAX2 parser.
+ */
+
+#ifndef _ValidateInputSource_HPP_
+#define _ValidateInputSource_HPP_
+
+#include <string>
+
+#include <xercesc/sax/InputSource.hpp>
+#include <xercesc/util/BinInputStream.hpp>
+
+#include "FileStreams.hpp"
+#include "ValidateCache.hpp"
+
+using namespace xercesc;
+
+XERCES_CPP_NAMESPACE_USE
+
+
+/**
+ * Implements a BinInputStream reading a file through its hashing
+ * stream buffer (and decompressing it if it is a gzip file).
+ */
+class ValidateBinInputStream : public BinInputStream {
+private:
+	/**
+	 * Buffer reading and hashing the file (owned by the input source).
+	 */
+	HashingFileStreambuf *fileBuffer;
+
+	/**
+	 * Buffer decompressing the file.
+	 */
+	GzipInputStreambuf gzipBuffer;
+
+	/**
+	 * Buffer the parser reads from (fileBuffer or gzipBuffer).
+	 */
+	std::streambuf *buffer;
+
+	/**
+	 * Number of the bytes read by the parser.
+	 */
+	XMLFilePos position;
+
+	/**
+	 * Set to true if the file is damaged (owned by the input source).
+	 */
+	bool *damaged;
+
+	/**
+	 * Not implemented copy constructor for the class ValidateBinInputStream.
+	 * @param validateBinInputStream Instance to be copied.
+	 */
+	ValidateBinInputStream(const ValidateBinInputStream &validateBinInputStream);
+
+	/**
+	 * Not implemented operator "=".
+	 * @param validateBinInputStream Right side of the operator.
+	 * @return Left side of the operator.
+	 */
+	ValidateBinInputStream &operator=(const ValidateBinInputStream &validateBinInputStream);
+
+public:
+	/**
+	 * Constructor for the class ValidateBinInputStream.
+	 * @param fileBuffer Buffer reading and hashing the opened file.
+	 * @param decompress True if the file is gzip-compressed.
+	 * @param damaged Set to true if the file is damaged.
+	 */
+	ValidateBinInputStream(HashingFileStreambuf *fileBuffer, const bool decompress, bool *damaged);
+
+	/**
+	 * Destructor for the class ValidateBinInputStream.
+	 */
+	~ValidateBinInputStream();
+
+	/**
+	 * Returns the position in the (decompressed) data.
+	 * @return Number of the read bytes.
+	 */
+	XMLFilePos curPos() const;
+
+	/**
+	 * Reads bytes. A damaged or truncated file ends the data early, so
+	 * the parser reports an error.
+	 * @param toFill Buffer for the bytes.
+	 * @param maxToRead Size of the buffer.
+	 * @return Number of the read bytes (0 at the end of the file).
+	 */
+	XMLSize_t readBytes(XMLByte* const toFill, const XMLSize_t maxToRead);
+
+	/**
+	 * Returns the content type (unknown).
+	 * @return 0.
+	 */
+	const XMLCh* getContentType() const;
+};
+
+
+/**
+ * Implements an InputSource for the validated file.
+ */
+class ValidateInputSource : public InputSource {
+private:
+	/**
+	 * Name of the file.
+	 */
+	std::string fileName;
+
+	/**
+	 * Buffer reading and hashing the file.
+	 */
+	mutable HashingFileStreambuf fileBuffer;
+
+	/**
+	 * True if the file is damaged.
+	 */
+	mutable bool damaged;
+
+	/**
+	 * Not implemented copy constructor for the class ValidateInputSource.
+	 * @param validateInputSource Instance to be copied.
+	 */
+	ValidateInputSource(const ValidateInputSource &validateInputSource);
+
+	/**
+	 * Not implemented operator "=".
+	 * @param validateInputSource Right side of the operator.
+	 * @return Left side of the operator.
+	 */
+	ValidateInputSource &operator=(const ValidateInputSource &validateInputSource);
+
+public:
+	/**
+	 * Constructor for the class ValidateInputSource.
+	 * @param fileName Name of the file.
+	 */
+	ValidateInputSource(const std::string &fileName);
+
+	/**
+	 * Destructor for the class ValidateInputSource.
+	 */
+	~ValidateInputSource();
+
+	/**
+	 * Opens the file and creates the stream reading it. The parser
+	 * calls it once.
+	 * @return The stream or 0 if the file cannot be opened.
+	 */
+	BinInputStream* makeStream() const;
+
+	/**
+	 * Returns true if the file turned out to be damaged or truncated
+	 * while it was parsed.
+	 * @return
+	 *   <ul>
+	 *     <li>true if the file is damaged,</li>
+	 *     <li>false otherwise.</li>
+	 *   </ul>
+	 */
+	inline bool getDamaged() const {
+		return (damaged);
+	}
+
+	/**
+	 * Returns the content hash of the whole file after it has been
+	 * parsed. Only the part the parser has not read (e.g. after an
+	 * error) is read again.
+	 * @return Content hash of the file.
+	 * @throws std::ios::failure if the file cannot be read.
+	 */
+	unsigned long long getContentHash();
+};
+
+
+#endif
@@ -16,6 +16,7 @@
 #include <xercesc/sax2/Attributes.hpp>
 
 #include "ValidateConstantsFunctionsAndClasses.hpp"
+#include "ValidateSymmetry.hpp"
 
 #include "ValidateSAX2ContentHandler.hpp"
 
@@ -115,6 +116,7 @@ void SAX2ContentHandler::init() {
 }
 
 SAX2ContentHandler::SAX2ContentHandler(): ContentHandler() {
+	statistics = 0;
 	init();
 }
 
@@ -129,53 +131,25 @@ void SAX2ContentHandler::startDocument() {
 }
 
 void SAX2ContentHandler::endDocument() {
-	//The decision if the graph is undirected. If yes,
-	//the matrix will be resized.
-	bool isUndirected = true;
-	for (vector<vector<double> >::size_type i = 0; i < n; i++) {
-		for (
-				vector<double>::size_type j = 0;
-				j < static_cast<vector<double>::size_type>(i);
-				j++) {
-			if (!parsedEntries.at(
-					static_cast<vector<vector<bool> >::size_type>(i)).at(
-							static_cast<vector<bool>::size_type>(j))) {
-				failed = true;
-				return;
-			}
-			if (!parsedEntries.at(
-					static_cast<vector<vector<bool> >::size_type>(j)).at(
-							static_cast<vector<bool>::size_type>(i))) {
-				failed = true;
-				return;
-			}
-			if (
-					abs(adjacencyMatrix.at(i).at(j) -
-							adjacencyMatrix.at(
-									static_cast<vector<vector<double> >::size_type>(j)).at(
-											static_cast<vector<double>::size_type>(i))) >
-					doubleZero) {
-				isUndirected = false;
-			}
-		}
+	//All entries outside the main diagonal have to be parsed.
+	if (!areAllEntriesParsed(parsedEntries)) {
+		failed = true;
+		return;
 	}
 
-	//Setting 0 on the main diagonal if necessary
-	if (isUndirected) {
-		for (vector<vector<double> >::size_type i = 0; i < n; i++) {
-			adjacencyMatrix.at(i).resize(static_cast<vector<double>::size_type>(i + 1));
-			if (!parsedEntries.at(i).at(
-					static_cast<vector<bool>::size_type>(i))) {
-				adjacencyMatrix.at(i).at(static_cast<vector<double>::size_type>(i)) = 0;
-			}
+	//The decision if the graph is undirected (see ValidateSymmetry.hpp).
+	ScopedPhaseTimer symmetryDetectionTimer(statistics, PHASE_SYMMETRY_DETECTION);
+	isUndirected = isSymmetricMatrix(adjacencyMatrix, doubleZero);
+	symmetryDetectionTimer.stop();
+
+	//Setting 0 on the main diagonal if necessary (and resizing the
+	//matrix to the lower triangle if the graph is undirected)
+	for (vector<vector<double> >::size_type i = 0; i < n; i++) {
+		if (isUndirected) {
+			adjacencyMatrix[i].resize(static_cast<vector<double>::size_type>(i + 1));
 		}
-	}
-	else {
-		for (vector<vector<bool> >::size_type i = 0; i < n; i++) {
-			if (!parsedEntries.at(i).at(
-					static_cast<vector<bool>::size_type>(i))) {
-				adjacencyMatrix.at(i).at(static_cast<vector<double>::size_type>(i)) = 0;
-			}
+		if (!parsedEntries[i][i]) {
+			adjacencyMatrix[i][i] = 0;
 		}
 	}
 }
@@ -201,6 +175,12 @@ void SAX2ContentHandler::startElement(
 		if (firstVertex) {
 			n = 1;
 		}
+
+		//Compact encoding.
+		const XMLCh* costsXMLCh = attributes.getValue(unicodeForm(XML_VERTEX_ATTRIBUTE_COSTS));
+		if (costsXMLCh != 0) {
+			setCompactRow(stringForm(costsXMLCh));
+		}
 	}
 
 	//edge
@@ -339,51 +319,86 @@ void SAX2ContentHandler::endElement(
 			failed = true;
 		}
 
-		//Now, the inequality numberOfParsedEdges >= 0 allways holds.
-		//We need special handling of the first row (since we do not know the number
-		//of vertices)
-		if (firstVertex) {
-			//In a complete graph there must be also defined an edge to the last vertex.
-			if (edge + 1 > n) {
-				n = edge + 1;
-			}
+		if (!failed) {
+			setEntry(edge, cost);
+		}
+	}
+}
 
-			//If necessary, we make the first row longer.
-			if (costsOfEdgesDefinedInTheFirstVertex.size() < edge + 1) {
-				costsOfEdgesDefinedInTheFirstVertex.resize(edge + 1);
-			}
+void SAX2ContentHandler::setEntry(const std::vector<double>::size_type edge, const double cost) {
+	//Now, the inequality numberOfParsedEdges >= 0 allways holds.
+	//We need special handling of the first row (since we do not know the number
+	//of vertices)
+	if (firstVertex) {
+		//In a complete graph there must be also defined an edge to the last vertex.
+		if (edge + 1 > n) {
+			n = edge + 1;
+		}
+
+		//If necessary, we make the first row longer.
+		if (costsOfEdgesDefinedInTheFirstVertex.size() < edge + 1) {
+			costsOfEdgesDefinedInTheFirstVertex.resize(edge + 1);
+		}
 
+		//The edges are not allowed to be redefined.
+		if (edgesDefinedInTheFirstVertex.count(edge) > 0) {
+			failed = true;
+			return;
+		}
+
+		//We mark the edges which have been defined.
+		edgesDefinedInTheFirstVertex.insert(edge);
+		costsOfEdgesDefinedInTheFirstVertex.at(edge) = cost;
+	}
+	else {
+		//We try to set the matrix entries
+		try {
 			//The edges are not allowed to be redefined.
-			if (edgesDefinedInTheFirstVertex.count(edge) > 0) {
+			if (parsedEntries.at(
+					static_cast<vector<vector<bool> >::size_type>(numberOfParsedVertices)).at(
+							static_cast<vector<bool>::size_type>(edge))) {
 				failed = true;
 				return;
 			}
 
-			//We mark the edges which have been defined.
-			edgesDefinedInTheFirstVertex.insert(edge);
-			costsOfEdgesDefinedInTheFirstVertex.at(edge) = cost;
+			//We set the cost.
+			parsedEntries.at(
+					static_cast<vector<vector<bool> >::size_type>(numberOfParsedVertices)).at(
+							static_cast<vector<bool>::size_type>(edge)) = true;
+			adjacencyMatrix.at(numberOfParsedVertices).at(edge) = cost;
 		}
-		else {
-			//We try to set the matrix entries
-			try {
-				//The edges are not allowed to be redefined.
-				if (parsedEntries.at(
-						static_cast<vector<vector<bool> >::size_type>(numberOfParsedVertices)).at(
-								static_cast<vector<bool>::size_type>(edge))) {
-					failed = true;
-					return;
-				}
+		catch ( ... ) {
+			failed = true;
+		}
+	}
+}
 
-				//We set the cost.
-				parsedEntries.at(
-						static_cast<vector<vector<bool> >::size_type>(numberOfParsedVertices)).at(
-								static_cast<vector<bool>::size_type>(edge)) = true;
-				adjacencyMatrix.at(numberOfParsedVertices).at(edge) = cost;
-			}
-			catch ( ... ) {
+void SAX2ContentHandler::setCompactRow(const std::string &costs) {
+	istringstream costsIStringstream(costs);
+	string entry;
+	vector<double>::size_type edge = 0;
+	while ((!failed) && (costsIStringstream >> entry)) {
+		//The entry of an edge which does not exist.
+		if (entry != XML_VALUE_ABSENT_COST) {
+			istringstream costIStringstream(entry);
+			double entryCost;
+			if ((!(costIStringstream >> entryCost)) || (!costIStringstream.eof())) {
 				failed = true;
+				return;
 			}
+			setEntry(edge, entryCost);
 		}
+		edge++;
+	}
+
+	//Every row lists all columns, so the first row determines the number of vertices.
+	if (firstVertex) {
+		if (edge > n) {
+			n = edge;
+		}
+	}
+	else if (edge != n) {
+		failed = true;
 	}
 }
 
@@ -17,6 +17,8 @@
 #include <vector>
 #include <set>
 
+#include "Statistics.hpp"
+
 using namespace xercesc;
 
 XERCES_CPP_NAMESPACE_USE
@@ -118,6 +120,11 @@ private:
 	 */
 	double cost;
 
+	/**
+	 * Statistics of the run (can be 0).
+	 */
+	Statistics *statistics;
+
 	/**
 	 * Not implemented copy constructor for the class SAX2ContentHandler.
 	 * @param sAX2ContentHandler Instance to be copied.
@@ -136,6 +143,21 @@ private:
 	 */
 	void init();
 
+	/**
+	 * Sets one entry of the row of the current vertex. The entries of
+	 * the first vertex are collected until the number of vertices is known.
+	 * @param edge Column of the entry.
+	 * @param cost Cost of the edge.
+	 */
+	void setEntry(const std::vector<double>::size_type edge, const double cost);
+
+	/**
+	 * Sets the row of the current vertex from the attribute "costs"
+	 * (compact encoding).
+	 * @param costs Value of the attribute "costs".
+	 */
+	void setCompactRow(const std::string &costs);
+
 public:
     /**
 	 * Constructor for the class SAXContentHandler.
@@ -159,6 +181,14 @@ public:
     	return (failed);
     }
 
+    /**
+     * Sets the statistics the time of the symmetry detection is added to.
+     * @param statistics Statistics of the run (can be 0).
+     */
+    inline void setStatistics(Statistics *statistics) {
+    	this->statistics = statistics;
+    }
+
 	/**
 	 * Returns the name.
 	 * @return Name.
@@ -0,0 +1,50 @@
+/**
+ * @file ValidateSymmetry.cpp
+ * Defines the checks of the parsed adjacency matrix.
+ *
+ * @brief Defines the checks of the parsed adjacency matrix.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "ValidateConstantsFunctionsAndClasses.hpp"
+
+#include "ValidateSymmetry.hpp"
+
+using namespace std;
+
+
+bool areAllEntriesParsed(const std::vector<std::vector<bool> > &parsedEntries) {
+	const vector<vector<bool> >::size_type n = parsedEntries.size();
+	for (vector<vector<bool> >::size_type i = 0; i < n; i++) {
+		const vector<bool> &parsedRow = parsedEntries[i];
+		for (vector<bool>::size_type j = 0; j < n; j++) {
+			if ((j != i) && (!parsedRow[j])) {
+				return (false);
+			}
+		}
+	}
+	return (true);
+}
+
+bool isSymmetricMatrix(const std::vector<std::vector<double> > &adjacencyMatrix, const double doubleZero) {
+	const vector<vector<double> >::size_type n = adjacencyMatrix.size();
+	const vector<vector<double> >::size_type blockSize =
+			static_cast<vector<vector<double> >::size_type>(SYMMETRY_DETECTION_BLOCK_SIZE);
+	for (vector<vector<double> >::size_type iBlock = 0; iBlock < n; iBlock += blockSize) {
+		const vector<vector<double> >::size_type iEnd = min(iBlock + blockSize, n);
+		for (vector<vector<double> >::size_type jBlock = 0; jBlock <= iBlock; jBlock += blockSize) {
+			for (vector<vector<double> >::size_type i = iBlock; i < iEnd; i++) {
+				const vector<double> &row = adjacencyMatrix[i];
+				const vector<double>::size_type jEnd = min(jBlock + blockSize, i);
+				for (vector<double>::size_type j = jBlock; j < jEnd; j++) {
+					if (abs(row[j] - adjacencyMatrix[j][i]) > doubleZero) {
+						return (false);
+					}
+				}
+			}
+		}
+	}
+	return (true);
+}
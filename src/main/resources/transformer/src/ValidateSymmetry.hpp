@@ -0,0 +1,37 @@
+/**
+ * @file ValidateSymmetry.hpp
+ * Defines the checks of the parsed adjacency matrix at the end of the
+ * document: all entries outside the main diagonal have to be parsed, and
+ * the graph is undirected if the matrix is symmetric. They do not depend
+ * on Xerces-C++, so the benchmark BenchmarkSymmetryDetection measures
+ * them alone.
+ *
+ * @brief Defines the checks of the parsed adjacency matrix.
+ */
+
+#ifndef _ValidateSymmetry_HPP_
+#define _ValidateSymmetry_HPP_
+
+#include <vector>
+
+
+/**
+ * Checks if all entries outside the main diagonal are parsed. The rows
+ * are checked one after the other (in the order they are stored in).
+ * @param parsedEntries The parsed entries (an n x n matrix).
+ * @return True if all entries outside the main diagonal are parsed.
+ */
+bool areAllEntriesParsed(const std::vector<std::vector<bool> > &parsedEntries);
+
+/**
+ * Checks if a square matrix is symmetric. The lower triangle is compared
+ * with the transposed upper triangle in square blocks of the size
+ * SYMMETRY_DETECTION_BLOCK_SIZE, so that the column accesses stay in the
+ * cache. The comparison stops at the first asymmetric pair.
+ * @param adjacencyMatrix The matrix (n rows of n entries).
+ * @param doubleZero Largest difference of two equal entries.
+ * @return True if the matrix is symmetric.
+ */
+bool isSymmetricMatrix(const std::vector<std::vector<double> > &adjacencyMatrix, const double doubleZero);
+
+#endif
@@ -0,0 +1,88 @@
+package jo.ju.edu.tsp.core;
+
+import org.jetbrains.annotations.NotNull;
+import org.junit.Test;
+
+import java.util.Arrays;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotEquals;
+import static org.junit.Assert.assertTrue;
+
+// The candidate edges of a CandidateGraph and the shared entry of the other edges.
+public class CandidateGraphTest {
+    // the vertices 0 ... n - 1 on a line, the cost of {i, j} is |i - j|.
+    static @NotNull PackedGraph line(int n, boolean symmetric) {
+        PackedGraph graph = new PackedGraph("line" + n, n, symmetric);
+        for(int i = 0; i < n; i++) {
+            for(int j = 0; j < (symmetric ? i : n); j++) {
+                if(j != i) graph.setCost(i, j, Math.abs(i - j));
+            }
+        }
+        return graph;
+    }
+
+    @Test
+    public void symmetricCandidatesShareTheirEdgeIds() {
+        CandidateGraph graph = CandidateGraph.ofNearestNeighbours(line(20, true), 2);
+        for(int v = 0; v < graph.getNumberOfVertices(); v++) {
+            for(int k = 0; k < graph.getDegree(v); k++) {
+                int u = graph.getNeighbour(v, k);
+                assertEquals(graph.getEdgeId(v, u), graph.getEdgeId(u, v));
+                assertTrue(graph.getEdgeId(v, u) < graph.getNumberOfCandidateEdges());
+                if(k > 0) assertTrue(graph.getCost(v, graph.getNeighbour(v, k - 1)) <= graph.getCost(v, u));
+            }
+        }
+        assertEquals(graph.getNumberOfCandidateEdges() + 1, graph.getNumberOfEdges());
+        // the other edges cost as in the base graph.
+        assertEquals(15, graph.getCost(2, 17), 0);
+    }
+
+    @Test
+    public void writesToNonCandidateEdgesAreSkipped() {
+        CandidateGraph graph = CandidateGraph.ofNearestNeighbours(line(20, true), 2);
+        double[] soil = graph.getColumn(EdgeAttribute.SOIL);
+        Arrays.fill(soil, 1000);
+        graph.set(soil, 0, 10, 1);
+        graph.setDirected(soil, 19, 3, 2);
+        assertEquals(1000, soil[graph.getEdgeId(0, 10)], 0);
+        assertEquals(1000, soil[graph.getEdgeId(5, 15)], 0);
+        graph.set(soil, 0, 1, 3);
+        assertEquals(3, soil[graph.getEdgeId(1, 0)], 0);
+        for(int e = 0; e < graph.getNumberOfEdges(); e++) {
+            if(e != graph.getEdgeId(0, 1)) assertEquals(1000, soil[e], 0);
+        }
+    }
+
+    @Test
+    public void asymmetricCandidatesHaveAnIdPerDirection() {
+        CandidateGraph graph = CandidateGraph.ofNearestNeighbours(line(10, false), 2);
+        assertNotEquals(graph.getEdgeId(4, 5), graph.getEdgeId(5, 4));
+        double[] depth = graph.getColumn(EdgeAttribute.DEPTH);
+        graph.setDirected(depth, 4, 5, 7);
+        assertEquals(7, depth[graph.getEdgeId(4, 5)], 0);
+        assertEquals(0, depth[graph.getEdgeId(5, 4)], 0);
+        graph.set(depth, 4, 3, 8);
+        assertEquals(8, depth[graph.getEdgeId(4, 3)], 0);
+        assertEquals(8, depth[graph.getEdgeId(3, 4)], 0);
+    }
+
+    @Test
+    public void shortListsAreFilledUpForTheTourKernels() {
+        NeighbourLists lists = NeighbourLists.build(CandidateGraph.ofNearestNeighbours(line(20, true), 2), 5);
+        // 0 is a candidate of 2, so 2 has three candidates and 0 has two.
+        assertEquals(3, lists.getWidth());
+        assertArrayEquals(new int[] {1, 2, 2}, Arrays.copyOfRange(lists.toKernelLists(), 0, 3));
+        assertArrayEquals(new int[] {1, 3, 0}, Arrays.copyOfRange(lists.toKernelLists(), 6, 9));
+    }
+
+    @Test
+    public void overlaysSkipTheSameWrites() {
+        CandidateGraph shared = CandidateGraph.ofNearestNeighbours(line(12, true), 2);
+        OverlayGraph graph = new OverlayGraph(shared);
+        double[] soil = graph.getColumn(EdgeAttribute.SOIL);
+        graph.set(soil, 0, 11, 5);
+        assertEquals(0, soil[graph.getEdgeId(0, 11)], 0);
+    }
+}
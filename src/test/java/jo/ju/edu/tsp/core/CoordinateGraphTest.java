@@ -0,0 +1,89 @@
+package jo.ju.edu.tsp.core;
+
+import jo.ju.edu.tsp.core.kernels.Metric;
+import org.jetbrains.annotations.NotNull;
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+// The edge ids of CoordinateGraph up to the largest graph that has int edge ids, and its cost rules.
+public class CoordinateGraphTest {
+    private static @NotNull CoordinateGraph onALine(int n) {
+        double[] x = new double[n], y = new double[n];
+        for(int i = 0; i < n; i++) {
+            x[i] = i;
+        }
+        return new CoordinateGraph("line" + n, x, y, Metric.EUC_2D);
+    }
+
+    @Test
+    public void edgeIdsAreThoseOfPackedGraph() {
+        int n = 40;
+        CoordinateGraph graph = onALine(n);
+        PackedGraph packed = new PackedGraph("packed", n, true);
+        assertEquals(packed.getNumberOfEdges(), graph.getNumberOfEdges());
+        for(int i = 0; i < n; i++) {
+            for(int j = 0; j < n; j++) {
+                if(i != j) assertEquals(packed.getEdgeId(i, j), graph.getEdgeId(i, j));
+            }
+        }
+    }
+
+    @Test
+    public void edgeIdsDoNotOverflowAtTheLimit() {
+        int n = CoordinateGraph.MAX_VERTICES_WITH_EDGE_IDS;
+        CoordinateGraph graph = onALine(n);
+        assertTrue(graph.hasEdgeIds());
+        assertEquals(2147450880, graph.getNumberOfEdges());
+        assertEquals(2147450879, graph.getEdgeId(n - 1, n - 2));
+        assertEquals(2147450879, graph.getEdgeId(n - 2, n - 1));
+        assertEquals(1073767311, graph.getEdgeId(0, 46342));
+        assertEquals(n - 1, graph.getCost(0, n - 1), 0);
+    }
+
+    @Test(expected = IllegalStateException.class)
+    public void largerGraphsHaveNoEdgeIds() {
+        CoordinateGraph graph = onALine(CoordinateGraph.MAX_VERTICES_WITH_EDGE_IDS + 1);
+        assertFalse(graph.hasEdgeIds());
+        graph.getEdgeId(1, 0);
+    }
+
+    @Test
+    public void onlyScansFillTheRowCache() {
+        double[] x = new double[100], y = new double[100];
+        for(int i = 0; i < x.length; i++) {
+            x[i] = i;
+        }
+        CoordinateGraph graph = new CoordinateGraph("scan", x, y, Metric.EUC_2D, false, 1);
+        RowCache rows = graph.getRowCache();
+        // scattered costs are computed alone.
+        for(int i = 0; i < 50; i++) {
+            assertEquals(1, graph.getCost(i, i + 1), 0);
+        }
+        assertEquals(0, rows.getHits());
+        assertEquals(50, rows.getMisses());
+        // a scan of the adjacent vertices of 7 fills its row, which then serves both directions.
+        for(int k = 0; k < graph.getDegree(7); k++) {
+            int v = graph.getNeighbour(7, k);
+            assertEquals(Math.abs(v - 7), graph.getCost(7, v), 0);
+        }
+        assertEquals(99 - 16, rows.getHits());
+        assertEquals(3, graph.getCost(10, 7), 0);
+        assertEquals(99 - 16 + 1, rows.getHits());
+    }
+
+    @Test
+    public void attAndGeoAreAlwaysRounded() {
+        double[] x = {0, 10}, y = {0, 0};
+        // sqrt(100 / 10) = 3.16... is rounded up to 4, as TransformTSPLIB writes it.
+        assertEquals(4, new CoordinateGraph("att", x, y, Metric.ATT, false, 0).getCost(0, 1), 0);
+        double geo = new CoordinateGraph("geo", new double[] {52.31, 48.08}, new double[] {13.24, 11.34}, Metric.GEO, false, 0).getCost(0, 1);
+        assertEquals(Math.rint(geo), geo, 0);
+        // EUC_2D stays exact unless rounding is asked for.
+        double[] x2 = {0, 1}, y2 = {0, 1};
+        assertEquals(Math.sqrt(2), new CoordinateGraph("euc", x2, y2, Metric.EUC_2D, false, 0).getCost(0, 1), 1e-15);
+        assertEquals(1, new CoordinateGraph("euc", x2, y2, Metric.EUC_2D, true, 0).getCost(0, 1), 0);
+    }
+}
@@ -0,0 +1,32 @@
+package jo.ju.edu.tsp.core;
+
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+
+// The lookups of Graph through its edge index.
+public class GraphTest {
+    @Test
+    public void verticesAreFoundByTheirEdges() {
+        Graph graph = new Graph(3, "lookups");
+        graph.put(0, new Vertex(2, 4));
+        graph.put(2, new Vertex(0, 5));
+        assertEquals(4, graph.getVertex(0, 2).getCost(), 0);
+        assertEquals(5, graph.getVertex(2, 0).getCost(), 0);
+        assertNull(graph.getVertex(0, 1));
+        // false information: an id out of range is found by the scan.
+        graph.put(1, new Vertex(7, 6));
+        assertEquals(6, graph.getVertex(1, 7).getCost(), 0);
+    }
+
+    @Test(expected = IndexOutOfBoundsException.class)
+    public void verticesOutOfRangeAreRejected() {
+        new Graph(3, "lookups").getVertex(3, 0);
+    }
+
+    @Test(expected = IndexOutOfBoundsException.class)
+    public void negativeVerticesAreRejected() {
+        new Graph(3, "lookups").getVertex(-1, 0);
+    }
+}
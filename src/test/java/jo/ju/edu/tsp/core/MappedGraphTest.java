@@ -0,0 +1,122 @@
+package jo.ju.edu.tsp.core;
+
+import jo.ju.edu.tsp.core.kernels.Metric;
+import org.jetbrains.annotations.NotNull;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+import java.nio.file.Files;
+
+import static jo.ju.edu.tsp.core.TestGraphs.randomGraph;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+// Round trips through the binary instance format: a graph written by GraphSnapshot is mapped again by MappedGraph.
+public class MappedGraphTest {
+    @Rule
+    public final TemporaryFolder folder = new TemporaryFolder();
+
+    private @NotNull MappedGraph roundTrip(@NotNull WeightedGraph graph) throws IOException {
+        File source = folder.newFile(graph.getName() + ".xml");
+        Files.write(source.toPath(), ("<graph n=\"" + graph.getNumberOfVertices() + "\"/>").getBytes("UTF-8"));
+        File directory = folder.newFolder();
+        GraphSnapshot snapshot = GraphSnapshot.of(directory, source);
+        assertNull(snapshot.open(graph.getName(), graph.getNumberOfVertices()));
+        snapshot.write(graph);
+        MappedGraph mapped = GraphSnapshot.of(directory, source).open(graph.getName(), graph.getNumberOfVertices());
+        assertNotNull(mapped);
+        return mapped;
+    }
+
+    private static void assertSameGraph(@NotNull WeightedGraph expected, @NotNull WeightedGraph actual) {
+        int n = expected.getNumberOfVertices();
+        assertEquals(n, actual.getNumberOfVertices());
+        assertEquals(expected.isSymmetric(), actual.isSymmetric());
+        assertEquals(expected.getNumberOfEdges(), actual.getNumberOfEdges());
+        for(int i = 0; i < n; i++) {
+            for(int j = 0; j < n; j++) {
+                if(i == j) continue;
+                assertEquals(expected.getCost(i, j), actual.getCost(i, j), 0);
+                assertEquals(expected.getEdgeId(i, j), actual.getEdgeId(i, j));
+            }
+        }
+    }
+
+    @Test
+    public void symmetricGraphsRoundTrip() throws IOException {
+        PackedGraph graph = randomGraph("random", 300, true, 1);
+        assertSameGraph(graph, roundTrip(graph));
+    }
+
+    @Test
+    public void asymmetricGraphsRoundTrip() throws IOException {
+        PackedGraph graph = randomGraph("random", 120, false, 2);
+        assertSameGraph(graph, roundTrip(graph));
+    }
+
+    @Test
+    public void aChangedSourceHasAnotherSnapshot() throws IOException {
+        File source = folder.newFile("changed.xml");
+        Files.write(source.toPath(), "<graph/>".getBytes("UTF-8"));
+        File directory = folder.newFolder();
+        GraphSnapshot.of(directory, source).write(randomGraph("random", 10, true, 3));
+        Files.write(source.toPath(), "<graph></graph>".getBytes("UTF-8"));
+        GraphSnapshot changed = GraphSnapshot.of(directory, source);
+        assertNull(changed.open("changed", 10));
+        changed.write(randomGraph("random", 10, true, 4));
+        // the snapshot of the former content is deleted.
+        File[] snapshots = directory.listFiles();
+        assertNotNull(snapshots);
+        assertEquals(1, snapshots.length);
+        assertEquals(changed.getFile().getName(), snapshots[0].getName());
+    }
+
+    private @NotNull File writeCoordinates(@NotNull Metric metric, @NotNull double[] x, @NotNull double[] y) throws IOException {
+        File file = folder.newFile(metric + ".tspb");
+        try(RandomAccessFile raf = new RandomAccessFile(file, "rw"); FileChannel channel = raf.getChannel()) {
+            new BinaryInstanceHeader(BinaryInstanceHeader.KIND_COORDINATES, metric.ordinal() + 1, x.length).write(channel);
+            ByteBuffer payload = ByteBuffer.allocate(16 * x.length).order(ByteOrder.LITTLE_ENDIAN);
+            for(int i = 0; i < x.length; i++) {
+                payload.putDouble(x[i]).putDouble(y[i]);
+            }
+            payload.flip();
+            channel.position(BinaryInstanceHeader.SIZE);
+            while(payload.hasRemaining()) {
+                channel.write(payload);
+            }
+        }
+        return file;
+    }
+
+    @Test
+    public void coordinatesFollowTheRulesOfTheConverter() throws IOException {
+        double[] x = {0, 10, 3}, y = {0, 0, 4};
+        // EUC_2D is exact, as in the XML files.
+        MappedGraph euclidean = MappedGraph.open(writeCoordinates(Metric.EUC_2D, x, y), "euclidean");
+        assertEquals(Math.sqrt(65), euclidean.getCost(1, 2), 1e-12);
+        assertEquals(5, euclidean.getCost(0, 2), 0);
+        // ATT is rounded up: sqrt(100 / 10) = 3.16... costs 4.
+        MappedGraph att = MappedGraph.open(writeCoordinates(Metric.ATT, x, y), "att");
+        assertEquals(4, att.getCost(0, 1), 0);
+        // GEO costs are integers.
+        double[] latitudes = {52.31, 48.08, 41.54}, longitudes = {13.24, 11.34, 12.29};
+        MappedGraph geo = MappedGraph.open(writeCoordinates(Metric.GEO, latitudes, longitudes), "geo");
+        for(int i = 0; i < 3; i++) {
+            for(int j = 0; j < 3; j++) {
+                if(i == j) continue;
+                double cost = geo.getCost(i, j);
+                assertTrue(cost > 0);
+                assertEquals(Math.rint(cost), cost, 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,69 @@
+package jo.ju.edu.tsp.core;
+
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+
+// The edge ids of PackedGraph, also near the largest graph that has int edge ids.
+public class PackedGraphTest {
+    // the largest symmetric graph: 65536 * 65535 / 2 = 2147450880 edges.
+    private static final int MAX_SYMMETRIC_VERTICES = 65536;
+
+    @Test
+    public void symmetricEdgeIdsAreTheLowerTriangleInRowOrder() {
+        int n = 50;
+        PackedGraph graph = new PackedGraph("ids", n, true);
+        int expected = 0;
+        for(int i = 1; i < n; i++) {
+            for(int j = 0; j < i; j++, expected++) {
+                assertEquals(expected, graph.getEdgeId(i, j));
+                assertEquals(expected, graph.getEdgeId(j, i));
+            }
+        }
+        assertEquals(expected, graph.getNumberOfEdges());
+    }
+
+    @Test
+    public void asymmetricEdgeIdsAreTheFullMatrix() {
+        int n = 20;
+        PackedGraph graph = new PackedGraph("ids", n, false);
+        for(int i = 0; i < n; i++) {
+            for(int j = 0; j < n; j++) {
+                assertEquals(i * n + j, graph.getEdgeId(i, j));
+            }
+        }
+    }
+
+    @Test
+    public void lowerEdgeIdsDoNotOverflowNearTheLimit() {
+        int last = MAX_SYMMETRIC_VERTICES - 1;
+        assertEquals(Integer.MAX_VALUE - 32768, PackedGraph.getLowerEdgeId(last, last - 1));
+        assertEquals(Integer.MAX_VALUE - 32768, PackedGraph.getLowerEdgeId(last - 1, last));
+        assertEquals((int) ((long) last * (last - 1) / 2), PackedGraph.getLowerEdgeId(last, 0));
+        // the first row whose i * (i - 1) does not fit into an int.
+        assertEquals(1073767311, PackedGraph.getLowerEdgeId(46342, 0));
+        assertEquals(1073767311 - 1, PackedGraph.getLowerEdgeId(46341, 46340));
+    }
+
+    @Test
+    public void costsAreStoredAtTheEdgeIds() {
+        PackedGraph graph = new PackedGraph("costs", 4, true);
+        graph.setCost(3, 1, 7.5);
+        assertEquals(7.5, graph.getCost(1, 3), 0);
+        assertEquals(0, graph.getCost(2, 1), 0);
+        PackedGraph floats = new PackedGraph("costs", 4, false, true);
+        floats.setCost(3, 1, 7.5);
+        assertEquals(7.5, floats.getCost(3, 1), 0);
+        assertEquals(0, floats.getCost(1, 3), 0);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void tooLargeSymmetricGraphsAreRejected() {
+        new PackedGraph("too large", MAX_SYMMETRIC_VERTICES + 1, true);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void tooLargeAsymmetricGraphsAreRejected() {
+        new PackedGraph("too large", 46341, false);
+    }
+}
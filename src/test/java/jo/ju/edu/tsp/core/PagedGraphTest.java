@@ -0,0 +1,76 @@
+package jo.ju.edu.tsp.core;
+
+import org.jetbrains.annotations.NotNull;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+
+import static jo.ju.edu.tsp.core.TestGraphs.randomGraph;
+import static org.junit.Assert.assertEquals;
+
+// The full rows of a PagedGraph read from the binary matrices written by GraphSnapshot.
+public class PagedGraphTest {
+    @Rule
+    public final TemporaryFolder folder = new TemporaryFolder();
+
+    private @NotNull File write(@NotNull PackedGraph graph) throws IOException {
+        File source = folder.newFile(graph.getName() + ".xml");
+        Files.write(source.toPath(), graph.getName().getBytes("UTF-8"));
+        GraphSnapshot snapshot = GraphSnapshot.of(folder.newFolder(), source);
+        snapshot.write(graph);
+        return snapshot.getFile();
+    }
+
+    private void assertSameCosts(@NotNull PackedGraph graph, int rowsPerPage) throws IOException {
+        int n = graph.getNumberOfVertices();
+        try(PagedGraph paged = new PagedGraph(graph.getName(), new BinaryPageSource(write(graph)), rowsPerPage, 2, 1)) {
+            assertEquals(graph.isSymmetric(), paged.isSymmetric());
+            for(int i = 0; i < n; i++) {
+                for(int j = 0; j < n; j++) {
+                    assertEquals(i == j ? 0 : graph.getCost(i, j), paged.getCost(i, j), 0);
+                }
+            }
+            // every page is read once when the rows are walked in order.
+            assertEquals((n + rowsPerPage - 1) / rowsPerPage, paged.getPageReads());
+        }
+    }
+
+    @Test
+    public void lowerTrianglesAreReadAsFullRows() throws IOException {
+        assertSameCosts(randomGraph("lower", 50, true, 50), 7);
+        assertSameCosts(randomGraph("single", 20, true, 20), 1);
+        assertSameCosts(randomGraph("whole", 20, true, 20), 64);
+    }
+
+    @Test
+    public void fullMatricesAreReadAsRows() throws IOException {
+        assertSameCosts(randomGraph("full", 30, false, 30), 4);
+    }
+
+    @Test
+    public void theNearestNeighboursReadEveryPageOnce() throws IOException {
+        PackedGraph graph = randomGraph("neighbours", 50, true, 50);
+        try(PagedGraph paged = new PagedGraph(graph.getName(), new BinaryPageSource(write(graph)), 7, 2, 1)) {
+            CandidateGraph candidates = CandidateGraph.ofNearestNeighbours(paged, 3);
+            assertEquals(8, paged.getPageReads());
+            CandidateGraph expected = CandidateGraph.ofNearestNeighbours(graph, 3);
+            for(int v = 0; v < 50; v++) {
+                assertEquals(expected.getDegree(v), candidates.getDegree(v));
+                for(int k = 0; k < expected.getDegree(v); k++) {
+                    assertEquals(expected.getNeighbour(v, k), candidates.getNeighbour(v, k));
+                }
+            }
+        }
+    }
+
+    @Test(expected = UnsupportedOperationException.class)
+    public void theColumnsAreNotPaged() throws IOException {
+        try(PagedGraph paged = new PagedGraph("columns", new BinaryPageSource(write(randomGraph("columns", 10, true, 10))))) {
+            paged.getColumn(EdgeAttribute.SOIL);
+        }
+    }
+}
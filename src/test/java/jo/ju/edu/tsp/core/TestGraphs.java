@@ -0,0 +1,25 @@
+package jo.ju.edu.tsp.core;
+
+import org.jetbrains.annotations.NotNull;
+
+import java.util.Random;
+
+// The graphs shared by the tests of the graph views.
+public final class TestGraphs {
+    private TestGraphs() {
+    }
+
+    // a complete graph with distinct integer costs in an order given by the seed, so the same seed gives the same graph
+    // and the nearest neighbours of a vertex are unique.
+    public static @NotNull PackedGraph randomGraph(@NotNull String name, int n, boolean symmetric, long seed) {
+        Random random = new Random(seed);
+        PackedGraph graph = new PackedGraph(name, n, symmetric);
+        long edge = 0;
+        for(int i = 0; i < n; i++) {
+            for(int j = 0; j < (symmetric ? i : n); j++) {
+                if(j != i) graph.setCost(i, j, 1 + edge++ + (double) n * n * random.nextInt(100));
+            }
+        }
+        return graph;
+    }
+}
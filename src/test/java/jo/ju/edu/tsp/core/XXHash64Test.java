@@ -0,0 +1,78 @@
+package jo.ju.edu.tsp.core;
+
+import org.jetbrains.annotations.NotNull;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+
+import static org.junit.Assert.assertEquals;
+
+// Known answers of XXH64 (seed 0): the published values of the reference implementation, and the same hashes as the
+// ContentHash of Validate (ValidateCache.hpp), so both sides agree on the content hash of a file.
+public class XXHash64Test {
+    // the bytes (31 i + 7) mod 256, long enough for all paths: the tail only, exactly one stripe, stripes and a tail.
+    private static final int[] PATTERN_LENGTHS = {31, 32, 33, 100, 1000};
+    private static final long[] PATTERN_HASHES = {
+            0x4a74f3a1a39ad4a1L, 0x8d57d6a4671cc43dL, 0x62c9fd21ed857664L, 0xefa0ad2d3e70c151L, 0x99594f4828043d35L
+    };
+
+    @Rule
+    public final TemporaryFolder folder = new TemporaryFolder();
+
+    private static @NotNull byte[] pattern(int length) {
+        byte[] bytes = new byte[length];
+        for(int i = 0; i < length; i++) {
+            bytes[i] = (byte) (i * 31 + 7);
+        }
+        return bytes;
+    }
+
+    // the bytes given in chunks of chunkSize bytes.
+    private static long hash(@NotNull byte[] bytes, int chunkSize) {
+        XXHash64 hash = new XXHash64();
+        for(int p = 0; p < bytes.length; p += chunkSize) {
+            hash.update(ByteBuffer.wrap(bytes, p, Math.min(chunkSize, bytes.length - p)));
+        }
+        return hash.digest();
+    }
+
+    private static long hash(@NotNull String text) {
+        byte[] bytes = text.getBytes(StandardCharsets.US_ASCII);
+        return hash(bytes, Math.max(1, bytes.length));
+    }
+
+    @Test
+    public void publishedValues() {
+        assertEquals(0xef46db3751d8e999L, hash(""));
+        assertEquals(0xd24ec4f1a98c6e5bL, hash("a"));
+        assertEquals(0x44bc2cf5ad770999L, hash("abc"));
+        assertEquals(0xfbcea83c8a378bf1L, hash("Nobody inspects the spammish repetition"));
+    }
+
+    @Test
+    public void theChunksDoNotMatter() {
+        for(int t = 0; t < PATTERN_LENGTHS.length; t++) {
+            byte[] bytes = pattern(PATTERN_LENGTHS[t]);
+            for(int chunkSize : new int[] {1, 7, 8, 31, 32, 33, 4096}) {
+                assertEquals("length " + bytes.length + ", chunks of " + chunkSize, PATTERN_HASHES[t], hash(bytes, chunkSize));
+            }
+        }
+    }
+
+    @Test
+    public void filesAreHashedByTheirContent() throws IOException {
+        File empty = folder.newFile("empty");
+        assertEquals(0xef46db3751d8e999L, XXHash64.of(empty));
+        for(int t = 0; t < PATTERN_LENGTHS.length; t++) {
+            File file = folder.newFile("pattern" + PATTERN_LENGTHS[t]);
+            Files.write(file.toPath(), pattern(PATTERN_LENGTHS[t]));
+            assertEquals(PATTERN_HASHES[t], XXHash64.of(file));
+        }
+    }
+}
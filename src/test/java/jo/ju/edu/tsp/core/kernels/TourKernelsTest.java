@@ -0,0 +1,123 @@
+package jo.ju.edu.tsp.core.kernels;
+
+import jo.ju.edu.tsp.core.NeighbourLists;
+import jo.ju.edu.tsp.core.PackedGraph;
+import org.jetbrains.annotations.NotNull;
+import org.junit.Assume;
+import org.junit.Test;
+
+import java.util.Random;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+// The Java and the native kernels have to give the same tours. The native tests are skipped if libtspkernels is not
+// on java.library.path (see NativeTourKernels).
+public class TourKernelsTest {
+    private static final int VERTICES = 2000;
+    private static final int NEIGHBOURS = 10;
+
+    private static @NotNull CostBuffer randomCoordinates(int n, @NotNull Metric metric, boolean rounded, long seed) {
+        Random random = new Random(seed);
+        double[] x = new double[n], y = new double[n];
+        for(int i = 0; i < n; i++) {
+            // GEO coordinates are DDD.MM (degrees and minutes), the others are points in a square.
+            x[i] = metric == Metric.GEO ? random.nextInt(180) - 90 + random.nextInt(60) / 100.0 : random.nextDouble() * 1e5;
+            y[i] = metric == Metric.GEO ? random.nextInt(360) - 180 + random.nextInt(60) / 100.0 : random.nextDouble() * 1e5;
+        }
+        return CostBuffer.ofCoordinates(x, y, metric, rounded);
+    }
+
+    private static @NotNull CostBuffer lowerMatrixOf(@NotNull CostBuffer coordinates) {
+        int n = coordinates.getNumberOfVertices();
+        double[] lower = new double[n * (n - 1) / 2];
+        for(int i = 1; i < n; i++) {
+            for(int j = 0; j < i; j++) {
+                lower[i * (i - 1) / 2 + j] = coordinates.getCost(i, j);
+            }
+        }
+        return CostBuffer.ofMatrix(lower, n, true);
+    }
+
+    private static @NotNull int[] identityTour(int n) {
+        int[] tour = new int[n];
+        for(int i = 0; i < n; i++) {
+            tour[i] = i;
+        }
+        return tour;
+    }
+
+    private static void assertSameTwoOpt(@NotNull CostBuffer costs) {
+        Assume.assumeTrue("libtspkernels is not available", NativeTourKernels.isAvailable());
+        int n = costs.getNumberOfVertices();
+        int[] neighbours = TourKernels.computeNeighbourLists(costs, NEIGHBOURS);
+        TourKernels java = new JavaTourKernels(costs), nativeKernels = new NativeTourKernels(costs);
+
+        int[] tour = identityTour(n);
+        assertEquals(java.getTourLength(tour), nativeKernels.getTourLength(tour), 0);
+
+        int[] javaTour = identityTour(n), nativeTour = identityTour(n);
+        double javaLength = java.improveByTwoOpt(javaTour, neighbours, NEIGHBOURS);
+        double nativeLength = nativeKernels.improveByTwoOpt(nativeTour, neighbours, NEIGHBOURS);
+        assertArrayEquals(javaTour, nativeTour);
+        assertEquals(javaLength, nativeLength, 0);
+    }
+
+    @Test
+    public void twoOptIsTheSameOnExactEuclideanCoordinates() {
+        assertSameTwoOpt(randomCoordinates(VERTICES, Metric.EUC_2D, false, 1));
+    }
+
+    @Test
+    public void twoOptIsTheSameOnRoundedCoordinates() {
+        for(Metric metric : Metric.values()) {
+            assertSameTwoOpt(randomCoordinates(VERTICES, metric, true, 2));
+        }
+    }
+
+    @Test
+    public void twoOptIsTheSameOnALowerMatrix() {
+        assertSameTwoOpt(lowerMatrixOf(randomCoordinates(VERTICES, Metric.EUC_2D, true, 3)));
+    }
+
+    @Test
+    public void twoOptImprovesTheTour() {
+        CostBuffer costs = randomCoordinates(VERTICES, Metric.EUC_2D, false, 4);
+        TourKernels java = new JavaTourKernels(costs);
+        int[] tour = identityTour(VERTICES);
+        double length = java.getTourLength(tour);
+        double improved = java.improveByTwoOpt(tour, TourKernels.computeNeighbourLists(costs, NEIGHBOURS), NEIGHBOURS);
+        assertEquals(improved, java.getTourLength(tour), 0);
+        assertTrue(improved < length);
+    }
+
+    @Test
+    public void graphsWithoutACostBufferGiveTheSameTwoOpt() {
+        // exact costs, so the neighbour lists have no ties.
+        CostBuffer costs = lowerMatrixOf(randomCoordinates(500, Metric.EUC_2D, false, 6));
+        int n = costs.getNumberOfVertices();
+        PackedGraph graph = new PackedGraph("random", n, true);
+        for(int i = 1; i < n; i++) {
+            for(int j = 0; j < i; j++) {
+                graph.setCost(i, j, costs.getCost(i, j));
+            }
+        }
+        int[] neighbours = TourKernels.computeNeighbourLists(costs, NEIGHBOURS);
+        NeighbourLists lists = NeighbourLists.build(graph, NEIGHBOURS);
+        assertEquals(NEIGHBOURS, lists.getWidth());
+        assertArrayEquals(neighbours, lists.toKernelLists());
+
+        int[] bufferTour = identityTour(n), graphTour = identityTour(n);
+        double bufferLength = new JavaTourKernels(costs).improveByTwoOpt(bufferTour, neighbours, NEIGHBOURS);
+        double graphLength = new JavaTourKernels(graph::getCost).improveByTwoOpt(graphTour, lists.toKernelLists(), lists.getWidth());
+        assertArrayEquals(bufferTour, graphTour);
+        assertEquals(bufferLength, graphLength, 0);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void tooManyNeighboursAreRejected() {
+        // 300000 lists of 10000 neighbours are more than Integer.MAX_VALUE entries.
+        TourKernels.computeNeighbourLists(randomCoordinates(300000, Metric.EUC_2D, false, 5), 10000);
+    }
+}
@@ -0,0 +1,80 @@
+package jo.ju.edu.tsp.core.tsplib;
+
+import jo.ju.edu.tsp.core.CandidateGraph;
+import jo.ju.edu.tsp.core.WeightedGraph;
+import org.jetbrains.annotations.NotNull;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.io.OutputStreamWriter;
+import java.io.Writer;
+import java.nio.charset.StandardCharsets;
+import java.util.zip.GZIPOutputStream;
+
+import static jo.ju.edu.tsp.core.TestGraphs.randomGraph;
+import static org.junit.Assert.assertEquals;
+
+// Round trips through the candidate format (see CandidateFormat.hpp): the lists of a CandidateGraph are written as a
+// ".cand" file the way TransformTSPLIB writes them and read again.
+public class CandidateReaderTest {
+    @Rule
+    public final TemporaryFolder folder = new TemporaryFolder();
+
+    private @NotNull File write(@NotNull CandidateGraph graph, int k, @NotNull String fileName) throws IOException {
+        File file = folder.newFile(fileName);
+        try(OutputStream fileOut = new FileOutputStream(file);
+            OutputStream out = fileName.endsWith(".gz") ? new GZIPOutputStream(fileOut) : fileOut;
+            Writer writer = new OutputStreamWriter(out, StandardCharsets.ISO_8859_1)) {
+            writer.write("NAME: " + graph.getName() + "\nTYPE: CANDIDATES\nDIMENSION: " + graph.getNumberOfVertices()
+                    + "\nCANDIDATES: " + k + "\nCANDIDATE_SECTION\n");
+            for(int v = graph.getNumberOfVertices() - 1; v >= 0; v--) {
+                StringBuilder line = new StringBuilder().append(v + 1);
+                for(int l = 0; l < graph.getDegree(v); l++) {
+                    int u = graph.getNeighbour(v, l);
+                    line.append(' ').append(u + 1).append(' ').append((long) graph.getCost(v, u));
+                }
+                writer.write(line.append('\n').toString());
+            }
+            writer.write("EOF\n");
+        }
+        return file;
+    }
+
+    private static void assertSameCandidates(@NotNull CandidateGraph expected, @NotNull CandidateGraph actual) {
+        assertEquals(expected.getNumberOfCandidateEdges(), actual.getNumberOfCandidateEdges());
+        for(int v = 0; v < expected.getNumberOfVertices(); v++) {
+            assertEquals(expected.getDegree(v), actual.getDegree(v));
+            for(int l = 0; l < expected.getDegree(v); l++) {
+                int u = expected.getNeighbour(v, l);
+                assertEquals(u, actual.getNeighbour(v, l));
+                assertEquals(expected.getCost(v, u), actual.getCost(v, u), 0);
+                assertEquals(expected.getEdgeId(v, u), actual.getEdgeId(v, u));
+            }
+        }
+    }
+
+    @Test
+    public void candidateFilesRoundTrip() throws IOException {
+        WeightedGraph base = randomGraph("random60", 60, true, 60);
+        CandidateGraph graph = CandidateGraph.ofNearestNeighbours(base, 5);
+        assertSameCandidates(graph, CandidateReader.read(write(graph, 5, "random60.cand"), base));
+    }
+
+    @Test
+    public void compressedCandidateFilesRoundTrip() throws IOException {
+        WeightedGraph base = randomGraph("random40", 40, true, 40);
+        CandidateGraph graph = CandidateGraph.ofNearestNeighbours(base, 3);
+        assertSameCandidates(graph, CandidateReader.read(write(graph, 3, "random40.cand.gz"), base));
+    }
+
+    @Test(expected = IOException.class)
+    public void anotherDimensionIsRejected() throws IOException {
+        CandidateGraph graph = CandidateGraph.ofNearestNeighbours(randomGraph("random20", 20, true, 20), 3);
+        CandidateReader.read(write(graph, 3, "random20.cand"), randomGraph("random21", 21, true, 21));
+    }
+}
@@ -0,0 +1,158 @@
+package jo.ju.edu.tsp.core.xml;
+
+import jo.ju.edu.tsp.core.PackedGraph;
+import org.jetbrains.annotations.NotNull;
+import org.w3c.dom.Document;
+import org.w3c.dom.Element;
+import org.w3c.dom.Node;
+import org.w3c.dom.NodeList;
+
+import javax.xml.parsers.DocumentBuilderFactory;
+import javax.xml.parsers.SAXParserFactory;
+import java.io.BufferedWriter;
+import java.io.File;
+import java.io.FileWriter;
+import java.io.IOException;
+import java.io.Writer;
+import java.util.Arrays;
+import java.util.Locale;
+import java.util.Random;
+
+// Measures the time to read an XML graph into a PackedGraph with the EdgeScanner (-Dtsp.xml.loader=scan), the SAX
+// parser (=sax) and, as the reference of the former loaders, a DOM tree whose elements are walked afterwards. Every
+// loader reads the file REPETITIONS times after one warm-up run; the median is printed, and the graphs have to be equal.
+//
+//     java -cp target/classes:target/test-classes:... jo.ju.edu.tsp.core.xml.LoaderBenchmark [FILE SIZE | VERTICES] [REPETITIONS]
+//
+// Without a file, a symmetric graph of VERTICES (default 2000) vertices with random costs is written to a temporary
+// file in the verbose encoding of TransformTSPLIB. Run it with a heap large enough for the DOM tree (-Xmx).
+public class LoaderBenchmark {
+    private static final int DEFAULT_VERTICES = 2000;
+    private static final int DEFAULT_REPETITIONS = 5;
+
+    private interface Loader {
+        @NotNull PackedGraph load(@NotNull File file, int size) throws Exception;
+    }
+
+    private static @NotNull PackedGraph scan(@NotNull File file, int size) throws Exception {
+        PackedGraphHandler handler = new PackedGraphHandler(size, file.getName(), false);
+        EdgeScanner.scan(file, handler);
+        return handler.getGraph();
+    }
+
+    private static @NotNull PackedGraph sax(@NotNull File file, int size) throws Exception {
+        PackedGraphHandler handler = new PackedGraphHandler(size, file.getName(), false);
+        SAXParserFactory spf = SAXParserFactory.newInstance();
+        spf.setNamespaceAware(true);
+        spf.newSAXParser().parse(file, handler);
+        return handler.getGraph();
+    }
+
+    // the whole document is built before the first edge is read, as the DOM loaders did.
+    private static @NotNull PackedGraph dom(@NotNull File file, int size) throws Exception {
+        Document document = DocumentBuilderFactory.newInstance().newDocumentBuilder().parse(file);
+        NodeList vertices = document.getElementsByTagName("vertex");
+        boolean symmetric = true;
+        NodeList firstRow = vertices.getLength() > 0 ? ((Element) vertices.item(0)).getElementsByTagName("edge") : null;
+        for(int e = 0; firstRow != null && e < firstRow.getLength(); e++) {
+            if(Integer.parseInt(firstRow.item(e).getTextContent().trim()) == 0) symmetric = false;
+        }
+        PackedGraph graph = new PackedGraph(file.getName(), size, symmetric);
+        for(int i = 0; i < Math.min(size, vertices.getLength()); i++) {
+            for(Node edge = vertices.item(i).getFirstChild(); edge != null; edge = edge.getNextSibling()) {
+                if(edge.getNodeType() != Node.ELEMENT_NODE || !edge.getNodeName().equalsIgnoreCase("edge")) continue;
+                int j = Integer.parseInt(edge.getTextContent().trim());
+                if(j < size && (!symmetric || j < i)) {
+                    graph.setCost(i, j, Double.parseDouble(((Element) edge).getAttribute("cost")));
+                }
+            }
+        }
+        return graph;
+    }
+
+    private static void writeRandomGraph(@NotNull File file, int n) throws IOException {
+        Random random = new Random(1);
+        double[] lower = new double[n * (n - 1) / 2];
+        for(int e = 0; e < lower.length; e++) {
+            lower[e] = 1 + random.nextInt(1000000);
+        }
+        try(Writer out = new BufferedWriter(new FileWriter(file), 1 << 16)) {
+            out.write("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\" ?>\n");
+            out.write("<travellingSalesmanProblemInstance>\n<name>random" + n + "</name>\n<graph>\n");
+            for(int i = 0; i < n; i++) {
+                out.write("<vertex>\n");
+                for(int j = 0; j < n; j++) {
+                    if(j == i) continue;
+                    double cost = lower[PackedGraph.getLowerEdgeId(i, j)];
+                    out.write(String.format(Locale.ROOT, "<edge cost=\"%.15e\">%d</edge>\n", cost, j));
+                }
+                out.write("</vertex>\n");
+            }
+            out.write("</graph>\n</travellingSalesmanProblemInstance>\n");
+        }
+    }
+
+    private static void assertEqualGraphs(@NotNull PackedGraph expected, @NotNull PackedGraph actual, @NotNull String loader) {
+        int n = expected.getNumberOfVertices();
+        if(actual.getNumberOfVertices() != n || actual.isSymmetric() != expected.isSymmetric()) {
+            throw new IllegalStateException(loader + " read another graph");
+        }
+        for(int i = 0; i < n; i++) {
+            for(int j = 0; j < n; j++) {
+                if(i != j && Double.compare(expected.getCost(i, j), actual.getCost(i, j)) != 0) {
+                    throw new IllegalStateException(loader + " read another cost of (" + i + ", " + j + ")");
+                }
+            }
+        }
+    }
+
+    // the median time in milliseconds.
+    private static double measure(@NotNull Loader loader, @NotNull File file, int size, int repetitions) throws Exception {
+        loader.load(file, size);
+        double[] times = new double[repetitions];
+        for(int r = 0; r < repetitions; r++) {
+            long start = System.nanoTime();
+            loader.load(file, size);
+            times[r] = (System.nanoTime() - start) / 1e6;
+        }
+        Arrays.sort(times);
+        return times[repetitions / 2];
+    }
+
+    public static void main(String[] args) throws Exception {
+        File file;
+        int size, repetitions = DEFAULT_REPETITIONS;
+        boolean temporary = args.length < 2 || !new File(args[0]).isFile();
+        if(!temporary) {
+            file = new File(args[0]);
+            size = Integer.parseInt(args[1]);
+            if(args.length > 2) repetitions = Integer.parseInt(args[2]);
+        } else {
+            size = args.length > 0 ? Integer.parseInt(args[0]) : DEFAULT_VERTICES;
+            if(args.length > 1) repetitions = Integer.parseInt(args[1]);
+            file = File.createTempFile("loader-benchmark-", ".xml");
+            writeRandomGraph(file, size);
+        }
+        if(size < 2 || repetitions < 1) {
+            System.err.println("Usage: LoaderBenchmark [FILE SIZE | VERTICES] [REPETITIONS]");
+            System.exit(1);
+        }
+
+        try {
+            PackedGraph reference = scan(file, size);
+            assertEqualGraphs(reference, sax(file, size), "sax");
+            assertEqualGraphs(reference, dom(file, size), "dom");
+
+            System.out.printf(Locale.ROOT, "%s: %d vertices, %.1f MB, median of %d runs%n", file.getName(), size,
+                    file.length() / 1e6, repetitions);
+            double scan = measure(LoaderBenchmark::scan, file, size, repetitions);
+            double sax = measure(LoaderBenchmark::sax, file, size, repetitions);
+            double dom = measure(LoaderBenchmark::dom, file, size, repetitions);
+            System.out.printf(Locale.ROOT, "  scan %10.1f ms%n", scan);
+            System.out.printf(Locale.ROOT, "  sax  %10.1f ms  (%.2fx the time of scan)%n", sax, sax / scan);
+            System.out.printf(Locale.ROOT, "  dom  %10.1f ms  (%.2fx the time of scan)%n", dom, dom / scan);
+        } finally {
+            if(temporary) file.delete();
+        }
+    }
+}